@@ -165,6 +165,7 @@ let package = Package(
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc",
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h",
         "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric_internal.h",
+        "src/core/ext/filters/client_channel/lb_policy/outlier_detection/call_counter.h",
         "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc",
         "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.h",
         "src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc",
@@ -172,6 +173,8 @@ let package = Package(
         "src/core/ext/filters/client_channel/lb_policy/priority/priority.cc",
         "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc",
         "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h",
+        "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.cc",
+        "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.h",
         "src/core/ext/filters/client_channel/lb_policy/rls/rls.cc",
         "src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc",
         "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h",
@@ -212,6 +215,7 @@ let package = Package(
         "src/core/ext/filters/client_channel/resolver/google_c2p/google_c2p_resolver.cc",
         "src/core/ext/filters/client_channel/resolver/polling_resolver.cc",
         "src/core/ext/filters/client_channel/resolver/polling_resolver.h",
+        "src/core/ext/filters/client_channel/resolver/shm/shm_resolver.cc",
         "src/core/ext/filters/client_channel/resolver/sockaddr/sockaddr_resolver.cc",
         "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.cc",
         "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.h",
@@ -320,7 +324,11 @@ let package = Package(
         "src/core/ext/transport/chttp2/transport/writing.cc",
         "src/core/ext/transport/inproc/inproc_plugin.cc",
         "src/core/ext/transport/inproc/inproc_transport.cc",
+        "src/core/ext/transport/shm/shm_endpoint.cc",
+        "src/core/ext/transport/shm/shm_handshaker.cc",
         "src/core/ext/transport/inproc/inproc_transport.h",
+        "src/core/ext/transport/shm/shm_endpoint.h",
+        "src/core/ext/transport/shm/shm_handshaker.h",
         "src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c",
         "src/core/ext/upb-generated/envoy/admin/v3/certs.upb.h",
         "src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c",
@@ -1089,6 +1097,8 @@ let package = Package(
         "src/core/lib/event_engine/posix.h",
         "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.cc",
         "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h",
+        "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.cc",
+        "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.h",
         "src/core/lib/event_engine/posix_engine/ev_poll_posix.cc",
         "src/core/lib/event_engine/posix_engine/ev_poll_posix.h",
         "src/core/lib/event_engine/posix_engine/event_poller.h",
@@ -1116,6 +1126,8 @@ let package = Package(
         "src/core/lib/event_engine/posix_engine/timer_heap.h",
         "src/core/lib/event_engine/posix_engine/timer_manager.cc",
         "src/core/lib/event_engine/posix_engine/timer_manager.h",
+        "src/core/lib/event_engine/posix_engine/timer_wheel.cc",
+        "src/core/lib/event_engine/posix_engine/timer_wheel.h",
         "src/core/lib/event_engine/posix_engine/traced_buffer_list.cc",
         "src/core/lib/event_engine/posix_engine/traced_buffer_list.h",
         "src/core/lib/event_engine/posix_engine/wakeup_fd_eventfd.cc",
@@ -1163,6 +1175,8 @@ let package = Package(
         "src/core/lib/event_engine/windows/windows_listener.h",
         "src/core/lib/event_engine/work_queue/basic_work_queue.cc",
         "src/core/lib/event_engine/work_queue/basic_work_queue.h",
+        "src/core/lib/event_engine/work_queue/lock_free_work_queue.cc",
+        "src/core/lib/event_engine/work_queue/lock_free_work_queue.h",
         "src/core/lib/event_engine/work_queue/work_queue.h",
         "src/core/lib/experiments/config.cc",
         "src/core/lib/experiments/config.h",
@@ -25,7 +25,9 @@ EXPERIMENTS = {
                 "transport_supplies_client_latency",
             ],
             "core_end2end_test": [
+                "call_arena_pool",
                 "event_engine_listener",
+                "event_engine_timer_wheel",
                 "promise_based_client_call",
                 "promise_based_server_call",
                 "work_stealing",
@@ -71,7 +73,9 @@ EXPERIMENTS = {
                 "transport_supplies_client_latency",
             ],
             "core_end2end_test": [
+                "call_arena_pool",
                 "event_engine_listener",
+                "event_engine_timer_wheel",
                 "promise_based_client_call",
                 "promise_based_server_call",
                 "work_stealing",
@@ -120,8 +124,10 @@ EXPERIMENTS = {
                 "transport_supplies_client_latency",
             ],
             "core_end2end_test": [
+                "call_arena_pool",
                 "event_engine_client",
                 "event_engine_listener",
+                "event_engine_timer_wheel",
                 "promise_based_client_call",
                 "promise_based_server_call",
                 "work_stealing",
@@ -299,6 +299,7 @@
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
@@ -325,6 +326,7 @@
         'src/core/ext/filters/client_channel/resolver/fake/fake_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/google_c2p/google_c2p_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/polling_resolver.cc',
+        'src/core/ext/filters/client_channel/resolver/shm/shm_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/sockaddr/sockaddr_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/xds/xds_resolver.cc',
         'src/core/ext/filters/client_channel/retry_filter.cc',
@@ -380,6 +382,8 @@
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_handshaker.cc',
         'src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c',
         'src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c',
         'src/core/ext/upb-generated/envoy/admin/v3/config_dump.upb.c',
@@ -756,6 +760,7 @@
         'src/core/lib/event_engine/forkable.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
         'src/core/lib/event_engine/posix_engine/ev_epoll1_linux.cc',
+        'src/core/lib/event_engine/posix_engine/ev_io_uring_linux.cc',
         'src/core/lib/event_engine/posix_engine/ev_poll_posix.cc',
         'src/core/lib/event_engine/posix_engine/event_poller_posix_default.cc',
         'src/core/lib/event_engine/posix_engine/internal_errqueue.cc',
@@ -768,6 +773,7 @@
         'src/core/lib/event_engine/posix_engine/timer.cc',
         'src/core/lib/event_engine/posix_engine/timer_heap.cc',
         'src/core/lib/event_engine/posix_engine/timer_manager.cc',
+        'src/core/lib/event_engine/posix_engine/timer_wheel.cc',
         'src/core/lib/event_engine/posix_engine/traced_buffer_list.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_eventfd.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_pipe.cc',
@@ -791,6 +797,7 @@
         'src/core/lib/event_engine/windows/windows_engine.cc',
         'src/core/lib/event_engine/windows/windows_listener.cc',
         'src/core/lib/event_engine/work_queue/basic_work_queue.cc',
+        'src/core/lib/event_engine/work_queue/lock_free_work_queue.cc',
         'src/core/lib/experiments/config.cc',
         'src/core/lib/experiments/experiments.cc',
         'src/core/lib/gprpp/load_file.cc',
@@ -1160,6 +1167,7 @@
         'src/core/ext/filters/client_channel/resolver/dns/native/dns_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/fake/fake_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/polling_resolver.cc',
+        'src/core/ext/filters/client_channel/resolver/shm/shm_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/sockaddr/sockaddr_resolver.cc',
         'src/core/ext/filters/client_channel/retry_filter.cc',
         'src/core/ext/filters/client_channel/retry_filter_legacy_call_data.cc',
@@ -1207,6 +1215,8 @@
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_handshaker.cc',
         'src/core/ext/upb-generated/google/api/annotations.upb.c',
         'src/core/ext/upb-generated/google/api/http.upb.c',
         'src/core/ext/upb-generated/google/protobuf/any.upb.c',
@@ -1263,6 +1273,7 @@
         'src/core/lib/event_engine/forkable.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
         'src/core/lib/event_engine/posix_engine/ev_epoll1_linux.cc',
+        'src/core/lib/event_engine/posix_engine/ev_io_uring_linux.cc',
         'src/core/lib/event_engine/posix_engine/ev_poll_posix.cc',
         'src/core/lib/event_engine/posix_engine/event_poller_posix_default.cc',
         'src/core/lib/event_engine/posix_engine/internal_errqueue.cc',
@@ -1275,6 +1286,7 @@
         'src/core/lib/event_engine/posix_engine/timer.cc',
         'src/core/lib/event_engine/posix_engine/timer_heap.cc',
         'src/core/lib/event_engine/posix_engine/timer_manager.cc',
+        'src/core/lib/event_engine/posix_engine/timer_wheel.cc',
         'src/core/lib/event_engine/posix_engine/traced_buffer_list.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_eventfd.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_pipe.cc',
@@ -1298,6 +1310,7 @@
         'src/core/lib/event_engine/windows/windows_engine.cc',
         'src/core/lib/event_engine/windows/windows_listener.cc',
         'src/core/lib/event_engine/work_queue/basic_work_queue.cc',
+        'src/core/lib/event_engine/work_queue/lock_free_work_queue.cc',
         'src/core/lib/experiments/config.cc',
         'src/core/lib/experiments/experiments.cc',
         'src/core/lib/gprpp/load_file.cc',
@@ -1990,6 +2003,7 @@
         'src/core/lib/event_engine/forkable.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
         'src/core/lib/event_engine/posix_engine/ev_epoll1_linux.cc',
+        'src/core/lib/event_engine/posix_engine/ev_io_uring_linux.cc',
         'src/core/lib/event_engine/posix_engine/ev_poll_posix.cc',
         'src/core/lib/event_engine/posix_engine/event_poller_posix_default.cc',
         'src/core/lib/event_engine/posix_engine/internal_errqueue.cc',
@@ -2002,6 +2016,7 @@
         'src/core/lib/event_engine/posix_engine/timer.cc',
         'src/core/lib/event_engine/posix_engine/timer_heap.cc',
         'src/core/lib/event_engine/posix_engine/timer_manager.cc',
+        'src/core/lib/event_engine/posix_engine/timer_wheel.cc',
         'src/core/lib/event_engine/posix_engine/traced_buffer_list.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_eventfd.cc',
         'src/core/lib/event_engine/posix_engine/wakeup_fd_pipe.cc',
@@ -2025,6 +2040,7 @@
         'src/core/lib/event_engine/windows/windows_engine.cc',
         'src/core/lib/event_engine/windows/windows_listener.cc',
         'src/core/lib/event_engine/work_queue/basic_work_queue.cc',
+        'src/core/lib/event_engine/work_queue/lock_free_work_queue.cc',
         'src/core/lib/experiments/config.cc',
         'src/core/lib/experiments/experiments.cc',
         'src/core/lib/gprpp/load_file.cc',
@@ -124,6 +124,22 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** EXPERIMENTAL. Like grpc_completion_queue_next, but returns up to
+    max_events events per call: blocks until an event is available, the
+    completion queue is being shut down, or deadline is reached, and then also
+    takes any other completions that are already queued, without waiting for
+    more.
+
+    Fills in events[0..n) and returns n, which is at least 1. Events of type
+    GRPC_QUEUE_TIMEOUT or GRPC_QUEUE_SHUTDOWN are only returned on their own,
+    with n == 1. max_events must be at least 1, and cq must have been created
+    with completion type GRPC_CQ_NEXT. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                                grpc_event* events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -26,6 +26,14 @@
 /** If non-zero, call metric recording is enabled. */
 #define GRPC_ARG_SERVER_CALL_METRIC_RECORDING \
   "grpc.server_call_metric_recording"
+/** If non-zero, the server treats its i-th completion queue as serving the
+    CPUs c with c % num_cqs == i: connections are bound to the completion queue
+    of the CPU that accepted them, and incoming calls are first matched against
+    requests on the completion queue of the CPU reading them from the
+    transport, falling back to the other completion queues when it has no
+    pending requests. Applications should poll each completion queue from
+    threads running on the CPUs it serves. Defaults to 0. */
+#define GRPC_ARG_SERVER_CPU_AFFINE_CQS "grpc.server.cpu_affine_cqs"
 /** Request that optional features default to off (regardless of what they
     usually default to) - to enable tight control over what gets enabled */
 #define GRPC_ARG_MINIMAL_STACK "grpc.minimal_stack"
@@ -63,6 +71,24 @@
    application will see the compressed message in the byte buffer. */
 #define GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION \
   "grpc.per_message_decompression"
+/** Experimental Arg. zlib compression level (0-9, or -1 for zlib's default)
+   used by the deflate and gzip message compression algorithms. Lower levels
+   trade compression ratio for CPU. Defaults to -1. */
+#define GRPC_ARG_COMPRESSION_ZLIB_LEVEL "grpc.compression_zlib_level"
+/** Experimental Arg. If set, deflate and gzip compress outgoing messages of at
+   least twice this many bytes as independent chunks of this size on several
+   threads, still producing a single standard stream. Int valued, bytes.
+   Defaults to 0 (disabled). */
+#define GRPC_ARG_COMPRESSION_PARALLEL_CHUNK_SIZE \
+  "grpc.compression_parallel_chunk_size"
+/** Experimental Arg. A preset dictionary (up to 32KiB of bytes, eg. trained
+   offline from sampled messages) for deflate message compression. It's
+   advertised to peers in grpc-accept-encoding, and used for messages sent to
+   peers that advertise the same dictionary, which makes compressing small
+   messages worthwhile. String valued: the dictionary bytes, base64 encoded
+   (RFC 4648), since string args end at the first NUL. */
+#define GRPC_ARG_COMPRESSION_DEFLATE_DICTIONARY \
+  "grpc.compression_deflate_dictionary"
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
@@ -80,6 +106,12 @@
 /** How much memory to use for hpack encoding. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER \
   "grpc.http2.hpack_table_size.encoder"
+/** Comma separated list of application header names (not binary, not
+    pseudo-headers) whose values the hpack encoder should add to its dynamic
+    table, so that a value repeated on a connection is sent as a table
+    reference rather than as a literal. Useful for headers with a small set of
+    values (tenants, routing keys). String valued. */
+#define GRPC_ARG_HTTP2_HPACK_INDEXED_HEADERS "grpc.http2.hpack_indexed_headers"
 /** How big a frame are we willing to receive via HTTP2.
     Min 16384, max 16777215. Larger values give lower CPU usage for large
     messages, but more head of line blocking for small messages. */
@@ -195,6 +227,17 @@
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
+/** Number of SO_REUSEPORT listening sockets the EventEngine listener opens
+ * for each bound address, so that the kernel spreads incoming connections
+ * over several accept queues. Zero means one per CPU core. Ignored unless
+ * SO_REUSEPORT is allowed. Defaults to 1. */
+#define GRPC_ARG_REUSEPORT_LISTENERS "grpc.experimental.reuseport_listeners"
+/** If non-zero, connections to the sockets opened for
+ * GRPC_ARG_REUSEPORT_LISTENERS are steered to the socket matching the CPU
+ * that received them, using a BPF program (Linux 4.5 and later only).
+ * Defaults to 0. */
+#define GRPC_ARG_REUSEPORT_CPU_STEERING \
+  "grpc.experimental.reuseport_cpu_steering"
 /** Service config data in JSON form.
     This value will be ignored if the name resolver returns a service config. */
 #define GRPC_ARG_SERVICE_CONFIG "grpc.service_config"
@@ -250,6 +293,17 @@
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map received pages into memory with
+   TCP_ZEROCOPY_RECEIVE instead of copying them, where the kernel supports it.
+   By default, it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only map received data if at least this
+   many bytes are expected; smaller reads are copied. By default, this is set
+   to 64KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_recv_bytes_threshold"
 /* Overrides the TCP socket recieve buffer size, SO_RCVBUF. */
 #define GRPC_ARG_TCP_RECEIVE_BUFFER_SIZE "grpc.tcp_receive_buffer_size"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
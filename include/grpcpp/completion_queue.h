@@ -200,6 +200,38 @@ class CompletionQueue : private grpc::internal::GrpcLibrary {
     return AsyncNextInternal(tag, ok, deadline_tp.raw_time());
   }
 
+  /// EXPERIMENTAL
+  /// An event read by \a AsyncNextBatch.
+  struct Event {
+    void* tag;  ///< The event's tag.
+    bool ok;    ///< true if a successful event, false otherwise.
+  };
+
+  /// EXPERIMENTAL
+  /// Read up to \a max_events events from the queue at once, blocking up to
+  /// \a deadline (or the queue's shutdown) for the first one. Once an event is
+  /// available, other events that are already queued are returned with it
+  /// without waiting for more, which saves a round trip through the
+  /// completion queue per event when many complete at once. Any number of
+  /// ready events up to \a max_events is returned in one call.
+  ///
+  /// \param[out] events Upon success, filled in with the events read.
+  /// \param[in] max_events The maximum number of events to read; must be at
+  ///        least 1.
+  /// \param[out] num_events Upon success, the number of events read, which
+  ///        is at least 1.
+  /// \param[in] deadline How long to block in wait for an event.
+  ///
+  /// \return GOT_EVENT if at least one event was read, otherwise the reason
+  ///         none was.
+  template <typename T>
+  NextStatus AsyncNextBatch(Event* events, size_t max_events,
+                            size_t* num_events, const T& deadline) {
+    grpc::TimePoint<T> deadline_tp(deadline);
+    return AsyncNextBatchInternal(events, max_events, num_events,
+                                  deadline_tp.raw_time());
+  }
+
   /// EXPERIMENTAL
   /// First executes \a F, then reads from the queue, blocking up to
   /// \a deadline (or the queue's shutdown).
@@ -313,6 +345,8 @@ class CompletionQueue : private grpc::internal::GrpcLibrary {
   };
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
+  NextStatus AsyncNextBatchInternal(Event* events, size_t max_events,
+                                    size_t* num_events, gpr_timespec deadline);
 
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
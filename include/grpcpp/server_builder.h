@@ -292,6 +292,15 @@ class ServerBuilder {
     void EnableCallMetricRecording(
         experimental::ServerMetricRecorder* server_metric_recorder = nullptr);
 
+    /// Treats the completion queues added with AddCompletionQueue() as one per
+    /// CPU group: the i-th queue serves the CPUs c with c % num_queues == i.
+    /// New connections are bound to the queue of the CPU that accepted them,
+    /// and incoming calls are matched first against the requests pending on
+    /// the queue of the CPU that read them, falling back to the other queues.
+    /// For best locality, poll each queue from threads pinned to the CPUs it
+    /// serves.
+    void EnableCpuAffineCompletionQueues();
+
    private:
     ServerBuilder* builder_;
   };
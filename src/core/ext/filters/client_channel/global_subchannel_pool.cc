@@ -22,7 +22,11 @@
 
 #include <utility>
 
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
 #include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/iomgr/resolved_address.h"
 
 namespace grpc_core {
 
@@ -33,33 +37,62 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::RegisterSubchannel(
     const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it != subchannel_map_.end()) {
-    RefCountedPtr<Subchannel> existing = it->second->RefIfNonZero();
-    if (existing != nullptr) return existing;
+  const size_t shard_index = ShardIndex(key);
+  LockedMap& write_shard = write_shards_[shard_index];
+  // Declared before the lock so that it is released after it.
+  SubchannelMap old_map;
+  MutexLock lock(&write_shard.mu);
+  const WeakRefCountedPtr<Subchannel>* existing = write_shard.map.Lookup(key);
+  if (existing != nullptr) {
+    RefCountedPtr<Subchannel> existing_ref = (*existing)->RefIfNonZero();
+    if (existing_ref != nullptr) return existing_ref;
   }
-  subchannel_map_[key] = constructed.get();
+  write_shard.map = write_shard.map.Add(key, constructed->WeakRef());
+  old_map = PublishShard(shard_index, write_shard.map);
   return constructed;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
                                                 Subchannel* subchannel) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
+  const size_t shard_index = ShardIndex(key);
+  LockedMap& write_shard = write_shards_[shard_index];
+  // Declared before the lock so that it is released after it.
+  SubchannelMap old_map;
+  MutexLock lock(&write_shard.mu);
+  const WeakRefCountedPtr<Subchannel>* existing = write_shard.map.Lookup(key);
   // delete only if key hasn't been re-registered to a different subchannel
   // between strong-unreffing and unregistration of subchannel.
-  if (it != subchannel_map_.end() && it->second == subchannel) {
-    subchannel_map_.erase(it);
+  if (existing != nullptr && existing->get() == subchannel) {
+    write_shard.map = write_shard.map.Remove(key);
+    old_map = PublishShard(shard_index, write_shard.map);
   }
 }
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::FindSubchannel(
     const SubchannelKey& key) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it == subchannel_map_.end()) return nullptr;
-  return it->second->RefIfNonZero();
+  LockedMap& read_shard = read_shards_[ShardIndex(key)];
+  SubchannelMap map;
+  {
+    MutexLock lock(&read_shard.mu);
+    map = read_shard.map;
+  }
+  const WeakRefCountedPtr<Subchannel>* subchannel = map.Lookup(key);
+  if (subchannel == nullptr) return nullptr;
+  return (*subchannel)->RefIfNonZero();
+}
+
+size_t GlobalSubchannelPool::ShardIndex(const SubchannelKey& key) {
+  const grpc_resolved_address& address = key.address();
+  return absl::HashOf(absl::string_view(address.addr, address.len)) %
+         kShards;
+}
+
+GlobalSubchannelPool::SubchannelMap GlobalSubchannelPool::PublishShard(
+    size_t shard_index, SubchannelMap map) {
+  LockedMap& read_shard = read_shards_[shard_index];
+  MutexLock lock(&read_shard.mu);
+  std::swap(read_shard.map, map);
+  return map;
 }
 
 }  // namespace grpc_core
@@ -21,11 +21,16 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
 
 #include "absl/base/thread_annotations.h"
 
+#include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/avl/avl.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -40,22 +45,57 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
 
   // Implements interface methods.
   RefCountedPtr<Subchannel> RegisterSubchannel(
-      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override;
   void UnregisterSubchannel(const SubchannelKey& key,
-                            Subchannel* subchannel) override
-      ABSL_LOCKS_EXCLUDED(mu_);
-  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+                            Subchannel* subchannel) override;
+  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override;
 
  private:
+  // Subchannels are spread across shards by address, so that channels
+  // working on different addresses don't contend with each other.
+  static constexpr size_t kShards = 127;
+
+  // Maps are immutable values, so that lookups can take a copy of the
+  // current one and search it without holding any lock.  Weak refs keep the
+  // subchannels in a copy alive for as long as the copy is.
+  using SubchannelMap = AVL<SubchannelKey, WeakRefCountedPtr<Subchannel>>;
+
+  // Shards locked by different threads must not share a cacheline.  The
+  // pool is heap allocated, and only C++17 aligns heap allocations to more
+  // than max_align_t, so earlier versions pad instead.
+#if __cplusplus >= 201703L
+  struct alignas(GPR_CACHELINE_SIZE) LockedMap {
+    Mutex mu;
+    SubchannelMap map ABSL_GUARDED_BY(mu);
+  };
+#else
+  struct LockedMapHeader {
+    Mutex mu;
+    SubchannelMap map ABSL_GUARDED_BY(mu);
+  };
+  struct LockedMap : public LockedMapHeader {
+    uint8_t padding[GPR_CACHELINE_SIZE - sizeof(LockedMapHeader)];
+  };
+#endif
+  using ShardArray = std::array<LockedMap, kShards>;
+
   GlobalSubchannelPool() {}
   ~GlobalSubchannelPool() override {}
 
-  // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
-  // To protect subchannel_map_.
-  Mutex mu_;
+  static size_t ShardIndex(const SubchannelKey& key);
+
+  // Replaces the map published to lookups in the shard, once the write
+  // shard's map has been updated.  Called with the write shard's lock held,
+  // so that maps are published in the order they were written.  Returns the
+  // map replaced, for the caller to release once it has dropped that lock:
+  // the last weak ref to a subchannel may be in it.
+  SubchannelMap PublishShard(size_t shard_index, SubchannelMap map);
+
+  // Registration and unregistration are serialized per shard by the write
+  // shards.  Lookups only take the lock of the corresponding read shard,
+  // and only for as long as it takes to copy its map.
+  ShardArray write_shards_;
+  ShardArray read_shards_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,109 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_CALL_COUNTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_CALL_COUNTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/core/lib/gprpp/per_cpu.h"
+
+namespace grpc_core {
+
+// Counts the successful and failed calls to one address for outlier
+// detection.  Calls are recorded into the current interval; Rotate() closes
+// it, making its counts available from GetLastIntervalCounts() while a new
+// interval is recorded.
+//
+// Every call finishing on the address records into this counter, so the
+// counts are sharded per cpu and only summed when the ejection timer runs.
+class OutlierDetectionCallCounter {
+ public:
+  struct Counts {
+    uint64_t successes;
+    uint64_t failures;
+  };
+
+  void AddSuccess() {
+    shards_.this_cpu()
+        .buckets[active_.load(std::memory_order_relaxed)]
+        .successes.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void AddFailure() {
+    shards_.this_cpu()
+        .buckets[active_.load(std::memory_order_relaxed)]
+        .failures.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Starts a new interval.  Calls racing with the rotation may be counted
+  // in either interval.
+  void Rotate() {
+    const size_t next = 1 - active_.load(std::memory_order_relaxed);
+    for (Shard& shard : shards_) {
+      shard.buckets[next].successes.store(0, std::memory_order_relaxed);
+      shard.buckets[next].failures.store(0, std::memory_order_relaxed);
+    }
+    active_.store(next, std::memory_order_relaxed);
+  }
+
+  // Returns the counts recorded in the interval closed by the last call to
+  // Rotate().
+  Counts GetLastIntervalCounts() const {
+    const size_t last = 1 - active_.load(std::memory_order_relaxed);
+    Counts counts = {0, 0};
+    for (const Shard& shard : shards_) {
+      counts.successes +=
+          shard.buckets[last].successes.load(std::memory_order_relaxed);
+      counts.failures +=
+          shard.buckets[last].failures.load(std::memory_order_relaxed);
+    }
+    return counts;
+  }
+
+ private:
+  struct Bucket {
+    std::atomic<uint64_t> successes{0};
+    std::atomic<uint64_t> failures{0};
+  };
+
+  // Cpus recording into different shards must not share a cacheline. As for
+  // channelz's PerCpuData, only C++17 guarantees the alignment of the
+  // shards PerCpu allocates, so earlier versions pad instead.
+#if __cplusplus >= 201703L
+  struct alignas(GPR_CACHELINE_SIZE) Shard {
+    Bucket buckets[2];
+  };
+#else
+  struct Shard {
+    Bucket buckets[2];
+    uint8_t padding[GPR_CACHELINE_SIZE - 2 * sizeof(Bucket)];
+  };
+#endif
+
+  // Index into Shard::buckets of the current interval.
+  std::atomic<size_t> active_{0};
+  PerCpu<Shard> shards_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_CALL_COUNTER_H
@@ -22,7 +22,6 @@
 #include <stddef.h>
 
 #include <algorithm>
-#include <atomic>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -44,6 +43,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
 #include "src/core/ext/filters/client_channel/lb_policy/health_check_client_internal.h"
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/call_counter.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -252,29 +252,17 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
 
   class SubchannelState : public RefCounted<SubchannelState> {
    public:
-    struct Bucket {
-      std::atomic<uint64_t> successes;
-      std::atomic<uint64_t> failures;
-    };
-
-    void RotateBucket() {
-      backup_bucket_->successes = 0;
-      backup_bucket_->failures = 0;
-      current_bucket_.swap(backup_bucket_);
-      active_bucket_.store(current_bucket_.get());
-    }
+    void RotateBucket() { call_counter_.Rotate(); }
 
     absl::optional<std::pair<double, uint64_t>> GetSuccessRateAndVolume() {
-      uint64_t total_request =
-          backup_bucket_->successes + backup_bucket_->failures;
+      const OutlierDetectionCallCounter::Counts counts =
+          call_counter_.GetLastIntervalCounts();
+      uint64_t total_request = counts.successes + counts.failures;
       if (total_request == 0) {
         return absl::nullopt;
       }
-      double success_rate =
-          backup_bucket_->successes * 100.0 /
-          (backup_bucket_->successes + backup_bucket_->failures);
-      return {
-          {success_rate, backup_bucket_->successes + backup_bucket_->failures}};
+      double success_rate = counts.successes * 100.0 / total_request;
+      return {{success_rate, total_request}};
     }
 
     void AddSubchannel(SubchannelWrapper* wrapper) {
@@ -285,9 +273,9 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
       subchannels_.erase(wrapper);
     }
 
-    void AddSuccessCount() { active_bucket_.load()->successes.fetch_add(1); }
+    void AddSuccessCount() { call_counter_.AddSuccess(); }
 
-    void AddFailureCount() { active_bucket_.load()->failures.fetch_add(1); }
+    void AddFailureCount() { call_counter_.AddFailure(); }
 
     absl::optional<Timestamp> ejection_time() const { return ejection_time_; }
 
@@ -338,11 +326,7 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     }
 
    private:
-    std::unique_ptr<Bucket> current_bucket_ = std::make_unique<Bucket>();
-    std::unique_ptr<Bucket> backup_bucket_ = std::make_unique<Bucket>();
-    // The bucket used to update call counts.
-    // Points to either current_bucket or active_bucket.
-    std::atomic<Bucket*> active_bucket_{current_bucket_.get()};
+    OutlierDetectionCallCounter call_counter_;
     uint32_t multiplier_ = 0;
     absl::optional<Timestamp> ejection_time_;
     std::set<SubchannelWrapper*> subchannels_;
@@ -22,14 +22,12 @@
 #include <stdlib.h>
 
 #include <algorithm>
-#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/base/attributes.h"
-#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/numbers.h"
@@ -39,13 +37,11 @@
 
 #include <grpc/impl/channel_arg_names.h>
 
-#define XXH_INLINE_ALL
-#include "xxhash.h"
-
 #include <grpc/impl/connectivity_state.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/client_channel_internal.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.h"
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -190,31 +186,18 @@ class RingHash : public LoadBalancingPolicy {
   class RingHashSubchannelList
       : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
    public:
-    class Ring : public RefCounted<Ring> {
-     public:
-      struct RingEntry {
-        uint64_t hash;
-        size_t subchannel_index;
-      };
-
-      Ring(RingHashLbConfig* config, RingHashSubchannelList* subchannel_list,
-           const ChannelArgs& args);
-
-      const std::vector<RingEntry>& ring() const { return ring_; }
-
-     private:
-      std::vector<RingEntry> ring_;
-    };
-
+    // previous_ring, if non-null, is the ring of the list being replaced;
+    // hashes for addresses that are in both lists are copied from it.
     RingHashSubchannelList(RingHash* policy, ServerAddressList addresses,
-                           const ChannelArgs& args);
+                           const ChannelArgs& args,
+                           const RingHashRing* previous_ring);
 
     ~RingHashSubchannelList() override {
       RingHash* p = static_cast<RingHash*>(policy());
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
-    RefCountedPtr<Ring> ring() { return ring_; }
+    RefCountedPtr<RingHashRing> ring() { return ring_; }
 
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
@@ -242,7 +225,7 @@ class RingHash : public LoadBalancingPolicy {
     size_t num_connecting_ = 0;
     size_t num_transient_failure_ = 0;
 
-    RefCountedPtr<Ring> ring_;
+    RefCountedPtr<RingHashRing> ring_;
 
     // The index of the subchannel currently doing an internally
     // triggered connection attempt, if any.
@@ -322,7 +305,7 @@ class RingHash : public LoadBalancingPolicy {
     };
 
     RefCountedPtr<RingHash> ring_hash_lb_;
-    RefCountedPtr<RingHashSubchannelList::Ring> ring_;
+    RefCountedPtr<RingHashRing> ring_;
     std::vector<SubchannelInfo> subchannels_;
   };
 
@@ -358,33 +341,7 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         absl::InternalError("ring hash value is not a number"));
   }
   const auto& ring = ring_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  int64_t lowp = 0;
-  int64_t highp = ring.size();
-  int64_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring.size())) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
-    }
-  }
+  const size_t first_index = ring_->FindIndex(h);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -396,7 +353,7 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
   SubchannelInfo& first_subchannel =
-      subchannels_[ring[first_index].subchannel_index];
+      subchannels_[ring[first_index].endpoint_index];
   switch (first_subchannel.state) {
     case GRPC_CHANNEL_READY:
       return PickResult::Complete(first_subchannel.subchannel);
@@ -416,10 +373,10 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
   bool found_first_non_failed = false;
   for (size_t i = 1; i < ring.size(); ++i) {
     const auto& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel_index == ring[first_index].subchannel_index) {
+    if (entry.endpoint_index == ring[first_index].endpoint_index) {
       continue;
     }
-    SubchannelInfo& subchannel_info = subchannels_[entry.subchannel_index];
+    SubchannelInfo& subchannel_info = subchannels_[entry.endpoint_index];
     if (subchannel_info.state == GRPC_CHANNEL_READY) {
       return PickResult::Complete(subchannel_info.subchannel);
     }
@@ -451,110 +408,13 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
       first_subchannel.status.ToString())));
 }
 
-//
-// RingHash::RingHashSubchannelList::Ring
-//
-
-RingHash::RingHashSubchannelList::Ring::Ring(
-    RingHashLbConfig* config, RingHashSubchannelList* subchannel_list,
-    const ChannelArgs& args) {
-  // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
-  std::vector<AddressWeight> address_weights;
-  size_t sum = 0;
-  address_weights.reserve(subchannel_list->num_subchannels());
-  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-    RingHashSubchannelData* sd = subchannel_list->subchannel(i);
-    auto weight_arg = sd->address().args().GetInt(GRPC_ARG_ADDRESS_WEIGHT);
-    AddressWeight address_weight;
-    address_weight.address =
-        grpc_sockaddr_to_string(&sd->address().address(), false).value();
-    // Weight should never be zero, but ignore it just in case, since
-    // that value would screw up the ring-building algorithm.
-    if (weight_arg.value_or(0) > 0) {
-      address_weight.weight = *weight_arg;
-    }
-    sum += address_weight.weight;
-    address_weights.push_back(std::move(address_weight));
-  }
-  // Calculating normalized weights and find min and max.
-  double min_normalized_weight = 1.0;
-  double max_normalized_weight = 0.0;
-  for (auto& address : address_weights) {
-    address.normalized_weight = static_cast<double>(address.weight) / sum;
-    min_normalized_weight =
-        std::min(address.normalized_weight, min_normalized_weight);
-    max_normalized_weight =
-        std::max(address.normalized_weight, max_normalized_weight);
-  }
-  // Scale up the number of hashes per host such that the least-weighted host
-  // gets a whole number of hashes on the ring. Other hosts might not end up
-  // with whole numbers, and that's fine (the ring-building algorithm below can
-  // handle this). This preserves the original implementation's behavior: when
-  // weights aren't provided, all hosts should get an equal number of hashes. In
-  // the case where this number exceeds the max_ring_size, it's scaled back down
-  // to fit.
-  const size_t ring_size_cap = args.GetInt(GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP)
-                                   .value_or(kRingSizeCapDefault);
-  const size_t min_ring_size = std::min(config->min_ring_size(), ring_size_cap);
-  const size_t max_ring_size = std::min(config->max_ring_size(), ring_size_cap);
-  const double scale = std::min(
-      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
-      static_cast<double>(max_ring_size));
-  // Reserve memory for the entire ring up front.
-  const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each
-  // host. Since these aren't necessarily whole numbers, we maintain running
-  // sums -- current_hashes and target_hashes -- which allows us to populate the
-  // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
-  double current_hashes = 0.0;
-  double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
-  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
-    while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, i});
-      ++count;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
-    }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
-  }
-  std::sort(ring_.begin(), ring_.end(),
-            [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-              return lhs.hash < rhs.hash;
-            });
-}
-
 //
 // RingHash::RingHashSubchannelList
 //
 
 RingHash::RingHashSubchannelList::RingHashSubchannelList(
-    RingHash* policy, ServerAddressList addresses, const ChannelArgs& args)
+    RingHash* policy, ServerAddressList addresses, const ChannelArgs& args,
+    const RingHashRing* previous_ring)
     : SubchannelList(policy,
                      (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)
                           ? "RingHashSubchannelList"
@@ -566,8 +426,27 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
   // any references to subchannels, since the subchannels'
   // pollset_sets will include the LB policy's pollset_set.
   policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
-  // Construct the ring.
-  ring_ = MakeRefCounted<Ring>(policy->config_.get(), this, args);
+  // Construct the ring, or share an identical one built by another channel.
+  std::vector<RingHashRing::Endpoint> endpoints;
+  endpoints.reserve(num_subchannels());
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    const ServerAddress& address = subchannel(i)->address();
+    RingHashRing::Endpoint endpoint;
+    endpoint.address =
+        grpc_sockaddr_to_string(&address.address(), false).value();
+    // Weight should never be zero, but ignore it just in case, since
+    // that value would screw up the ring-building algorithm.
+    auto weight_arg = address.args().GetInt(GRPC_ARG_ADDRESS_WEIGHT);
+    if (weight_arg.value_or(0) > 0) endpoint.weight = *weight_arg;
+    endpoints.push_back(std::move(endpoint));
+  }
+  const size_t ring_size_cap = args.GetInt(GRPC_ARG_RING_HASH_LB_RING_SIZE_CAP)
+                                   .value_or(kRingSizeCapDefault);
+  ring_ = RingHashRing::Get(
+      std::move(endpoints),
+      std::min(policy->config_->min_ring_size(), ring_size_cap),
+      std::min(policy->config_->max_ring_size(), ring_size_cap),
+      previous_ring);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO,
             "[RH %p] created subchannel list %p with %" PRIuPTR " ring entries",
@@ -813,8 +692,15 @@ absl::Status RingHash::UpdateLocked(UpdateArgs args) {
     gpr_log(GPR_INFO, "[RH %p] replacing latest pending subchannel list %p",
             this, latest_pending_subchannel_list_.get());
   }
+  // Reuse hashes from the newest ring we have.
+  const RingHashRing* previous_ring = nullptr;
+  if (latest_pending_subchannel_list_ != nullptr) {
+    previous_ring = latest_pending_subchannel_list_->ring().get();
+  } else if (subchannel_list_ != nullptr) {
+    previous_ring = subchannel_list_->ring().get();
+  }
   latest_pending_subchannel_list_ = MakeRefCounted<RingHashSubchannelList>(
-      this, std::move(addresses), args.args);
+      this, std::move(addresses), args.args, previous_ring);
   latest_pending_subchannel_list_->StartWatchingLocked(args.args);
   // If we have no existing list or the new list is empty, immediately
   // promote the new list.
@@ -0,0 +1,297 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The inputs that fully determine a ring.
+struct RingKey {
+  const std::vector<RingHashRing::Endpoint>& endpoints;
+  size_t min_ring_size;
+  size_t max_ring_size;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const RingKey& key) {
+    return H::combine(std::move(h), key.endpoints, key.min_ring_size,
+                      key.max_ring_size);
+  }
+
+  bool operator==(const RingKey& other) const {
+    return min_ring_size == other.min_ring_size &&
+           max_ring_size == other.max_ring_size &&
+           endpoints == other.endpoints;
+  }
+};
+
+RingKey KeyOf(const RingHashRing* ring) {
+  return RingKey{ring->endpoints(), ring->min_ring_size(),
+                 ring->max_ring_size()};
+}
+
+// Process-wide set of live rings.  Rings hold no ref on themselves here;
+// each ring removes itself from the set when it is destroyed.
+class RingCache {
+ public:
+  RefCountedPtr<RingHashRing> Get(const RingKey& key) {
+    MutexLock lock(&mu_);
+    auto it = rings_.find(key);
+    if (it == rings_.end()) return nullptr;
+    // A ring whose refcount already hit zero is about to remove itself.
+    return (*it)->RefIfNonZero();
+  }
+
+  // Adds ring, replacing any dying ring with the same key.  If another
+  // thread already added a live ring with the same key, returns that ring
+  // instead and leaves the set unchanged.
+  RefCountedPtr<RingHashRing> Add(RingHashRing* ring) {
+    MutexLock lock(&mu_);
+    auto it = rings_.find(KeyOf(ring));
+    if (it != rings_.end()) {
+      auto existing = (*it)->RefIfNonZero();
+      if (existing != nullptr) return existing;
+      rings_.erase(it);
+    }
+    rings_.insert(ring);
+    return nullptr;
+  }
+
+  void Remove(RingHashRing* ring) {
+    MutexLock lock(&mu_);
+    auto it = rings_.find(KeyOf(ring));
+    if (it != rings_.end() && *it == ring) rings_.erase(it);
+  }
+
+ private:
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(const RingKey& key) const {
+      return absl::Hash<RingKey>()(key);
+    }
+    size_t operator()(const RingHashRing* ring) const {
+      return (*this)(KeyOf(ring));
+    }
+  };
+  struct Eq {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return AsKey(a) == AsKey(b);
+    }
+    static RingKey AsKey(const RingKey& key) { return key; }
+    static RingKey AsKey(const RingHashRing* ring) { return KeyOf(ring); }
+  };
+
+  Mutex mu_;
+  absl::flat_hash_set<RingHashRing*, Hash, Eq> rings_ ABSL_GUARDED_BY(mu_);
+};
+
+NoDestruct<RingCache> g_ring_cache;
+
+bool HashLess(const RingHashRing::Entry& lhs, const RingHashRing::Entry& rhs) {
+  return lhs.hash < rhs.hash;
+}
+
+}  // namespace
+
+RefCountedPtr<RingHashRing> RingHashRing::Get(std::vector<Endpoint> endpoints,
+                                              size_t min_ring_size,
+                                              size_t max_ring_size,
+                                              const RingHashRing* previous) {
+  auto ring =
+      g_ring_cache->Get(RingKey{endpoints, min_ring_size, max_ring_size});
+  if (ring != nullptr) return ring;
+  ring = Build(std::move(endpoints), min_ring_size, max_ring_size, previous);
+  ring->cached_ = true;
+  auto existing = g_ring_cache->Add(ring.get());
+  if (existing != nullptr) {
+    ring->cached_ = false;
+    return existing;
+  }
+  return ring;
+}
+
+RefCountedPtr<RingHashRing> RingHashRing::Build(
+    std::vector<Endpoint> endpoints, size_t min_ring_size,
+    size_t max_ring_size, const RingHashRing* previous) {
+  return RefCountedPtr<RingHashRing>(new RingHashRing(
+      std::move(endpoints), min_ring_size, max_ring_size, previous));
+}
+
+RingHashRing::RingHashRing(std::vector<Endpoint> endpoints,
+                           size_t min_ring_size, size_t max_ring_size,
+                           const RingHashRing* previous)
+    : endpoints_(std::move(endpoints)),
+      min_ring_size_(min_ring_size),
+      max_ring_size_(max_ring_size) {
+  if (endpoints_.empty()) return;
+  size_t sum = 0;
+  for (const Endpoint& endpoint : endpoints_) sum += endpoint.weight;
+  // Find the min normalized weight.
+  double min_normalized_weight = 1.0;
+  for (const Endpoint& endpoint : endpoints_) {
+    min_normalized_weight = std::min(
+        static_cast<double>(endpoint.weight) / sum, min_normalized_weight);
+  }
+  // Scale up the number of hashes per host such that the least-weighted host
+  // gets a whole number of hashes on the ring. Other hosts might not end up
+  // with whole numbers, and that's fine (the ring-building algorithm below can
+  // handle this). This preserves the original implementation's behavior: when
+  // weights aren't provided, all hosts should get an equal number of hashes. In
+  // the case where this number exceeds the max_ring_size, it's scaled back down
+  // to fit.
+  const double scale = std::min(
+      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
+      static_cast<double>(max_ring_size));
+  // Work out how many hashes each host gets by walking through the hosts and
+  // assigning (scale * weight) hashes to each. Since these aren't necessarily
+  // whole numbers, we maintain running sums -- current_hashes and
+  // target_hashes -- which allows us to populate the ring in a mostly stable
+  // way.
+  hash_counts_.reserve(endpoints_.size());
+  double current_hashes = 0.0;
+  double target_hashes = 0.0;
+  for (const Endpoint& endpoint : endpoints_) {
+    target_hashes += scale * (static_cast<double>(endpoint.weight) / sum);
+    uint32_t count = 0;
+    while (current_hashes < target_hashes) {
+      ++count;
+      ++current_hashes;
+    }
+    hash_counts_.push_back(count);
+  }
+  // Copy the hashes that the previous ring already computed.  Each
+  // endpoint's hashes depend only on its address, so an endpoint that is
+  // still present keeps the first min(old count, new count) of them.  The
+  // previous ring is sorted, so the copied entries stay sorted.  Duplicate
+  // addresses make the mapping ambiguous; rebuild from scratch in that case.
+  std::vector<Entry> reused;
+  std::vector<uint32_t> first_new_replica(endpoints_.size(), 0);
+  if (previous != nullptr && !previous->ring_.empty()) {
+    constexpr uint32_t kNotPresent = std::numeric_limits<uint32_t>::max();
+    absl::flat_hash_map<absl::string_view, uint32_t> new_index;
+    new_index.reserve(endpoints_.size());
+    bool unique = true;
+    for (size_t i = 0; i < endpoints_.size() && unique; ++i) {
+      unique = new_index.emplace(endpoints_[i].address, i).second;
+    }
+    std::vector<uint32_t> old_to_new(previous->endpoints_.size(), kNotPresent);
+    std::vector<bool> mapped(endpoints_.size(), false);
+    for (size_t i = 0; i < previous->endpoints_.size() && unique; ++i) {
+      auto it = new_index.find(previous->endpoints_[i].address);
+      if (it == new_index.end()) continue;
+      unique = !mapped[it->second];
+      mapped[it->second] = true;
+      old_to_new[i] = it->second;
+      first_new_replica[it->second] =
+          std::min(previous->hash_counts_[i], hash_counts_[it->second]);
+    }
+    if (unique) {
+      reused.reserve(previous->ring_.size());
+      for (const Entry& entry : previous->ring_) {
+        const uint32_t index = old_to_new[entry.endpoint_index];
+        if (index != kNotPresent && entry.replica < hash_counts_[index]) {
+          reused.push_back({entry.hash, index, entry.replica});
+        }
+      }
+    } else {
+      std::fill(first_new_replica.begin(), first_new_replica.end(), 0);
+    }
+  }
+  // Compute the remaining hashes.
+  std::vector<Entry> added;
+  std::string hash_key;
+  for (size_t i = 0; i < endpoints_.size(); ++i) {
+    if (first_new_replica[i] == hash_counts_[i]) continue;
+    hash_key.assign(endpoints_[i].address);
+    hash_key.push_back('_');
+    const size_t prefix_length = hash_key.size();
+    for (uint32_t replica = first_new_replica[i]; replica < hash_counts_[i];
+         ++replica) {
+      hash_key.resize(prefix_length);
+      absl::StrAppend(&hash_key, replica);
+      added.push_back({XXH64(hash_key.data(), hash_key.size(), 0),
+                       static_cast<uint32_t>(i), replica});
+    }
+  }
+  std::sort(added.begin(), added.end(), HashLess);
+  if (reused.empty()) {
+    ring_ = std::move(added);
+  } else {
+    ring_.reserve(reused.size() + added.size());
+    std::merge(reused.begin(), reused.end(), added.begin(), added.end(),
+               std::back_inserter(ring_), HashLess);
+  }
+}
+
+RingHashRing::~RingHashRing() {
+  if (cached_) g_ring_cache->Remove(this);
+}
+
+size_t RingHashRing::FindIndex(uint64_t h) const {
+  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
+  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
+  // for lowp, highp, and first_index. Do not change them!
+  int64_t lowp = 0;
+  int64_t highp = ring_.size();
+  int64_t first_index = 0;
+  while (true) {
+    first_index = (lowp + highp) / 2;
+    if (first_index == static_cast<int64_t>(ring_.size())) {
+      first_index = 0;
+      break;
+    }
+    uint64_t midval = ring_[first_index].hash;
+    uint64_t midval1 = first_index == 0 ? 0 : ring_[first_index - 1].hash;
+    if (h <= midval && h > midval1) {
+      break;
+    }
+    if (midval < h) {
+      lowp = first_index + 1;
+    } else {
+      highp = first_index - 1;
+    }
+    if (lowp > highp) {
+      first_index = 0;
+      break;
+    }
+  }
+  return first_index;
+}
+
+}  // namespace grpc_core
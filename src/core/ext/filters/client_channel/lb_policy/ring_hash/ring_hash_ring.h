@@ -0,0 +1,109 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_RING_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_RING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_core {
+
+// An immutable hash ring, as used by the ring_hash LB policy.
+//
+// A ring depends only on the ordered list of endpoints and the ring size
+// bounds, so rings are shared process-wide: every channel that asks for
+// the same ring gets a ref to the same object.
+class RingHashRing : public RefCounted<RingHashRing> {
+ public:
+  struct Endpoint {
+    std::string address;
+    // Endpoints with no explicit weight get a weight of 1.
+    uint32_t weight = 1;
+
+    bool operator==(const Endpoint& other) const {
+      return address == other.address && weight == other.weight;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Endpoint& endpoint) {
+      return H::combine(std::move(h), endpoint.address, endpoint.weight);
+    }
+  };
+
+  struct Entry {
+    uint64_t hash;
+    // Index into endpoints().
+    uint32_t endpoint_index;
+    // Which of the endpoint's hashes this is, i.e. the N in the
+    // "<address>_<N>" hash key.
+    uint32_t replica;
+  };
+
+  // Returns the ring for endpoints, sharing an existing ring if one was
+  // built for the same inputs and is still alive.  If a new ring has to be
+  // built and previous is non-null, the hashes of endpoints that also
+  // appear in previous are copied from it instead of being recomputed.
+  static RefCountedPtr<RingHashRing> Get(std::vector<Endpoint> endpoints,
+                                         size_t min_ring_size,
+                                         size_t max_ring_size,
+                                         const RingHashRing* previous);
+
+  // Builds a new ring without consulting or populating the shared cache.
+  static RefCountedPtr<RingHashRing> Build(std::vector<Endpoint> endpoints,
+                                           size_t min_ring_size,
+                                           size_t max_ring_size,
+                                           const RingHashRing* previous);
+
+  ~RingHashRing() override;
+
+  const std::vector<Endpoint>& endpoints() const { return endpoints_; }
+  size_t min_ring_size() const { return min_ring_size_; }
+  size_t max_ring_size() const { return max_ring_size_; }
+
+  // Entries sorted by hash.
+  const std::vector<Entry>& ring() const { return ring_; }
+
+  // Returns the index into ring() of the entry that owns hash h.
+  // Must not be called on an empty ring.
+  size_t FindIndex(uint64_t h) const;
+
+ private:
+  RingHashRing(std::vector<Endpoint> endpoints, size_t min_ring_size,
+               size_t max_ring_size, const RingHashRing* previous);
+
+  const std::vector<Endpoint> endpoints_;
+  const size_t min_ring_size_;
+  const size_t max_ring_size_;
+  // Number of hashes on the ring for each endpoint.
+  std::vector<uint32_t> hash_counts_;
+  std::vector<Entry> ring_;
+  // True if this ring is registered in the shared cache.
+  bool cached_ = false;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_RING_H
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <initializer_list>
 #include <list>
@@ -41,6 +42,8 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -74,6 +77,7 @@
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/status_helper.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -283,6 +287,11 @@ class RlsLb : public LoadBalancingPolicy {
       return picker_->Pick(args);
     }
 
+    RefCountedPtr<SubchannelPicker> picker() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      return picker_;
+    }
+
     // Updates for the child policy are handled in two phases:
     // 1. In StartUpdate(), we parse and validate the new child policy
     //    config and store the parsed config.
@@ -358,8 +367,55 @@ class RlsLb : public LoadBalancingPolicy {
         ABSL_GUARDED_BY(&RlsLb::mu_);
   };
 
-  // A picker that uses the cache and the request map in the LB policy
-  // (synchronized via a mutex) to determine how to route requests.
+  // Immutable copy of the data in a cache entry that picks need.  Each
+  // entry replaces its snapshot whenever that data changes, and pickers
+  // read snapshots without holding the lock.
+  struct EntrySnapshot : public RefCounted<EntrySnapshot> {
+    RequestKey key;
+    size_t hash;
+    absl::Status status;
+    Timestamp backoff_time;
+    Timestamp data_expiration_time;
+    Timestamp stale_time;
+    std::string header_data;
+    // Only used as keys into the child states captured by a picker; never
+    // dereferenced.
+    std::vector<const ChildPolicyWrapper*> targets;
+    // Set by pickers when they use the entry.  Instead of moving the entry
+    // to the end of the LRU list on every pick, the LRU eviction pass
+    // checks and clears this flag and gives used entries a second chance.
+    std::atomic<bool> used{false};
+  };
+
+  // Hash and equality for looking up snapshots by RequestKey.
+  struct EntrySnapshotHash {
+    using is_transparent = void;
+    size_t operator()(const RefCountedPtr<EntrySnapshot>& snapshot) const {
+      return snapshot->hash;
+    }
+    size_t operator()(const RequestKey& key) const {
+      return absl::Hash<RequestKey>()(key);
+    }
+  };
+  struct EntrySnapshotEq {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return KeyOf(a) == KeyOf(b);
+    }
+    static const RequestKey& KeyOf(const RequestKey& key) { return key; }
+    static const RequestKey& KeyOf(const RefCountedPtr<EntrySnapshot>& e) {
+      return e->key;
+    }
+  };
+  using EntrySnapshotSet =
+      absl::flat_hash_set<RefCountedPtr<EntrySnapshot>, EntrySnapshotHash,
+                          EntrySnapshotEq>;
+
+  // A picker that routes requests using snapshots of the cache entries and
+  // child policy pickers taken when it was created.  Picks that may need to
+  // start an RLS request (cache misses and stale entries) fall back to the
+  // cache and the request map in the LB policy, synchronized via a mutex.
   class Picker : public LoadBalancingPolicy::SubchannelPicker {
    public:
     explicit Picker(RefCountedPtr<RlsLb> lb_policy);
@@ -367,9 +423,23 @@ class RlsLb : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
+    struct ChildState {
+      RefCountedPtr<SubchannelPicker> picker;
+      grpc_connectivity_state connectivity_state;
+      std::string target;
+    };
+
+    // Returns the result of the pick if it can be made from the snapshot
+    // alone, or nullopt if it needs the lock.
+    absl::optional<PickResult> PickFromSnapshot(const RequestKey& key,
+                                                Timestamp now, PickArgs args);
+
     RefCountedPtr<RlsLb> lb_policy_;
     RefCountedPtr<RlsLbConfig> config_;
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+    RefCountedPtr<SubchannelPicker> default_child_picker_;
+    EntrySnapshotSet entries_;
+    absl::flat_hash_map<const ChildPolicyWrapper*, ChildState> children_;
   };
 
   // An LRU cache with adjustable size.
@@ -448,7 +518,20 @@ class RlsLb : public LoadBalancingPolicy {
       // Moves entry to the end of the LRU list.
       void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+      // Returns true if a picker used the entry since the last call.
+      bool TakeUsedByPicker() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return snapshot_->used.exchange(false, std::memory_order_relaxed);
+      }
+
+      const RefCountedPtr<EntrySnapshot>& snapshot() const
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return snapshot_;
+      }
+
      private:
+      // Replaces snapshot_ with a copy of the entry's current data.
+      void UpdateSnapshot() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
        public:
         BackoffTimer(RefCountedPtr<Entry> entry, Timestamp backoff_time);
@@ -489,6 +572,8 @@ class RlsLb : public LoadBalancingPolicy {
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
       Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+
+      RefCountedPtr<EntrySnapshot> snapshot_ ABSL_GUARDED_BY(&RlsLb::mu_);
     };
 
     explicit Cache(RlsLb* lb_policy);
@@ -518,6 +603,10 @@ class RlsLb : public LoadBalancingPolicy {
     // Shutdown the cache; clean-up and orphan all the stored cache entries.
     void Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Returns the current snapshots of all entries, for a new picker.
+    EntrySnapshotSet Snapshot() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
    private:
     // Shared logic for starting the cleanup timer
     void StartCleanupTimer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
@@ -686,6 +775,8 @@ class RlsLb : public LoadBalancingPolicy {
   // Returns a new picker to the channel to trigger reprocessing of
   // pending picks.  Schedules the actual picker update on the ExecCtx
   // to be run later, so it's safe to invoke this while holding the lock.
+  // Calls made while an update is already scheduled are folded into it, so
+  // a burst of RLS responses snapshots the cache only once.
   void UpdatePickerAsync();
   // Hops into work serializer and calls UpdatePickerLocked().
   static void UpdatePickerCallback(void* arg, grpc_error_handle error);
@@ -696,6 +787,8 @@ class RlsLb : public LoadBalancingPolicy {
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
   bool update_in_progress_ = false;
+  // Set while an UpdatePickerAsync() call is waiting to run.
+  std::atomic<bool> picker_update_pending_{false};
   Cache cache_ ABSL_GUARDED_BY(mu_);
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
@@ -962,6 +1055,18 @@ RlsLb::Picker::Picker(RefCountedPtr<RlsLb> lb_policy)
     default_child_policy_ =
         lb_policy_->default_child_policy_->Ref(DEBUG_LOCATION, "Picker");
   }
+  MutexLock lock(&lb_policy_->mu_);
+  if (lb_policy_->is_shutdown_) return;
+  if (default_child_policy_ != nullptr) {
+    default_child_picker_ = default_child_policy_->picker();
+  }
+  children_.reserve(lb_policy_->child_policy_map_.size());
+  for (const auto& p : lb_policy_->child_policy_map_) {
+    children_.emplace(p.second,
+                      ChildState{p.second->picker(),
+                                 p.second->connectivity_state(), p.first});
+  }
+  entries_ = lb_policy_->cache_.Snapshot();
 }
 
 LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
@@ -975,6 +1080,8 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = Timestamp::Now();
+  absl::optional<PickResult> result = PickFromSnapshot(key, now, args);
+  if (result.has_value()) return std::move(*result);
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1056,6 +1163,72 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   return PickResult::Queue();
 }
 
+absl::optional<LoadBalancingPolicy::PickResult>
+RlsLb::Picker::PickFromSnapshot(const RequestKey& key, Timestamp now,
+                                PickArgs args) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return absl::nullopt;
+  EntrySnapshot& entry = **it;
+  // If the entry is stale and not in backoff, Pick() may need to start an
+  // RLS request, which needs the lock.
+  if (entry.stale_time < now && entry.backoff_time < now) return absl::nullopt;
+  if (!entry.used.load(std::memory_order_relaxed)) {
+    entry.used.store(true, std::memory_order_relaxed);
+  }
+  // If the entry has non-expired data, use it.  As in
+  // Cache::Entry::Pick(), skip targets before the last one that are in
+  // state TRANSIENT_FAILURE.
+  if (entry.data_expiration_time >= now) {
+    const ChildState* child = nullptr;
+    for (size_t i = 0; i < entry.targets.size(); ++i) {
+      auto child_it = children_.find(entry.targets[i]);
+      if (child_it == children_.end()) return absl::nullopt;
+      child = &child_it->second;
+      if (child->connectivity_state != GRPC_CHANNEL_TRANSIENT_FAILURE ||
+          i == entry.targets.size() - 1) {
+        break;
+      }
+    }
+    if (child == nullptr) return absl::nullopt;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO,
+              "[rlslb %p] picker=%p: using cached entry %s, target %s in "
+              "state %s",
+              lb_policy_.get(), this, entry.key.ToString().c_str(),
+              child->target.c_str(),
+              ConnectivityStateName(child->connectivity_state));
+    }
+    if (!entry.header_data.empty()) {
+      char* copied_header_data = static_cast<char*>(
+          args.call_state->Alloc(entry.header_data.length() + 1));
+      strcpy(copied_header_data, entry.header_data.c_str());
+      args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
+    }
+    return child->picker->Pick(args);
+  }
+  // If the entry is in backoff, then use the default target if set,
+  // or else fail the pick.
+  if (entry.backoff_time >= now) {
+    if (default_child_picker_ != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+        gpr_log(
+            GPR_INFO,
+            "[rlslb %p] picker=%p: RLS call in backoff; using default target",
+            lb_policy_.get(), this);
+      }
+      return default_child_picker_->Pick(args);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO,
+              "[rlslb %p] picker=%p: RLS call in backoff; failing pick",
+              lb_policy_.get(), this);
+    }
+    return PickResult::Fail(absl::UnavailableError(
+        absl::StrCat("RLS request failed: ", entry.status.ToString())));
+  }
+  return absl::nullopt;
+}
+
 //
 // RlsLb::Cache::Entry::BackoffTimer
 //
@@ -1130,7 +1303,9 @@ RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
       backoff_state_(MakeCacheEntryBackoff()),
       min_expiration_time_(Timestamp::Now() + kMinExpirationTime),
       lru_iterator_(lb_policy_->cache_.lru_list_.insert(
-          lb_policy_->cache_.lru_list_.end(), key)) {}
+          lb_policy_->cache_.lru_list_.end(), key)) {
+  UpdateSnapshot();
+}
 
 void RlsLb::Cache::Entry::Orphan() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
@@ -1141,11 +1316,14 @@ void RlsLb::Cache::Entry::Orphan() {
   lb_policy_->cache_.lru_list_.erase(lru_iterator_);
   lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
   backoff_state_.reset();
-  if (backoff_timer_ != nullptr) {
+  // The current picker may still route to this entry's targets from its
+  // snapshot, so return a new one.
+  if (backoff_timer_ != nullptr || !child_policy_wrappers_.empty()) {
     backoff_timer_.reset();
     lb_policy_->UpdatePickerAsync();
   }
   child_policy_wrappers_.clear();
+  snapshot_.reset();
   Unref(DEBUG_LOCATION, "Orphan");
 }
 
@@ -1203,6 +1381,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
 void RlsLb::Cache::Entry::ResetBackoff() {
   backoff_time_ = Timestamp::InfPast();
   backoff_timer_.reset();
+  UpdateSnapshot();
 }
 
 bool RlsLb::Cache::Entry::ShouldRemove() const {
@@ -1222,6 +1401,26 @@ void RlsLb::Cache::Entry::MarkUsed() {
   lru_iterator_ = new_it;
 }
 
+void RlsLb::Cache::Entry::UpdateSnapshot() {
+  auto snapshot = MakeRefCounted<EntrySnapshot>();
+  snapshot->key = *lru_iterator_;
+  snapshot->hash = EntrySnapshotHash()(snapshot->key);
+  snapshot->status = status_;
+  snapshot->backoff_time = backoff_time_;
+  snapshot->data_expiration_time = data_expiration_time_;
+  snapshot->stale_time = stale_time_;
+  snapshot->header_data = header_data_;
+  snapshot->targets.reserve(child_policy_wrappers_.size());
+  for (const auto& child_policy_wrapper : child_policy_wrappers_) {
+    snapshot->targets.push_back(child_policy_wrapper.get());
+  }
+  if (snapshot_ != nullptr) {
+    snapshot->used.store(snapshot_->used.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  }
+  snapshot_ = std::move(snapshot);
+}
+
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
@@ -1241,6 +1440,7 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     backoff_expiration_time_ = now + (backoff_time_ - now) * 2;
     backoff_timer_ = MakeOrphanable<BackoffTimer>(
         Ref(DEBUG_LOCATION, "BackoffTimer"), backoff_time_);
+    UpdateSnapshot();
     lb_policy_->UpdatePickerAsync();
     return {};
   }
@@ -1267,16 +1467,11 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     // Targets didn't change, so we're not updating the list of child
     // policies.  Return a new picker so that any queued requests can be
     // re-processed.
+    UpdateSnapshot();
     lb_policy_->UpdatePickerAsync();
     return {};
   }
   // Target list changed, so update it.
-  std::set<absl::string_view> old_targets;
-  for (RefCountedPtr<ChildPolicyWrapper>& child_policy_wrapper :
-       child_policy_wrappers_) {
-    old_targets.emplace(child_policy_wrapper->target());
-  }
-  bool update_picker = false;
   std::vector<ChildPolicyWrapper*> child_policies_to_finish_update;
   std::vector<RefCountedPtr<ChildPolicyWrapper>> new_child_policy_wrappers;
   new_child_policy_wrappers.reserve(response.targets.size());
@@ -1291,19 +1486,14 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     } else {
       new_child_policy_wrappers.emplace_back(
           it->second->Ref(DEBUG_LOCATION, "CacheEntry"));
-      // If the target already existed but was not previously used for
-      // this key, then we'll need to update the picker, since we
-      // didn't actually create a new child policy, which would have
-      // triggered an RLS picker update when it returned its first picker.
-      if (old_targets.find(target) == old_targets.end()) {
-        update_picker = true;
-      }
     }
   }
   child_policy_wrappers_ = std::move(new_child_policy_wrappers);
-  if (update_picker) {
-    lb_policy_->UpdatePickerAsync();
-  }
+  // Pickers route from a snapshot of the entry, so return a new picker
+  // even if every target has a new child policy that will report its
+  // own first picker.
+  UpdateSnapshot();
+  lb_policy_->UpdatePickerAsync();
   return child_policies_to_finish_update;
 }
 
@@ -1363,6 +1553,13 @@ void RlsLb::Cache::ResetAllBackoff() {
   lb_policy_->UpdatePickerAsync();
 }
 
+RlsLb::EntrySnapshotSet RlsLb::Cache::Snapshot() const {
+  EntrySnapshotSet snapshots;
+  snapshots.reserve(map_.size());
+  for (const auto& p : map_) snapshots.insert(p.second->snapshot());
+  return snapshots;
+}
+
 void RlsLb::Cache::Shutdown() {
   map_.clear();
   lru_list_.clear();
@@ -1412,16 +1609,26 @@ void RlsLb::Cache::OnCleanupTimer() {
 }
 
 size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
-  // Key is stored twice, once in LRU list and again in the cache map.
-  return (key.Size() * 2) + sizeof(Entry);
+  // Key is stored three times: in the LRU list, in the cache map and in
+  // the entry's snapshot.
+  return (key.Size() * 3) + sizeof(Entry) + sizeof(EntrySnapshot);
 }
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
+  // Entries that pickers used since they were last looked at here get
+  // moved to the end of the LRU list instead of being evicted, at most
+  // once each per pass.
+  size_t second_chances = map_.size();
   while (size_ > bytes) {
     auto lru_it = lru_list_.begin();
     if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
     auto map_it = map_.find(*lru_it);
     GPR_ASSERT(map_it != map_.end());
+    if (second_chances > 0 && map_it->second->TakeUsedByPicker()) {
+      --second_chances;
+      map_it->second->MarkUsed();
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
@@ -2023,6 +2230,9 @@ void RlsLb::ShutdownLocked() {
 }
 
 void RlsLb::UpdatePickerAsync() {
+  if (picker_update_pending_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
   // Run via the ExecCtx, since the caller may be holding the lock, and
   // we don't want to be doing that when we hop into the WorkSerializer,
   // in case the WorkSerializer callback happens to run inline.
@@ -2039,6 +2249,9 @@ void RlsLb::UpdatePickerCallback(void* arg, grpc_error_handle /*error*/) {
   rls_lb->work_serializer()->Run(
       [rls_lb]() {
         RefCountedPtr<RlsLb> lb_policy(rls_lb);
+        // Cleared before the picker snapshots the cache, so that changes
+        // made from here on schedule another update.
+        lb_policy->picker_update_pending_.store(false);
         lb_policy->UpdatePickerLocked();
         lb_policy.reset(DEBUG_LOCATION, "UpdatePickerCallback");
       },
@@ -0,0 +1,120 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_SHARDED_WEIGHT_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_SHARDED_WEIGHT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+
+// The weight most recently reported for one address by WRR, and how long
+// reports have been arriving.
+//
+// Every call to the address reports its weight, so the data is sharded per
+// cpu, each shard with its own mutex.  Get() uses the most recent update
+// across all shards and the earliest non_empty_since.
+class ShardedWeight {
+ public:
+  struct Combined {
+    float weight = 0;
+    Timestamp last_update_time = Timestamp::InfPast();
+    Timestamp non_empty_since = Timestamp::InfFuture();
+  };
+
+  // Records a weight reported at now in the calling cpu's shard.
+  void Update(float weight, Timestamp now) {
+    Shard& shard = shards_.this_cpu();
+    MutexLock lock(&shard.mu);
+    if (shard.non_empty_since == Timestamp::InfFuture()) {
+      shard.non_empty_since = now;
+    }
+    shard.weight = weight;
+    shard.last_update_time = now;
+  }
+
+  Combined Get() {
+    Combined combined;
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      if (shard.last_update_time > combined.last_update_time) {
+        combined.weight = shard.weight;
+        combined.last_update_time = shard.last_update_time;
+      }
+      combined.non_empty_since =
+          std::min(combined.non_empty_since, shard.non_empty_since);
+    }
+    return combined;
+  }
+
+  // Resets non_empty_since in the shards whose last update is at least
+  // weight_expiration_period old.  Shards updated since Get() are left
+  // alone.
+  void ExpireNonEmptySince(Timestamp now, Duration weight_expiration_period) {
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      if (now - shard.last_update_time >= weight_expiration_period) {
+        shard.non_empty_since = Timestamp::InfFuture();
+      }
+    }
+  }
+
+  void ResetNonEmptySince() {
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      shard.non_empty_since = Timestamp::InfFuture();
+    }
+  }
+
+ private:
+  // Cpus updating different shards must not share a cacheline.  As for
+  // channelz's PerCpuData, only C++17 guarantees the alignment of the
+  // shards PerCpu allocates, so earlier versions pad instead.
+#if __cplusplus >= 201703L
+  struct alignas(GPR_CACHELINE_SIZE) Shard {
+    Mutex mu;
+    float weight ABSL_GUARDED_BY(&mu) = 0;
+    Timestamp non_empty_since ABSL_GUARDED_BY(&mu) = Timestamp::InfFuture();
+    Timestamp last_update_time ABSL_GUARDED_BY(&mu) = Timestamp::InfPast();
+  };
+#else
+  struct ShardHeader {
+    Mutex mu;
+    float weight ABSL_GUARDED_BY(&mu) = 0;
+    Timestamp non_empty_since ABSL_GUARDED_BY(&mu) = Timestamp::InfFuture();
+    Timestamp last_update_time ABSL_GUARDED_BY(&mu) = Timestamp::InfPast();
+  };
+  struct Shard : public ShardHeader {
+    uint8_t padding[GPR_CACHELINE_SIZE - sizeof(ShardHeader)];
+  };
+#endif
+
+  PerCpu<Shard> shards_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_SHARDED_WEIGHT_H
@@ -47,6 +47,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/sharded_weight.h"
 #include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -172,10 +173,7 @@ class WeightedRoundRobin : public LoadBalancingPolicy {
     RefCountedPtr<WeightedRoundRobin> wrr_;
     const std::string key_;
 
-    Mutex mu_;
-    float weight_ ABSL_GUARDED_BY(&mu_) = 0;
-    Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
-    Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+    ShardedWeight weight_;
   };
 
   // Forward declaration.
@@ -422,57 +420,52 @@ void WeightedRoundRobin::AddressWeight::MaybeUpdateWeight(
     return;
   }
   Timestamp now = Timestamp::Now();
-  // Grab the lock and update the data.
-  MutexLock lock(&mu_);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
     gpr_log(GPR_INFO,
             "[WRR %p] subchannel %s: qps=%f, eps=%f, utilization=%f "
-            "error_util_penalty=%f : setting weight=%f weight_=%f now=%s "
-            "last_update_time_=%s non_empty_since_=%s",
+            "error_util_penalty=%f : setting weight=%f now=%s",
             wrr_.get(), key_.c_str(), qps, eps, utilization,
-            error_utilization_penalty, weight, weight_, now.ToString().c_str(),
-            last_update_time_.ToString().c_str(),
-            non_empty_since_.ToString().c_str());
+            error_utilization_penalty, weight, now.ToString().c_str());
   }
-  if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
-  weight_ = weight;
-  last_update_time_ = now;
+  weight_.Update(weight, now);
 }
 
 float WeightedRoundRobin::AddressWeight::GetWeight(
     Timestamp now, Duration weight_expiration_period,
     Duration blackout_period) {
-  MutexLock lock(&mu_);
+  const ShardedWeight::Combined combined = weight_.Get();
+  const float weight = combined.weight;
+  const Timestamp last_update_time = combined.last_update_time;
+  const Timestamp non_empty_since = combined.non_empty_since;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
     gpr_log(GPR_INFO,
             "[WRR %p] subchannel %s: getting weight: now=%s "
             "weight_expiration_period=%s blackout_period=%s "
-            "last_update_time_=%s non_empty_since_=%s weight_=%f",
+            "last_update_time=%s non_empty_since=%s weight=%f",
             wrr_.get(), key_.c_str(), now.ToString().c_str(),
             weight_expiration_period.ToString().c_str(),
             blackout_period.ToString().c_str(),
-            last_update_time_.ToString().c_str(),
-            non_empty_since_.ToString().c_str(), weight_);
+            last_update_time.ToString().c_str(),
+            non_empty_since.ToString().c_str(), weight);
   }
   // If the most recent update was longer ago than the expiration
-  // period, reset non_empty_since_ so that we apply the blackout period
+  // period, reset non_empty_since so that we apply the blackout period
   // again if we start getting data again in the future, and return 0.
-  if (now - last_update_time_ >= weight_expiration_period) {
-    non_empty_since_ = Timestamp::InfFuture();
+  if (now - last_update_time >= weight_expiration_period) {
+    weight_.ExpireNonEmptySince(now, weight_expiration_period);
     return 0;
   }
   // If we don't have at least blackout_period worth of data, return 0.
   if (blackout_period > Duration::Zero() &&
-      now - non_empty_since_ < blackout_period) {
+      now - non_empty_since < blackout_period) {
     return 0;
   }
   // Otherwise, return the weight.
-  return weight_;
+  return weight;
 }
 
 void WeightedRoundRobin::AddressWeight::ResetNonEmptySince() {
-  MutexLock lock(&mu_);
-  non_empty_since_ = Timestamp::InfFuture();
+  weight_.ResetNonEmptySince();
 }
 
 //
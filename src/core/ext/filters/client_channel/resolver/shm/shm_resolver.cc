@@ -0,0 +1,120 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/port.h"  // IWYU pragma: keep
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/shm/shm_handshaker.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_factory.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/uri/uri_parser.h"
+
+namespace grpc_core {
+namespace {
+
+// Resolves "shm:<path>" to the unix socket at path, marked to move onto
+// shared memory once connected.
+class ShmResolver : public Resolver {
+ public:
+  ShmResolver(ServerAddressList addresses, ResolverArgs args)
+      : result_handler_(std::move(args.result_handler)),
+        addresses_(std::move(addresses)),
+        channel_args_(std::move(args.args)) {}
+
+  void StartLocked() override {
+    Result result;
+    result.addresses = std::move(addresses_);
+    result.args = channel_args_;
+    channel_args_ = ChannelArgs();
+    result_handler_->ReportResult(std::move(result));
+  }
+
+  void ShutdownLocked() override {}
+
+ private:
+  std::unique_ptr<ResultHandler> result_handler_;
+  ServerAddressList addresses_;
+  ChannelArgs channel_args_;
+};
+
+class ShmResolverFactory : public ResolverFactory {
+ public:
+  absl::string_view scheme() const override { return GRPC_SHM_URI_SCHEME; }
+
+  bool IsValidUri(const URI& uri) const override {
+    return ParseUri(uri, nullptr);
+  }
+
+  OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
+    ServerAddressList addresses;
+    if (!ParseUri(args.uri, &addresses)) return nullptr;
+    return MakeOrphanable<ShmResolver>(std::move(addresses), std::move(args));
+  }
+
+ private:
+  static bool ParseUri(const URI& uri, ServerAddressList* addresses) {
+    if (!uri.authority().empty()) {
+      gpr_log(GPR_ERROR, "authority is not supported in shm scheme");
+      return false;
+    }
+    grpc_resolved_address addr;
+    grpc_error_handle error = UnixSockaddrPopulate(uri.path(), &addr);
+    if (!error.ok()) {
+      gpr_log(GPR_ERROR, "%s", StatusToString(error).c_str());
+      return false;
+    }
+    if (addresses != nullptr) {
+      addresses->emplace_back(
+          addr, ChannelArgs().Set(GRPC_ARG_SHM_TRANSPORT, true));
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+void RegisterShmResolver(CoreConfiguration::Builder* builder) {
+  builder->resolver_registry()->RegisterResolverFactory(
+      std::make_unique<ShmResolverFactory>());
+}
+
+}  // namespace grpc_core
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+namespace grpc_core {
+
+void RegisterShmResolver(CoreConfiguration::Builder* /*builder*/) {}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
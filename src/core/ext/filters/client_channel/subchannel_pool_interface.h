@@ -49,6 +49,7 @@ class SubchannelKey {
   SubchannelKey& operator=(SubchannelKey&& other) noexcept = default;
 
   bool operator<(const SubchannelKey& other) const;
+  bool operator>(const SubchannelKey& other) const { return other < *this; }
 
   const grpc_resolved_address& address() const { return address_; }
   const ChannelArgs& args() const { return args_; }
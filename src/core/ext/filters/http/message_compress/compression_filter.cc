@@ -26,6 +26,7 @@
 
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
+#include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/optional.h"
@@ -95,6 +96,41 @@ CompressionFilter::CompressionFilter(const ChannelArgs& args)
       enable_decompression_(
           args.GetBool(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION)
               .value_or(true)) {
+  const int zlib_level =
+      args.GetInt(GRPC_ARG_COMPRESSION_ZLIB_LEVEL).value_or(-1);
+  if (zlib_level < -1 || zlib_level > 9) {
+    gpr_log(GPR_ERROR, "Invalid zlib compression level %d: using default",
+            zlib_level);
+  } else {
+    compression_options_.zlib_level = zlib_level;
+  }
+  const int chunk_size =
+      args.GetInt(GRPC_ARG_COMPRESSION_PARALLEL_CHUNK_SIZE).value_or(0);
+  if (chunk_size > 0) {
+    event_engine_ =
+        args.GetObjectRef<grpc_event_engine::experimental::EventEngine>();
+    compression_options_.parallel_chunk_size = chunk_size;
+    compression_options_.event_engine = event_engine_.get();
+  }
+  const absl::optional<absl::string_view> encoded_dictionary =
+      args.GetString(GRPC_ARG_COMPRESSION_DEFLATE_DICTIONARY);
+  if (encoded_dictionary.has_value() &&
+      !absl::Base64Unescape(*encoded_dictionary, &deflate_dictionary_)) {
+    gpr_log(GPR_ERROR, "Deflate dictionary is not valid base64: ignoring it");
+    deflate_dictionary_.clear();
+  }
+  if (deflate_dictionary_.size() > 32768) {
+    gpr_log(GPR_ERROR,
+            "Deflate dictionary of %" PRIuPTR
+            " bytes is larger than the 32KiB window: ignoring it",
+            deflate_dictionary_.size());
+    deflate_dictionary_.clear();
+  }
+  if (!deflate_dictionary_.empty() &&
+      enabled_compression_algorithms_.IsSet(GRPC_COMPRESS_DEFLATE)) {
+    enabled_compression_algorithms_.SetDeflateDictionaryId(
+        DeflateDictionaryId(deflate_dictionary_));
+  }
   // Make sure the default is enabled.
   if (!enabled_compression_algorithms_.IsSet(default_compression_algorithm_)) {
     const char* name;
@@ -109,8 +145,9 @@ CompressionFilter::CompressionFilter(const ChannelArgs& args)
   }
 }
 
-MessageHandle CompressionFilter::CompressMessage(
-    MessageHandle message, grpc_compression_algorithm algorithm) const {
+MessageHandle CompressionFilter::CompressMessage(MessageHandle message,
+                                                 CompressArgs args) const {
+  const grpc_compression_algorithm algorithm = args.algorithm;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
     gpr_log(GPR_INFO, "CompressMessage: len=%" PRIdPTR " alg=%d flags=%d",
             message->payload()->Length(), algorithm, message->flags());
@@ -132,8 +169,12 @@ MessageHandle CompressionFilter::CompressMessage(
   // Try to compress the payload.
   SliceBuffer tmp;
   SliceBuffer* payload = message->payload();
+  MessageCompressionOptions options = compression_options_;
+  if (args.use_deflate_dictionary) {
+    options.deflate_dictionary = deflate_dictionary_;
+  }
   bool did_compress = grpc_msg_compress(algorithm, payload->c_slice_buffer(),
-                                        tmp.c_slice_buffer());
+                                        tmp.c_slice_buffer(), options);
   // If we achieved compression send it as compressed, otherwise send it as (to
   // avoid spending cycles on the receiver decompressing).
   if (did_compress) {
@@ -196,8 +237,12 @@ absl::StatusOr<MessageHandle> CompressionFilter::DecompressMessage(
   }
   // Try to decompress the payload.
   SliceBuffer decompressed_slices;
+  MessageDecompressionOptions options;
+  options.deflate_dictionary = deflate_dictionary_;
+  options.max_output_size = args.max_recv_message_length.value_or(0);
   if (grpc_msg_decompress(args.algorithm, message->payload()->c_slice_buffer(),
-                          decompressed_slices.c_slice_buffer()) == 0) {
+                          decompressed_slices.c_slice_buffer(),
+                          options) == 0) {
     return absl::InternalError(
         absl::StrCat("Unexpected error decompressing data for algorithm ",
                      CompressionAlgorithmAsString(args.algorithm)));
@@ -243,24 +288,39 @@ CompressionFilter::DecompressArgs CompressionFilter::HandleIncomingMetadata(
                         max_recv_message_length};
 }
 
+bool CompressionFilter::PeerAcceptsDeflateDictionary(
+    const grpc_metadata_batch& incoming_metadata) const {
+  const absl::optional<uint32_t> local =
+      enabled_compression_algorithms_.deflate_dictionary_id();
+  if (!local.has_value()) return false;
+  const CompressionAlgorithmSet* accepted =
+      incoming_metadata.get_pointer(GrpcAcceptEncodingMetadata());
+  return accepted != nullptr && accepted->deflate_dictionary_id() == local;
+}
+
 ArenaPromise<ServerMetadataHandle> ClientCompressionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
-  auto compression_algorithm =
-      HandleOutgoingMetadata(*call_args.client_initial_metadata);
+  // We only learn whether the server has our dictionary from its initial
+  // metadata, so messages sent before that don't use it.
+  auto* compress_args = GetContext<Arena>()->New<CompressArgs>(CompressArgs{
+      HandleOutgoingMetadata(*call_args.client_initial_metadata), false});
   call_args.client_to_server_messages->InterceptAndMap(
-      [compression_algorithm,
+      [compress_args,
        this](MessageHandle message) -> absl::optional<MessageHandle> {
-        return CompressMessage(std::move(message), compression_algorithm);
+        return CompressMessage(std::move(message), *compress_args);
       });
   auto* decompress_args = GetContext<Arena>()->New<DecompressArgs>(
       DecompressArgs{GRPC_COMPRESS_ALGORITHMS_COUNT, absl::nullopt});
   auto* decompress_err =
       GetContext<Arena>()->New<Latch<ServerMetadataHandle>>();
   call_args.server_initial_metadata->InterceptAndMap(
-      [decompress_args, this](ServerMetadataHandle server_initial_metadata)
+      [decompress_args, compress_args,
+       this](ServerMetadataHandle server_initial_metadata)
           -> absl::optional<ServerMetadataHandle> {
         if (server_initial_metadata == nullptr) return absl::nullopt;
         *decompress_args = HandleIncomingMetadata(*server_initial_metadata);
+        compress_args->use_deflate_dictionary =
+            PeerAcceptsDeflateDictionary(*server_initial_metadata);
         return std::move(server_initial_metadata);
       });
   call_args.server_to_client_messages->InterceptAndMap(
@@ -299,22 +359,23 @@ ArenaPromise<ServerMetadataHandle> ServerCompressionFilter::MakeCallPromise(
         }
         return std::move(*r);
       });
-  auto* compression_algorithm =
-      GetContext<Arena>()->New<grpc_compression_algorithm>();
+  auto* compress_args = GetContext<Arena>()->New<CompressArgs>(CompressArgs{
+      GRPC_COMPRESS_NONE,
+      PeerAcceptsDeflateDictionary(*call_args.client_initial_metadata)});
   call_args.server_initial_metadata->InterceptAndMap(
-      [this, compression_algorithm](ServerMetadataHandle md) {
+      [this, compress_args](ServerMetadataHandle md) {
         if (grpc_call_trace.enabled()) {
           gpr_log(GPR_INFO, "%s[compression] Write metadata",
                   Activity::current()->DebugTag().c_str());
         }
         // Find the compression algorithm.
-        *compression_algorithm = HandleOutgoingMetadata(*md);
+        compress_args->algorithm = HandleOutgoingMetadata(*md);
         return md;
       });
   call_args.server_to_client_messages->InterceptAndMap(
-      [compression_algorithm,
+      [compress_args,
        this](MessageHandle message) -> absl::optional<MessageHandle> {
-        return CompressMessage(std::move(message), *compression_algorithm);
+        return CompressMessage(std::move(message), *compress_args);
       });
   // Run the next filter, and race it with getting an error from decompression.
   return PrioritizedRace(decompress_err->Wait(),
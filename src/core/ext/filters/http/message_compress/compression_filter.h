@@ -24,15 +24,20 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+#include <string>
+
 #include "absl/status/statusor.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/compression_types.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
@@ -63,6 +68,11 @@ namespace grpc_core {
 
 class CompressionFilter : public ChannelFilter {
  protected:
+  struct CompressArgs {
+    grpc_compression_algorithm algorithm;
+    // Does the peer accept our deflate dictionary?
+    bool use_deflate_dictionary;
+  };
   struct DecompressArgs {
     grpc_compression_algorithm algorithm;
     absl::optional<uint32_t> max_recv_message_length;
@@ -82,10 +92,12 @@ class CompressionFilter : public ChannelFilter {
       grpc_metadata_batch& outgoing_metadata);
   DecompressArgs HandleIncomingMetadata(
       const grpc_metadata_batch& incoming_metadata);
+  // Does the peer that sent incoming_metadata have our deflate dictionary?
+  bool PeerAcceptsDeflateDictionary(
+      const grpc_metadata_batch& incoming_metadata) const;
 
   // Compress one message synchronously.
-  MessageHandle CompressMessage(MessageHandle message,
-                                grpc_compression_algorithm algorithm) const;
+  MessageHandle CompressMessage(MessageHandle message, CompressArgs args) const;
   // Decompress one message synchronously.
   absl::StatusOr<MessageHandle> DecompressMessage(MessageHandle message,
                                                   DecompressArgs args) const;
@@ -102,6 +114,12 @@ class CompressionFilter : public ChannelFilter {
   bool enable_compression_;
   // Is decompression enabled?
   bool enable_decompression_;
+  // Tuning for deflate and gzip.
+  MessageCompressionOptions compression_options_;
+  // Runs parallel compression, if enabled.
+  std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine_;
+  // Preset deflate dictionary, or empty.
+  std::string deflate_dictionary_;
 };
 
 class ClientCompressionFilter final : public CompressionFilter {
@@ -0,0 +1,302 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chaotic_good/chaotic_good.h"
+
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+
+#include <grpc/impl/connectivity_state.h>
+
+#include "src/core/ext/transport/chaotic_good/client_transport.h"
+#include "src/core/ext/transport/chaotic_good/server_transport.h"
+#include "src/core/lib/gprpp/crash.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/surface/call.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/transport.h"
+#include "src/core/lib/transport/transport_impl.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+namespace {
+
+// The state shared by both sides' wrappers.  base must come first: the
+// stacks only see the grpc_transport.
+struct TransportBase {
+  TransportBase(const grpc_transport_vtable* vtable, const char* name)
+      : state_tracker(name, GRPC_CHANNEL_READY) {
+    base.vtable = vtable;
+  }
+
+  // Handles the ops both sides share.  Returns the error to disconnect the
+  // transport with, or OK if the op does not close it.  The caller
+  // disconnects outside the lock, since that runs OnClosed().
+  absl::Status PerformCommonOp(grpc_transport_op* op)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    if (op->start_connectivity_watch != nullptr) {
+      state_tracker.AddWatcher(op->start_connectivity_watch_state,
+                               std::move(op->start_connectivity_watch));
+    }
+    if (op->stop_connectivity_watch != nullptr) {
+      state_tracker.RemoveWatcher(op->stop_connectivity_watch);
+    }
+    if (op->send_ping.on_initiate != nullptr ||
+        op->send_ping.on_ack != nullptr) {
+      grpc_error_handle error = GRPC_ERROR_CREATE("Ping not supported");
+      ExecCtx::Run(DEBUG_LOCATION, op->send_ping.on_initiate, error);
+      ExecCtx::Run(DEBUG_LOCATION, op->send_ping.on_ack, error);
+    }
+    // The transport has no goaway yet: either op closes it, failing the
+    // calls still open.
+    absl::Status error = !op->disconnect_with_error.ok()
+                             ? op->disconnect_with_error
+                             : op->goaway_error;
+    ExecCtx::Run(DEBUG_LOCATION, op->on_consumed, absl::OkStatus());
+    if (!error.ok()) {
+      state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, absl::Status(),
+                             "chaotic good transport closed");
+    }
+    return error;
+  }
+
+  // Called by the transport once it closes, for whatever reason.
+  void OnClosed(absl::Status status) {
+    MutexLock lock(&mu);
+    // Already shut down if the stack closed it.
+    if (state_tracker.state() == GRPC_CHANNEL_SHUTDOWN) return;
+    state_tracker.SetState(GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+                           "chaotic good transport failed");
+  }
+
+  grpc_transport base;
+  Mutex mu;
+  // READY until the stack closes the transport (SHUTDOWN) or a connection
+  // fails (TRANSIENT_FAILURE).
+  ConnectivityStateTracker state_tracker ABSL_GUARDED_BY(mu);
+};
+
+int InitStream(grpc_transport*, grpc_stream*, grpc_stream_refcount*,
+               const void*, Arena*) {
+  Crash("chaotic good transport only makes promise based calls");
+}
+
+void PerformStreamOp(grpc_transport*, grpc_stream*,
+                     grpc_transport_stream_op_batch*) {
+  Crash("chaotic good transport only makes promise based calls");
+}
+
+void DestroyStream(grpc_transport*, grpc_stream*, grpc_closure*) {
+  Crash("chaotic good transport only makes promise based calls");
+}
+
+void SetPollset(grpc_transport*, grpc_stream*, grpc_pollset*) {}
+
+void SetPollsetSet(grpc_transport*, grpc_stream*, grpc_pollset_set*) {}
+
+grpc_endpoint* GetEndpoint(grpc_transport*) { return nullptr; }
+
+//******************************************************************************
+// Client
+//
+
+struct ClientTransportWrapper : public TransportBase {
+  ClientTransportWrapper(
+      const grpc_transport_vtable* vtable,
+      std::unique_ptr<PromiseEndpoint> control_endpoint,
+      std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+      std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+          event_engine)
+      : TransportBase(vtable, "chaotic_good_client"),
+        transport(std::make_unique<ClientTransport>(
+            std::move(control_endpoint), std::move(data_endpoints),
+            std::move(event_engine),
+            [this](absl::Status status) { OnClosed(std::move(status)); })) {}
+
+  const std::unique_ptr<ClientTransport> transport;
+};
+
+ArenaPromise<ServerMetadataHandle> ClientMakeCallPromise(
+    grpc_transport* gt, CallArgs call_args, NextPromiseFactory) {
+  return reinterpret_cast<ClientTransportWrapper*>(gt)
+      ->transport->MakeCallPromise(std::move(call_args));
+}
+
+void ClientPerformOp(grpc_transport* gt, grpc_transport_op* op) {
+  auto* t = reinterpret_cast<ClientTransportWrapper*>(gt);
+  absl::Status error;
+  {
+    MutexLock lock(&t->mu);
+    error = t->PerformCommonOp(op);
+  }
+  if (!error.ok()) t->transport->Disconnect(std::move(error));
+}
+
+void ClientDestroy(grpc_transport* gt) {
+  delete reinterpret_cast<ClientTransportWrapper*>(gt);
+}
+
+const grpc_transport_vtable kClientVtable = {0,
+                                             false,
+                                             "chaotic_good_client",
+                                             InitStream,
+                                             ClientMakeCallPromise,
+                                             SetPollset,
+                                             SetPollsetSet,
+                                             PerformStreamOp,
+                                             ClientPerformOp,
+                                             DestroyStream,
+                                             ClientDestroy,
+                                             GetEndpoint};
+
+//******************************************************************************
+// Server
+//
+
+struct ServerTransportWrapper : public TransportBase {
+  using AcceptStreamCallback = void (*)(void* user_data,
+                                        grpc_transport* transport,
+                                        const void* server_data);
+
+  explicit ServerTransportWrapper(const grpc_transport_vtable* vtable)
+      : TransportBase(vtable, "chaotic_good_server") {}
+
+  // Each stream's ref is released into the token the server stack passes
+  // back to ServerMakeCallPromise().
+  void Accept(RefCountedPtr<ServerTransport::Stream> stream)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    accept_stream_fn(accept_stream_user_data, &base, stream.release());
+  }
+
+  void OnStream(RefCountedPtr<ServerTransport::Stream> stream) {
+    MutexLock lock(&mu);
+    if (accept_stream_fn != nullptr) {
+      Accept(std::move(stream));
+    } else if (!acceptor_cleared) {
+      pending_streams.push_back(std::move(stream));
+    }
+    // Otherwise the stack is going away, and closing the transport ends
+    // the stream.
+  }
+
+  void SetAcceptStream(AcceptStreamCallback fn, void* user_data)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    accept_stream_fn = fn;
+    accept_stream_user_data = user_data;
+    if (fn == nullptr) {
+      acceptor_cleared = true;
+      pending_streams.clear();
+      return;
+    }
+    std::vector<RefCountedPtr<ServerTransport::Stream>> streams;
+    streams.swap(pending_streams);
+    for (auto& stream : streams) Accept(std::move(stream));
+  }
+
+  AcceptStreamCallback accept_stream_fn ABSL_GUARDED_BY(mu) = nullptr;
+  void* accept_stream_user_data ABSL_GUARDED_BY(mu) = nullptr;
+  bool acceptor_cleared ABSL_GUARDED_BY(mu) = false;
+  std::vector<RefCountedPtr<ServerTransport::Stream>> pending_streams
+      ABSL_GUARDED_BY(mu);
+  // Set once, right after creation; streams are only accepted after that.
+  std::unique_ptr<ServerTransport> transport;
+};
+
+ArenaPromise<ServerMetadataHandle> ServerMakeCallPromise(
+    grpc_transport* gt, CallArgs, NextPromiseFactory next) {
+  auto* t = reinterpret_cast<ServerTransportWrapper*>(gt);
+  // Adopts the ref released by Accept().
+  RefCountedPtr<ServerTransport::Stream> stream(
+      static_cast<ServerTransport::Stream*>(const_cast<void*>(
+          GetContext<CallContext>()
+              ->server_call_context()
+              ->server_stream_data())));
+  return t->transport->MakeCallPromise(std::move(stream), std::move(next));
+}
+
+void ServerPerformOp(grpc_transport* gt, grpc_transport_op* op) {
+  auto* t = reinterpret_cast<ServerTransportWrapper*>(gt);
+  absl::Status error;
+  {
+    MutexLock lock(&t->mu);
+    if (op->set_accept_stream) {
+      t->SetAcceptStream(op->set_accept_stream_fn,
+                         op->set_accept_stream_user_data);
+    }
+    error = t->PerformCommonOp(op);
+  }
+  if (!error.ok()) t->transport->Disconnect(std::move(error));
+}
+
+void ServerDestroy(grpc_transport* gt) {
+  delete reinterpret_cast<ServerTransportWrapper*>(gt);
+}
+
+const grpc_transport_vtable kServerVtable = {0,
+                                             false,
+                                             "chaotic_good_server",
+                                             InitStream,
+                                             ServerMakeCallPromise,
+                                             SetPollset,
+                                             SetPollsetSet,
+                                             PerformStreamOp,
+                                             ServerPerformOp,
+                                             DestroyStream,
+                                             ServerDestroy,
+                                             GetEndpoint};
+
+}  // namespace
+}  // namespace chaotic_good
+}  // namespace grpc_core
+
+grpc_transport* grpc_create_chaotic_good_client_transport(
+    std::unique_ptr<grpc_core::PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+        event_engine) {
+  auto* t = new grpc_core::chaotic_good::ClientTransportWrapper(
+      &grpc_core::chaotic_good::kClientVtable, std::move(control_endpoint),
+      std::move(data_endpoints), std::move(event_engine));
+  return &t->base;
+}
+
+grpc_transport* grpc_create_chaotic_good_server_transport(
+    std::unique_ptr<grpc_core::PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+        event_engine) {
+  auto* t = new grpc_core::chaotic_good::ServerTransportWrapper(
+      &grpc_core::chaotic_good::kServerVtable);
+  // Created outside the wrapper's lock: the transport may deliver a stream
+  // before its constructor returns.
+  t->transport = std::make_unique<grpc_core::chaotic_good::ServerTransport>(
+      std::move(control_endpoint), std::move(data_endpoints),
+      std::move(event_engine),
+      [t](grpc_core::RefCountedPtr<grpc_core::chaotic_good::ServerTransport::
+                                       Stream>
+              stream) { t->OnStream(std::move(stream)); },
+      [t](absl::Status status) { t->OnClosed(std::move(status)); });
+  return &t->base;
+}
@@ -0,0 +1,50 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+#include <vector>
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/transport/promise_endpoint.h"
+#include "src/core/lib/transport/transport_fwd.h"
+
+// Wrap a chaotic good connection, one control endpoint and its data
+// endpoints, as a grpc_transport for a channel or server stack.  The
+// transport only makes promise based calls, so the stacks built on it need
+// the promise based call experiments.  Connecting and handshaking are left
+// to the caller: there is no connector or listener for chaotic good yet.
+// The transport reports TRANSIENT_FAILURE once any of its connections
+// fails.
+
+grpc_transport* grpc_create_chaotic_good_client_transport(
+    std::unique_ptr<grpc_core::PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+        event_engine);
+
+// Streams the client opens before the server stack sets its acceptor wait
+// for it.
+grpc_transport* grpc_create_chaotic_good_server_transport(
+    std::unique_ptr<grpc_core::PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+        event_engine);
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_H
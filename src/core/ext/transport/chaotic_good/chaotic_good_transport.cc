@@ -0,0 +1,291 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chaotic_good/chaotic_good_transport.h"
+
+#include <utility>
+
+#include "absl/types/variant.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/match.h"
+#include "src/core/lib/promise/event_engine_wakeup_scheduler.h"
+#include "src/core/lib/promise/if.h"
+#include "src/core/lib/promise/loop.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/promise/try_seq.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+namespace {
+// Frames queued per connection before writers have to wait.
+const size_t kMaxQueuedFrames = 64;
+
+// Initial size of each stream's arena.
+const size_t kStreamArenaSize = 1024;
+
+const uint8_t kPadding[kMessageAlignment] = {};
+
+MessageHandle TakeMessage(ClientFragmentFrame& frame) {
+  return std::move(frame.message);
+}
+MessageHandle TakeMessage(ServerFragmentFrame& frame) {
+  return std::move(frame.message);
+}
+
+LoopCtl<absl::Status> ContinueIfOk(absl::Status status) {
+  if (!status.ok()) return status;
+  return Continue();
+}
+}  // namespace
+
+StreamBase::StreamBase(std::shared_ptr<MemoryAllocator> memory_allocator)
+    : memory_allocator(std::move(memory_allocator)),
+      arena(MakeScopedArena(kStreamArenaSize, this->memory_allocator.get())),
+      cancellation(1),
+      cancel_sender(cancellation.MakeSender()) {}
+
+ChaoticGoodTransport::DataConnection::DataConnection(
+    std::unique_ptr<PromiseEndpoint> endpoint)
+    : endpoint(std::move(endpoint)),
+      writes(kMaxQueuedFrames),
+      write_sender(writes.MakeSender()),
+      reads(kMaxQueuedFrames),
+      read_sender(reads.MakeSender()) {}
+
+ChaoticGoodTransport::ChaoticGoodTransport(
+    std::unique_ptr<PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine,
+    OnClosedFn on_closed)
+    : event_engine_(std::move(event_engine)),
+      memory_allocator_(std::make_shared<MemoryAllocator>(
+          ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+              "chaotic_good"))),
+      control_endpoint_(std::move(control_endpoint)),
+      outgoing_frames_receiver_(kMaxQueuedFrames),
+      outgoing_frames_(outgoing_frames_receiver_.MakeSender()),
+      on_closed_(std::move(on_closed)) {
+  GPR_ASSERT(!data_endpoints.empty());
+  // The loops keep pointers into data_connections_, so it must not be
+  // resized after this.
+  data_connections_.reserve(data_endpoints.size());
+  for (auto& endpoint : data_endpoints) {
+    data_connections_.emplace_back(std::move(endpoint));
+  }
+}
+
+ChaoticGoodTransport::~ChaoticGoodTransport() { Stop(); }
+
+// Serializes each queued frame, queues its payload to the stream's data
+// connection, then writes the frame to the control connection.  Queueing
+// the payload first keeps the payloads on each data connection in the
+// order their frames appear on the control connection.
+auto ChaoticGoodTransport::WriteControlLoop() {
+  return Loop([this]() {
+    return Seq(outgoing_frames_receiver_.Next(), [this](OutgoingFrame frame) {
+      uint32_t stream_id = 0;
+      SliceBuffer control;
+      MessageHandle message;
+      MatchMutable(
+          &frame.frame,
+          [&](ClientFragmentFrame* f) {
+            stream_id = f->stream_id;
+            control = f->Serialize(&hpack_compressor_);
+            message = TakeMessage(*f);
+          },
+          [&](ServerFragmentFrame* f) {
+            stream_id = f->stream_id;
+            control = f->Serialize(&hpack_compressor_);
+            message = TakeMessage(*f);
+          },
+          [&](CancelFrame* f) {
+            stream_id = f->stream_id;
+            control = f->Serialize(&hpack_compressor_);
+          });
+      const bool has_payload = message != nullptr;
+      SliceBuffer payload;
+      if (has_payload) {
+        payload.Swap(message->payload());
+        const uint32_t padding = MessagePadding(payload.Length());
+        if (padding != 0) {
+          payload.Append(Slice::FromStaticBuffer(kPadding, padding));
+        }
+      }
+      DataConnection* connection =
+          &data_connections_[DataConnectionIndex(stream_id)];
+      return Seq(
+          If(
+              has_payload,
+              [connection, payload = std::move(payload)]() mutable {
+                return connection->write_sender.Send(std::move(payload));
+              },
+              []() { return Immediate(true); }),
+          // If the data writer is gone the transport is closing; the control
+          // write will fail too.
+          [this, control = std::move(control)](bool) mutable {
+            return control_endpoint_->Write(std::move(control));
+          },
+          ContinueIfOk);
+    });
+  });
+}
+
+auto ChaoticGoodTransport::WriteDataLoop(DataConnection* connection) {
+  return Loop([connection]() {
+    return Seq(
+        connection->writes.Next(),
+        [connection](SliceBuffer payload) {
+          return connection->endpoint->Write(std::move(payload));
+        },
+        ContinueIfOk);
+  });
+}
+
+// Waits for the stream's data reader to have room for each frame, so that
+// reading stops while a data connection is behind.
+auto ChaoticGoodTransport::ReadControlLoop() {
+  return Loop([this]() {
+    return Map(
+        TrySeq(
+            control_endpoint_->ReadSlice(kFrameHeaderSize),
+            [](Slice header) { return FrameHeader::Parse(header.data()); },
+            [this](FrameHeader header) {
+              return TrySeq(control_endpoint_->Read(header.GetFrameLength()),
+                            [this, header](SliceBuffer frame) {
+                              return ParseControlFrame(header, frame);
+                            });
+            },
+            [this](PendingPayload pending) {
+              DataConnection* connection =
+                  &data_connections_[DataConnectionIndex(pending.stream_id)];
+              return Map(connection->read_sender.Send(std::move(pending)),
+                         [](bool queued) {
+                           return queued ? absl::OkStatus()
+                                         : absl::UnavailableError(
+                                               "Transport closed");
+                         });
+            }),
+        ContinueIfOk);
+  });
+}
+
+absl::StatusOr<ChaoticGoodTransport::PendingPayload>
+ChaoticGoodTransport::ParseControlFrame(const FrameHeader& header,
+                                        SliceBuffer& frame) {
+  if (header.flags.is_set(2)
+          ? header.message_padding != MessagePadding(header.message_length)
+          : header.message_length != 0 || header.message_padding != 0) {
+    return absl::InternalError("Bad message length or padding");
+  }
+  auto handler = OnControlFrame(header, frame, &hpack_parser_);
+  if (!handler.ok()) return handler.status();
+  return PendingPayload{header.stream_id, header.message_length,
+                        header.message_padding, std::move(*handler)};
+}
+
+// Reads payloads in the order their frames were queued, keeping the frames
+// of each stream in order.
+auto ChaoticGoodTransport::ReadDataLoop(DataConnection* connection) {
+  return Loop([connection]() {
+    return Seq(connection->reads.Next(), [connection](PendingPayload pending) {
+      const uint32_t padding = pending.padding;
+      return Map(
+          TrySeq(connection->endpoint->Read(pending.length + padding),
+                 [padding, handler = std::move(pending.handler)](
+                     SliceBuffer payload) mutable {
+                   payload.RemoveLastNBytes(padding);
+                   return Map(handler(std::move(payload)),
+                              [](Empty) { return absl::OkStatus(); });
+                 }),
+          ContinueIfOk);
+    });
+  });
+}
+
+Arena::PoolPtr<grpc_metadata_batch> ChaoticGoodTransport::CopyToArena(
+    const grpc_metadata_batch& metadata, Arena* arena) {
+  auto copy = arena->MakePooled<grpc_metadata_batch>(arena);
+  metadata_detail::CopySink<grpc_metadata_batch> sink(copy.get());
+  metadata.ForEach(&sink);
+  return copy;
+}
+
+Arena::PoolPtr<grpc_metadata_batch> ChaoticGoodTransport::MoveToArena(
+    Arena::PoolPtr<grpc_metadata_batch> metadata, Arena* from, Arena* to) {
+  if (metadata == nullptr || from == to) return metadata;
+  return CopyToArena(*metadata, to);
+}
+
+MessageHandle ChaoticGoodTransport::MoveToArena(MessageHandle message,
+                                                Arena* from, Arena* to) {
+  if (message == nullptr || from == to) return message;
+  return to->MakePooled<Message>(std::move(*message->payload()),
+                                 message->flags());
+}
+
+void ChaoticGoodTransport::Start() {
+  std::vector<ActivityPtr> activities;
+  auto on_done = [this](absl::Status status) {
+    if (status.ok()) status = absl::UnavailableError("Connection closed");
+    Close(std::move(status));
+  };
+  auto start = [&](auto loop) {
+    activities.push_back(MakeActivity(
+        std::move(loop), EventEngineWakeupScheduler(event_engine_), on_done));
+  };
+  start(WriteControlLoop());
+  start(ReadControlLoop());
+  for (DataConnection& connection : data_connections_) {
+    start(WriteDataLoop(&connection));
+    start(ReadDataLoop(&connection));
+  }
+  MutexLock lock(&activities_mu_);
+  GPR_ASSERT(activities_.empty());
+  activities_ = std::move(activities);
+}
+
+void ChaoticGoodTransport::Stop() {
+  std::vector<ActivityPtr> activities;
+  {
+    MutexLock lock(&activities_mu_);
+    activities.swap(activities_);
+  }
+  // Outside the lock: a stopped activity closes the transport.
+  activities.clear();
+}
+
+void ChaoticGoodTransport::Disconnect(absl::Status status) {
+  Close(std::move(status));
+  Stop();
+  // Nothing writes the frames anymore, so fail their senders.
+  outgoing_frames_receiver_.MarkClosed();
+}
+
+void ChaoticGoodTransport::Close(absl::Status status) {
+  if (closed_.exchange(true, std::memory_order_acq_rel)) return;
+  OnTransportClosed(status);
+  if (on_closed_ != nullptr) on_closed_(std::move(status));
+}
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
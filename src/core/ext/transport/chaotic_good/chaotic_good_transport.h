@@ -0,0 +1,298 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_TRANSPORT_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/variant.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+
+#include "src/core/ext/transport/chaotic_good/frame.h"
+#include "src/core/ext/transport/chaotic_good/frame_header.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/mpsc.h"
+#include "src/core/lib/promise/poll.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/promise_endpoint.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+// The part of a stream shared by its call and the transport.  A stream's
+// frames are parsed into and serialized from its arena, never the call's,
+// so frames still in the transport do not depend on the call's lifetime.
+struct StreamBase : public RefCounted<StreamBase, PolymorphicRefCount> {
+  explicit StreamBase(std::shared_ptr<MemoryAllocator> memory_allocator);
+
+  // Ends the call with status, ahead of any frames it has not taken yet.
+  void Cancel(absl::Status status) {
+    cancel_sender.UnbufferedImmediateSend(std::move(status));
+  }
+
+  // Declared first so that it outlives arena.  Shared because the calls of
+  // a server transport may outlive it.
+  const std::shared_ptr<MemoryAllocator> memory_allocator;
+  ScopedArenaPtr arena;
+  // Read by the call alongside its frames; see Cancel().
+  MpscReceiver<absl::Status> cancellation;
+  MpscSender<absl::Status> cancel_sender;
+  // Bytes of the frames queued to the call that it has not taken yet.
+  std::atomic<size_t> queued_bytes{0};
+};
+
+// A frame queued for writing, with a ref to the stream whose arena holds
+// the frame's metadata, if it has any.
+struct OutgoingFrame {
+  absl::variant<ClientFragmentFrame, ServerFragmentFrame, CancelFrame> frame;
+  RefCountedPtr<StreamBase> stream;
+};
+
+// The connection handling shared by the client and server transports.
+//
+// A transport has one control connection and one or more data connections.
+// Frame headers and HPACK-encoded metadata are written to the control
+// connection.  Message payloads, padded to kMessageAlignment, are written to
+// the data connection picked by the frame's stream id, so that one stream's
+// payloads stay in order while large payloads of other streams go out in
+// parallel.  Every connection is written and read by its own activity; a
+// slow data connection therefore never holds up control frames.
+//
+// Metadata is parsed in the order frames arrive on the control connection,
+// as HPACK requires.  The rest of each frame is queued to the reader of the
+// stream's data connection, which reads the payload (if any) and then
+// delivers the frame, so that frames of one stream are delivered in order.
+// The readers' queues are bounded, but delivering a frame to a stream never
+// waits: each stream buffers up to kMaxQueuedBytesPerStream that its call
+// has not taken, and a call that falls further behind is failed, so one
+// slow call never holds up the others.  Calls move metadata and messages
+// between their own arena and the stream's as frames are sent and received.
+class ChaoticGoodTransport {
+ public:
+  ChaoticGoodTransport(const ChaoticGoodTransport&) = delete;
+  ChaoticGoodTransport& operator=(const ChaoticGoodTransport&) = delete;
+  virtual ~ChaoticGoodTransport();
+
+  // Called once, with the error, when the transport closes.
+  using OnClosedFn = absl::AnyInvocable<void(absl::Status)>;
+
+  // Bytes of frames a stream may have queued that its call has not taken.
+  // A frame sent to a stream with nothing queued is always queued, however
+  // large its message.
+  static constexpr size_t kMaxQueuedBytesPerStream = 1024 * 1024;
+
+  // Closes the transport with status, failing its streams, and stops all
+  // reading and writing.  Frames still queued are dropped.
+  void Disconnect(absl::Status status);
+
+ protected:
+  // Called with a frame's message payload once it has been read, or with an
+  // empty buffer if the frame has no message.  The data reader waits for the
+  // returned promise before reading the next payload.
+  using PayloadHandler =
+      absl::AnyInvocable<Promise<Empty>(SliceBuffer payload)>;
+
+  // A frame parsed into its stream's arena, with the ref to the stream that
+  // keeps the arena alive until the frame is gone.
+  template <typename Stream, typename Frame>
+  struct StreamFrame {
+    // Declared first so that it outlives frame.
+    RefCountedPtr<Stream> stream;
+    Frame frame;
+  };
+
+  // What a fragment counts against kMaxQueuedBytesPerStream.
+  template <typename Frame>
+  static size_t QueuedSize(const Frame& frame) {
+    return kFrameHeaderSize +
+           (frame.message == nullptr ? 0 : frame.message->payload()->Length());
+  }
+
+  // Queues frame to stream.frames_sender without waiting.  Returns false,
+  // dropping the frame, if the stream would go over
+  // kMaxQueuedBytesPerStream; the caller then fails that stream.
+  template <typename Stream, typename Frame>
+  static bool QueueToStream(Stream& stream, Frame frame) {
+    const size_t size = QueuedSize(frame);
+    const size_t queued = stream.queued_bytes.load(std::memory_order_relaxed);
+    if (queued != 0 && queued + size > kMaxQueuedBytesPerStream) return false;
+    stream.queued_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (!stream.frames_sender.UnbufferedImmediateSend(std::move(frame))) {
+      // The call is already done and the frame was dropped.
+      stream.queued_bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // Called by a call for each frame it takes from its stream.
+  template <typename Frame>
+  static void TakeFromStream(StreamBase& stream, const Frame& frame) {
+    stream.queued_bytes.fetch_sub(QueuedSize(frame),
+                                  std::memory_order_relaxed);
+  }
+
+  // Returns a handler for frames nobody is waiting for.
+  static PayloadHandler DropPayload() {
+    return [](SliceBuffer) -> Promise<Empty> { return Immediate(Empty{}); };
+  }
+
+  static Arena::PoolPtr<grpc_metadata_batch> CopyToArena(
+      const grpc_metadata_batch& metadata, Arena* arena);
+  // Return metadata or a message allocated in from, now allocated in to.
+  // They are copied unless the arenas are the same.
+  static Arena::PoolPtr<grpc_metadata_batch> MoveToArena(
+      Arena::PoolPtr<grpc_metadata_batch> metadata, Arena* from, Arena* to);
+  static MessageHandle MoveToArena(MessageHandle message, Arena* from,
+                                   Arena* to);
+
+  ChaoticGoodTransport(
+      std::unique_ptr<PromiseEndpoint> control_endpoint,
+      std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+      std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+          event_engine,
+      OnClosedFn on_closed);
+
+  // Deserializes a frame read from the control connection.  Called from the
+  // control reader, one frame at a time.  frame holds the frame's metadata;
+  // the returned handler receives its message payload.  An error closes the
+  // transport.
+  virtual absl::StatusOr<PayloadHandler> OnControlFrame(
+      const FrameHeader& header, SliceBuffer& frame, HPackParser* parser) = 0;
+
+  // Called once, when a connection fails or the transport is disconnected,
+  // before on_closed.  Subclasses fail their streams.
+  virtual void OnTransportClosed(absl::Status status) = 0;
+
+  // Starts reading and writing.  Subclasses call this once they are ready
+  // for OnControlFrame().
+  void Start();
+
+  // Stops all reading and writing.  Subclass destructors must call this
+  // before destroying any state the handlers above use.
+  void Stop();
+
+  // Returns a promise that queues frame for writing through sender, the
+  // transport's own or one from MakeFrameSender().  It resolves to an error
+  // if the transport is closed.
+  static auto WriteFrame(MpscSender<OutgoingFrame>& sender,
+                         OutgoingFrame frame) {
+    return Map(sender.Send(std::move(frame)), [](bool queued) {
+      return queued ? absl::OkStatus()
+                    : absl::UnavailableError("Transport closed");
+    });
+  }
+  auto WriteFrame(OutgoingFrame frame) {
+    return WriteFrame(outgoing_frames_, std::move(frame));
+  }
+  // A sender of its own, for callers that may outlive the transport.
+  MpscSender<OutgoingFrame> MakeFrameSender() {
+    return outgoing_frames_receiver_.MakeSender();
+  }
+
+  // Queues frame for writing from outside an activity.  Returns false if the
+  // transport is closed.
+  bool WriteFrameNow(OutgoingFrame frame) {
+    return outgoing_frames_.UnbufferedImmediateSend(std::move(frame));
+  }
+
+  const std::shared_ptr<grpc_event_engine::experimental::EventEngine>&
+  event_engine() const {
+    return event_engine_;
+  }
+  // For the arenas of streams, and scratch arenas.
+  const std::shared_ptr<MemoryAllocator>& memory_allocator() const {
+    return memory_allocator_;
+  }
+
+ private:
+  // The part of a frame that waits for its payload on a data connection.
+  struct PendingPayload {
+    uint32_t stream_id;
+    uint32_t length;
+    uint32_t padding;
+    PayloadHandler handler;
+  };
+
+  struct DataConnection {
+    explicit DataConnection(std::unique_ptr<PromiseEndpoint> endpoint);
+
+    std::unique_ptr<PromiseEndpoint> endpoint;
+    MpscReceiver<SliceBuffer> writes;
+    MpscSender<SliceBuffer> write_sender;
+    MpscReceiver<PendingPayload> reads;
+    MpscSender<PendingPayload> read_sender;
+  };
+
+  size_t DataConnectionIndex(uint32_t stream_id) const {
+    return stream_id % data_connections_.size();
+  }
+
+  auto WriteControlLoop();
+  auto WriteDataLoop(DataConnection* connection);
+  auto ReadControlLoop();
+  auto ReadDataLoop(DataConnection* connection);
+  // Parses a frame read by the control reader into the part its stream's
+  // data connection waits for.
+  absl::StatusOr<PendingPayload> ParseControlFrame(const FrameHeader& header,
+                                                   SliceBuffer& frame);
+  void Close(absl::Status status);
+
+  const std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+      event_engine_;
+  const std::shared_ptr<MemoryAllocator> memory_allocator_;
+  std::unique_ptr<PromiseEndpoint> control_endpoint_;
+  std::vector<DataConnection> data_connections_;
+  MpscReceiver<OutgoingFrame> outgoing_frames_receiver_;
+  MpscSender<OutgoingFrame> outgoing_frames_;
+  // Only used by the control writer and reader respectively.
+  HPackCompressor hpack_compressor_;
+  HPackParser hpack_parser_;
+  OnClosedFn on_closed_;
+  std::atomic<bool> closed_{false};
+  // Declared last so that they are destroyed before the state they use.
+  // Locked because Disconnect() may stop them from any thread.
+  Mutex activities_mu_;
+  std::vector<ActivityPtr> activities_ ABSL_GUARDED_BY(activities_mu_);
+};
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CHAOTIC_GOOD_TRANSPORT_H
@@ -0,0 +1,246 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chaotic_good/client_transport.h"
+
+#include <stddef.h>
+
+#include <utility>
+
+#include "src/core/lib/promise/cancel_callback.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/for_each.h"
+#include "src/core/lib/promise/if.h"
+#include "src/core/lib/promise/loop.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/race.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/promise/try_seq.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+namespace {
+// Initial size of the arenas frames of finished calls are parsed into.
+const size_t kScratchArenaSize = 1024;
+}  // namespace
+
+ClientTransport::Stream::Stream(
+    std::shared_ptr<MemoryAllocator> memory_allocator)
+    : StreamBase(std::move(memory_allocator)),
+      frames(4),
+      frames_sender(frames.MakeSender()) {}
+
+ClientTransport::ClientTransport(
+    std::unique_ptr<PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine,
+    OnClosedFn on_closed)
+    : ChaoticGoodTransport(std::move(control_endpoint),
+                           std::move(data_endpoints), std::move(event_engine),
+                           std::move(on_closed)) {
+  Start();
+}
+
+ClientTransport::~ClientTransport() { Stop(); }
+
+ArenaPromise<ServerMetadataHandle> ClientTransport::MakeCallPromise(
+    CallArgs call_args) {
+  uint32_t stream_id;
+  RefCountedPtr<Stream> stream;
+  {
+    MutexLock lock(&mu_);
+    if (!closed_status_.ok()) {
+      return Immediate(ServerMetadataFromStatus(closed_status_));
+    }
+    stream_id = next_stream_id_++;
+    stream = MakeRefCounted<Stream>(memory_allocator());
+    streams_.emplace(stream_id, stream);
+  }
+  Arena* call_arena = GetContext<Arena>();
+  ClientFragmentFrame initial_frame;
+  initial_frame.stream_id = stream_id;
+  initial_frame.headers =
+      MoveToArena(std::move(call_args.client_initial_metadata), call_arena,
+                  stream->arena.get());
+  // Sends the client's metadata and messages, then half-closes the stream.
+  auto send = TrySeq(
+      WriteFrame(OutgoingFrame{std::move(initial_frame), stream}),
+      [token = std::move(call_args.client_initial_metadata_outstanding)]()
+          mutable {
+        token.Complete(true);
+        return absl::OkStatus();
+      },
+      [this, stream, stream_id, call_arena,
+       messages = std::move(*call_args.client_to_server_messages)]() mutable {
+        return ForEach(
+            std::move(messages),
+            [this, stream, stream_id, call_arena](MessageHandle message) {
+              ClientFragmentFrame frame;
+              frame.stream_id = stream_id;
+              frame.message = MoveToArena(std::move(message), call_arena,
+                                          stream->arena.get());
+              return WriteFrame(OutgoingFrame{std::move(frame), stream});
+            });
+      },
+      [this, stream_id]() {
+        ClientFragmentFrame frame;
+        frame.stream_id = stream_id;
+        frame.end_of_stream = true;
+        return WriteFrame(OutgoingFrame{std::move(frame), nullptr});
+      });
+  // Publishes the server's frames to the call until its trailers arrive.
+  auto receive = Loop([stream, call_arena,
+                       server_initial_metadata =
+                           call_args.server_initial_metadata,
+                       server_to_client_messages =
+                           call_args.server_to_client_messages]() {
+    Stream* s = stream.get();
+    return Seq(s->frames.Next(), [s, call_arena, server_initial_metadata,
+                                  server_to_client_messages](
+                                     ServerFragmentFrame frame) {
+      TakeFromStream(*s, frame);
+      Arena* stream_arena = s->arena.get();
+      ServerMetadataHandle headers =
+          MoveToArena(std::move(frame.headers), stream_arena, call_arena);
+      MessageHandle message =
+          MoveToArena(std::move(frame.message), stream_arena, call_arena);
+      ServerMetadataHandle trailers =
+          MoveToArena(std::move(frame.trailers), stream_arena, call_arena);
+      const bool has_headers = headers != nullptr;
+      const bool has_message = message != nullptr;
+      return Seq(
+          If(
+              has_headers,
+              [server_initial_metadata,
+               headers = std::move(headers)]() mutable {
+                return server_initial_metadata->Push(std::move(headers));
+              },
+              []() { return Immediate(true); }),
+          [has_message, server_to_client_messages,
+           message = std::move(message)](bool) mutable {
+            return If(
+                has_message,
+                [server_to_client_messages,
+                 message = std::move(message)]() mutable {
+                  return server_to_client_messages->Push(std::move(message));
+                },
+                []() { return Immediate(true); });
+          },
+          [server_to_client_messages, trailers = std::move(trailers)](
+              bool) mutable -> LoopCtl<ServerMetadataHandle> {
+            if (trailers == nullptr) return Continue();
+            server_to_client_messages->Close();
+            return std::move(trailers);
+          });
+    });
+  });
+  // The call is over once the server's trailers arrive, even if the client
+  // is still sending, or once the stream is cancelled: by the transport
+  // closing, or for falling too far behind.  Either way the stream stops
+  // taking frames, so that any still being delivered are dropped.
+  return OnCancel(
+      Map(Race(Map(stream->cancellation.Next(),
+                   [](absl::Status status) {
+                     return ServerMetadataFromStatus(status);
+                   }),
+               std::move(receive),
+               Seq(std::move(send),
+                   [](absl::Status) { return Never<ServerMetadataHandle>(); })),
+          [this, stream, stream_id](ServerMetadataHandle trailers) {
+            RemoveStream(stream_id);
+            stream->frames.MarkClosed();
+            return trailers;
+          }),
+      [this, stream, stream_id]() {
+        RemoveStream(stream_id);
+        stream->frames.MarkClosed();
+        CancelFrame frame;
+        frame.stream_id = stream_id;
+        WriteFrameNow(OutgoingFrame{frame, nullptr});
+      });
+}
+
+absl::StatusOr<ClientTransport::PayloadHandler> ClientTransport::OnControlFrame(
+    const FrameHeader& header, SliceBuffer& frame, HPackParser* parser) {
+  if (header.type != FrameType::kFragment) {
+    return absl::InternalError("Unexpected frame type from server");
+  }
+  StreamFrame<Stream, ServerFragmentFrame> fragment;
+  {
+    MutexLock lock(&mu_);
+    auto it = streams_.find(header.stream_id);
+    if (it != streams_.end()) fragment.stream = it->second;
+  }
+  // Frames of calls that already finished are still parsed, to keep the
+  // HPACK state in sync with the server's, then dropped.
+  ScopedArenaPtr scratch_arena;
+  Arena* arena;
+  if (fragment.stream != nullptr) {
+    arena = fragment.stream->arena.get();
+  } else {
+    scratch_arena =
+        MakeScopedArena(kScratchArenaSize, memory_allocator().get());
+    arena = scratch_arena.get();
+  }
+  {
+    promise_detail::Context<Arena> context(arena);
+    absl::Status status = fragment.frame.Deserialize(parser, header, frame);
+    if (!status.ok()) return status;
+  }
+  if (fragment.stream == nullptr) return DropPayload();
+  return PayloadHandler([this, stream_id = header.stream_id,
+                         has_message = header.flags.is_set(2),
+                         fragment = std::move(fragment)](
+                            SliceBuffer payload) mutable -> Promise<Empty> {
+    if (has_message) {
+      fragment.frame.message =
+          fragment.stream->arena->MakePooled<Message>(std::move(payload), 0);
+    }
+    if (!QueueToStream(*fragment.stream, std::move(fragment.frame))) {
+      // The call is not keeping up: end it on both sides.
+      RemoveStream(stream_id);
+      fragment.stream->Cancel(absl::ResourceExhaustedError(
+          "Call fell too far behind the server's frames"));
+      CancelFrame cancel;
+      cancel.stream_id = stream_id;
+      WriteFrameNow(OutgoingFrame{cancel, nullptr});
+    }
+    return Immediate(Empty{});
+  });
+}
+
+void ClientTransport::RemoveStream(uint32_t stream_id) {
+  MutexLock lock(&mu_);
+  streams_.erase(stream_id);
+}
+
+void ClientTransport::OnTransportClosed(absl::Status status) {
+  absl::flat_hash_map<uint32_t, RefCountedPtr<Stream>> streams;
+  {
+    MutexLock lock(&mu_);
+    closed_status_ = status;
+    streams.swap(streams_);
+  }
+  // Outside the lock: waking a call may finish it, and finishing removes
+  // its stream.
+  for (auto& p : streams) p.second->Cancel(status);
+}
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
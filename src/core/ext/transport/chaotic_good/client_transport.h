@@ -0,0 +1,92 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CLIENT_TRANSPORT_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CLIENT_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/ext/transport/chaotic_good/chaotic_good_transport.h"
+#include "src/core/ext/transport/chaotic_good/frame.h"
+#include "src/core/ext/transport/chaotic_good/frame_header.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/promise/mpsc.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/promise_endpoint.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+// The client side of a chaotic good connection.  Each call is a stream.
+class ClientTransport final : public ChaoticGoodTransport {
+ public:
+  ClientTransport(std::unique_ptr<PromiseEndpoint> control_endpoint,
+                  std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+                  std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+                      event_engine,
+                  OnClosedFn on_closed = nullptr);
+  ~ClientTransport() override;
+
+  // Returns the promise of a call on this transport, resolving to the
+  // server's trailing metadata.  Must be called in the call's activity,
+  // with the call's arena as context.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(CallArgs call_args);
+
+ private:
+  struct Stream : public StreamBase {
+    explicit Stream(std::shared_ptr<MemoryAllocator> memory_allocator);
+
+    // The server's frames, read by the call.  The transport bounds what is
+    // queued here by size; see QueueToStream().  Closed once the call is
+    // done, so that frames still being delivered are dropped.
+    MpscReceiver<ServerFragmentFrame> frames;
+    MpscSender<ServerFragmentFrame> frames_sender;
+  };
+
+  absl::StatusOr<PayloadHandler> OnControlFrame(const FrameHeader& header,
+                                                SliceBuffer& frame,
+                                                HPackParser* parser) override;
+  void OnTransportClosed(absl::Status status) override;
+
+  void RemoveStream(uint32_t stream_id);
+
+  Mutex mu_;
+  uint32_t next_stream_id_ ABSL_GUARDED_BY(mu_) = 1;
+  absl::flat_hash_map<uint32_t, RefCountedPtr<Stream>> streams_
+      ABSL_GUARDED_BY(mu_);
+  absl::Status closed_status_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_CLIENT_TRANSPORT_H
@@ -16,8 +16,6 @@
 
 #include "src/core/ext/transport/chaotic_good/frame.h"
 
-#include <string.h>
-
 #include <cstdint>
 #include <limits>
 #include <utility>
@@ -29,8 +27,8 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/bitset.h"
-#include "src/core/lib/gprpp/no_destruct.h"
 #include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/promise/context.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_buffer.h"
 
@@ -38,31 +36,43 @@ namespace grpc_core {
 namespace chaotic_good {
 
 namespace {
-const NoDestruct<Slice> kZeroSlice{[] {
-  // Frame header size is fixed to 24 bytes.
-  auto slice = GRPC_SLICE_MALLOC(24);
-  memset(GRPC_SLICE_START_PTR(slice), 0, 24);
-  return slice;
-}()};
-
 class FrameSerializer {
  public:
   explicit FrameSerializer(FrameType type, uint32_t stream_id)
       : header_{type, {}, stream_id, 0, 0, 0, 0} {
-    output_.AppendIndexed(kZeroSlice->Copy());
+    // Finish() serializes the header into this slice, so it must not be
+    // shared with other frames.
+    output_.AppendIndexed(
+        Slice(MutableSlice::CreateUninitialized(kFrameHeaderSize)));
   }
   // If called, must be called before AddTrailers, Finish.
   SliceBuffer& AddHeaders() {
     header_.flags.set(0);
     return output_;
   }
+  // The message itself is sent on a data connection; only its length and
+  // padding are recorded in the frame header.
+  void AddMessage(const Message& message) {
+    header_.flags.set(2);
+    header_.message_length = message.payload()->Length();
+    header_.message_padding = MessagePadding(header_.message_length);
+  }
   // If called, must be called before Finish.
   SliceBuffer& AddTrailers() {
     header_.flags.set(1);
+    header_.header_length = output_.Length() - kFrameHeaderSize;
     return output_;
   }
 
   SliceBuffer Finish() {
+    // Metadata is appended to output_ after the zeroed frame header, so the
+    // lengths are only known now.
+    const uint32_t metadata_length = output_.Length() - kFrameHeaderSize;
+    if (header_.flags.is_set(1)) {
+      header_.trailer_length = metadata_length - header_.header_length;
+    } else {
+      header_.header_length = metadata_length;
+    }
     header_.Serialize(
         GRPC_SLICE_START_PTR(output_.c_slice_buffer()->slices[0]));
     return std::move(output_);
@@ -115,7 +125,8 @@ absl::StatusOr<Arena::PoolPtr<Metadata>> ReadMetadata(
     uint32_t stream_id, bool is_header, bool is_client) {
   if (!maybe_slices.ok()) return maybe_slices.status();
   auto& slices = *maybe_slices;
-  Arena::PoolPtr<Metadata> metadata;
+  Arena* arena = GetContext<Arena>();
+  Arena::PoolPtr<Metadata> metadata = arena->MakePooled<Metadata>(arena);
   parser->BeginFrame(
       metadata.get(), std::numeric_limits<uint32_t>::max(),
       std::numeric_limits<uint32_t>::max(),
@@ -168,6 +179,7 @@ absl::Status ClientFragmentFrame::Deserialize(HPackParser* parser,
     auto r = ReadMetadata<ClientMetadata>(parser, deserializer.ReceiveHeaders(),
                                           header.stream_id, true, true);
     if (!r.ok()) return r.status();
+    headers = std::move(*r);
   }
   if (header.flags.is_set(1)) {
     if (header.trailer_length != 0) {
@@ -186,6 +198,9 @@ SliceBuffer ClientFragmentFrame::Serialize(HPackCompressor* encoder) const {
   if (headers.get() != nullptr) {
     encoder->EncodeRawHeaders(*headers.get(), serializer.AddHeaders());
   }
+  if (message.get() != nullptr) {
+    serializer.AddMessage(*message);
+  }
   if (end_of_stream) {
     serializer.AddTrailers();
   }
@@ -207,10 +222,13 @@ absl::Status ServerFragmentFrame::Deserialize(HPackParser* parser,
     auto r = ReadMetadata<ServerMetadata>(parser, deserializer.ReceiveHeaders(),
                                           header.stream_id, true, false);
     if (!r.ok()) return r.status();
+    headers = std::move(*r);
   }
   if (header.flags.is_set(1)) {
     auto r = ReadMetadata<ServerMetadata>(
         parser, deserializer.ReceiveTrailers(), header.stream_id, false, false);
+    if (!r.ok()) return r.status();
+    trailers = std::move(*r);
   }
   return deserializer.Finish();
 }
@@ -221,6 +239,9 @@ SliceBuffer ServerFragmentFrame::Serialize(HPackCompressor* encoder) const {
   if (headers.get() != nullptr) {
     encoder->EncodeRawHeaders(*headers.get(), serializer.AddHeaders());
   }
+  if (message.get() != nullptr) {
+    serializer.AddMessage(*message);
+  }
   if (trailers.get() != nullptr) {
     encoder->EncodeRawHeaders(*trailers.get(), serializer.AddTrailers());
   }
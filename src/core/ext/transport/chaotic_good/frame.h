@@ -35,6 +35,9 @@
 namespace grpc_core {
 namespace chaotic_good {
 
+// Frames are serialized to the bytes sent on the control connection.  A
+// fragment's message payload is not part of those bytes: the transport sends
+// it on a data connection and sets the fragment's message when receiving.
 class FrameInterface {
  public:
   virtual absl::Status Deserialize(HPackParser* parser,
@@ -75,10 +78,12 @@ struct ClientFragmentFrame final : public FrameInterface {
 
   uint32_t stream_id;
   ClientMetadataHandle headers;
+  MessageHandle message;
   bool end_of_stream = false;
 
   bool operator==(const ClientFragmentFrame& other) const {
     return stream_id == other.stream_id && EqHdl(headers, other.headers) &&
+           EqHdl(message, other.message) &&
            end_of_stream == other.end_of_stream;
   }
 };
@@ -90,11 +95,12 @@ struct ServerFragmentFrame final : public FrameInterface {
 
   uint32_t stream_id;
   ServerMetadataHandle headers;
+  MessageHandle message;
   ServerMetadataHandle trailers;
 
   bool operator==(const ServerFragmentFrame& other) const {
     return stream_id == other.stream_id && EqHdl(headers, other.headers) &&
-           EqHdl(trailers, other.trailers);
+           EqHdl(message, other.message) && EqHdl(trailers, other.trailers);
   }
 };
 
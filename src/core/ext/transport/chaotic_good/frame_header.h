@@ -17,6 +17,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <cstddef>
 #include <cstdint>
 
 #include "absl/status/statusor.h"
@@ -32,9 +33,26 @@ enum class FrameType : uint8_t {
   kCancel = 0x81,
 };
 
+// Size of a serialized FrameHeader.
+constexpr size_t kFrameHeaderSize = 24;
+
+// Message payloads are sent on a data connection, each followed by enough
+// padding to make the payload plus padding a multiple of this many bytes.
+// Every payload therefore starts at an aligned offset in the data stream,
+// so the receiver can hand out the bytes it read without copying them.
+constexpr uint32_t kMessageAlignment = 64;
+
+// Returns the padding to send after a message payload of length bytes.
+inline uint32_t MessagePadding(uint32_t length) {
+  return (kMessageAlignment - length % kMessageAlignment) % kMessageAlignment;
+}
+
 struct FrameHeader {
   FrameType type;
-  BitSet<2> flags;
+  // Bit 0: the frame carries headers.
+  // Bit 1: the frame carries trailers (or ends the stream).
+  // Bit 2: the frame carries a message, sent on a data connection.
+  BitSet<3> flags;
   uint32_t stream_id;
   uint32_t header_length;
   uint32_t message_length;
@@ -0,0 +1,428 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chaotic_good/server_transport.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "absl/strings/str_format.h"
+
+#include "src/core/lib/event_engine/default_event_engine.h"  // IWYU pragma: keep
+#include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/promise/cancel_callback.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/for_each.h"
+#include "src/core/lib/promise/if.h"
+#include "src/core/lib/promise/join.h"
+#include "src/core/lib/promise/latch.h"
+#include "src/core/lib/promise/loop.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/party.h"
+#include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/race.h"
+#include "src/core/lib/promise/seq.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+namespace {
+// Initial size of the arenas frames of finished calls are parsed into.
+const size_t kScratchArenaSize = 1024;
+}  // namespace
+
+// The pipes between a call and its stream, in the call's arena.
+struct ServerTransport::CallState {
+  explicit CallState(Arena* arena)
+      : server_initial_metadata(arena),
+        client_to_server_messages(arena),
+        server_to_client_messages(arena) {}
+
+  Latch<grpc_polling_entity> polling_entity;
+  Pipe<ServerMetadataHandle> server_initial_metadata;
+  Pipe<MessageHandle> client_to_server_messages;
+  Pipe<MessageHandle> server_to_client_messages;
+  bool client_half_closed = false;
+};
+
+// Runs the call of a stream when the transport was given a call handler.
+// The party uses the stream's arena, and so holds the stream until it is
+// over.
+class ServerTransport::CallParty final : public Party {
+ public:
+  CallParty(RefCountedPtr<Stream> stream,
+            std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+                event_engine)
+      : Party(stream->arena.get(), 1),
+        stream_(std::move(stream)),
+        event_engine_(std::move(event_engine)) {}
+
+  std::string DebugTag() const override {
+    return absl::StrFormat("CHAOTIC_GOOD_SERVER_CALL[%p]: stream %d", this,
+                           stream_->id);
+  }
+
+  bool RunParty() override {
+    promise_detail::Context<grpc_event_engine::experimental::EventEngine>
+        event_engine_context(event_engine_.get());
+    return Party::RunParty();
+  }
+
+  void PartyOver() override {
+    {
+      promise_detail::Context<grpc_event_engine::experimental::EventEngine>
+          event_engine_context(event_engine_.get());
+      CancelRemainingParticipants();
+    }
+    delete this;
+  }
+
+ private:
+  grpc_event_engine::experimental::EventEngine* event_engine() const override {
+    return event_engine_.get();
+  }
+
+  const RefCountedPtr<Stream> stream_;
+  const std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+      event_engine_;
+};
+
+ServerTransport::Stream::Stream(
+    uint32_t id, std::shared_ptr<MemoryAllocator> memory_allocator,
+    MpscSender<OutgoingFrame> outgoing)
+    : StreamBase(std::move(memory_allocator)),
+      id(id),
+      frames(4),
+      frames_sender(frames.MakeSender()),
+      outgoing(std::move(outgoing)) {}
+
+void ServerTransport::StreamTable::Remove(uint32_t stream_id) {
+  RefCountedPtr<Stream> stream;
+  MutexLock lock(&mu);
+  auto it = streams.find(stream_id);
+  if (it == streams.end()) return;
+  stream = std::move(it->second);
+  streams.erase(it);
+}
+
+ServerTransport::ServerTransport(
+    std::unique_ptr<PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine,
+    AcceptStreamFn accept_stream, OnClosedFn on_closed)
+    : ChaoticGoodTransport(std::move(control_endpoint),
+                           std::move(data_endpoints), std::move(event_engine),
+                           std::move(on_closed)),
+      accept_stream_(std::move(accept_stream)) {
+  Start();
+}
+
+ServerTransport::ServerTransport(
+    std::unique_ptr<PromiseEndpoint> control_endpoint,
+    std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine,
+    CallHandler call_handler, OnClosedFn on_closed)
+    : ChaoticGoodTransport(std::move(control_endpoint),
+                           std::move(data_endpoints), std::move(event_engine),
+                           std::move(on_closed)),
+      accept_stream_([this, call_handler = std::move(call_handler)](
+                         RefCountedPtr<Stream> stream) {
+        StartCall(std::move(stream), call_handler);
+      }) {
+  Start();
+}
+
+ServerTransport::~ServerTransport() {
+  // Closing the transport cancels the calls still running, which then
+  // finish on their own.
+  Stop();
+  absl::flat_hash_map<uint32_t, RefCountedPtr<Stream>> streams;
+  MutexLock lock(&table_->mu);
+  streams.swap(table_->streams);
+}
+
+absl::StatusOr<ServerTransport::PayloadHandler> ServerTransport::OnControlFrame(
+    const FrameHeader& header, SliceBuffer& frame, HPackParser* parser) {
+  switch (header.type) {
+    case FrameType::kSettings: {
+      SettingsFrame settings;
+      absl::Status status = settings.Deserialize(parser, header, frame);
+      if (!status.ok()) return status;
+      return DropPayload();
+    }
+    case FrameType::kCancel: {
+      CancelFrame cancel;
+      absl::Status status = cancel.Deserialize(parser, header, frame);
+      if (!status.ok()) return status;
+      // Ends the call at once, ahead of any frames it has not taken.
+      RefCountedPtr<Stream> stream = LookupStream(header.stream_id);
+      if (stream != nullptr) stream->Cancel(absl::CancelledError());
+      return DropPayload();
+    }
+    case FrameType::kFragment:
+      break;
+    default:
+      return absl::InternalError("Unexpected frame type from client");
+  }
+  StreamFrame<Stream, ClientFragmentFrame> fragment;
+  bool new_stream = false;
+  {
+    MutexLock lock(&table_->mu);
+    auto it = table_->streams.find(header.stream_id);
+    if (it != table_->streams.end()) {
+      fragment.stream = it->second;
+    } else if (header.flags.is_set(0) &&
+               header.stream_id > table_->last_stream_id) {
+      table_->last_stream_id = header.stream_id;
+      fragment.stream = MakeRefCounted<Stream>(
+          header.stream_id, memory_allocator(), MakeFrameSender());
+      table_->streams.emplace(header.stream_id, fragment.stream);
+      new_stream = true;
+    }
+  }
+  // Frames of calls that already finished are still parsed, to keep the
+  // HPACK state in sync with the client's, then dropped.
+  ScopedArenaPtr scratch_arena;
+  Arena* arena;
+  if (fragment.stream != nullptr) {
+    arena = fragment.stream->arena.get();
+  } else {
+    scratch_arena =
+        MakeScopedArena(kScratchArenaSize, memory_allocator().get());
+    arena = scratch_arena.get();
+  }
+  {
+    promise_detail::Context<Arena> context(arena);
+    absl::Status status = fragment.frame.Deserialize(parser, header, frame);
+    if (!status.ok()) return status;
+  }
+  if (fragment.stream == nullptr) return DropPayload();
+  if (new_stream) {
+    // Nothing else sees the stream until it is accepted.
+    fragment.stream->client_initial_metadata =
+        std::move(fragment.frame.headers);
+  }
+  return PayloadHandler(
+      [this, new_stream, has_message = header.flags.is_set(2),
+       fragment = std::move(fragment)](SliceBuffer payload) mutable
+      -> Promise<Empty> {
+        if (has_message) {
+          fragment.frame.message = fragment.stream->arena->MakePooled<Message>(
+              std::move(payload), 0);
+        }
+        if (new_stream) {
+          accept_stream_(fragment.stream);
+          // The rest of the first frame is handled like the frames after it.
+          if (fragment.frame.message == nullptr &&
+              !fragment.frame.end_of_stream) {
+            return Immediate(Empty{});
+          }
+        }
+        Stream* stream = fragment.stream.get();
+        if (!QueueToStream(*stream, std::move(fragment.frame))) {
+          // The call is not keeping up: end it on both sides.
+          table_->Remove(stream->id);
+          absl::Status status = absl::ResourceExhaustedError(
+              "Call fell too far behind the client's frames");
+          stream->Cancel(status);
+          ServerFragmentFrame frame;
+          frame.stream_id = stream->id;
+          frame.trailers =
+              ServerMetadataFromStatus(status, stream->arena.get());
+          stream->outgoing.UnbufferedImmediateSend(
+              OutgoingFrame{std::move(frame), std::move(fragment.stream)});
+        }
+        return Immediate(Empty{});
+      });
+}
+
+RefCountedPtr<ServerTransport::Stream> ServerTransport::LookupStream(
+    uint32_t stream_id) {
+  MutexLock lock(&table_->mu);
+  auto it = table_->streams.find(stream_id);
+  if (it == table_->streams.end()) return nullptr;
+  return it->second;
+}
+
+// Runs until the call handler has finished and its trailers are queued, or
+// until the client cancels the call.  Only the stream and its own sender to
+// the control writer are used, never the transport.
+auto ServerTransport::CallPromise(RefCountedPtr<Stream> stream,
+                                  RefCountedPtr<StreamTable> table,
+                                  CallHandler call_handler) {
+  Arena* call_arena = GetContext<Arena>();
+  Stream* s = stream.get();
+  CallState* call = call_arena->ManagedNew<CallState>(call_arena);
+  // Publishes the client's messages to the call until it half-closes, and
+  // takes its frames until the call is over.
+  auto receive = Loop([s, call, call_arena]() {
+    return Seq(s->frames.Next(), [s, call,
+                                  call_arena](ClientFragmentFrame frame) {
+      TakeFromStream(*s, frame);
+      MessageHandle message =
+          MoveToArena(std::move(frame.message), s->arena.get(), call_arena);
+      const bool end_of_stream = frame.end_of_stream;
+      const bool has_message =
+          message != nullptr && !call->client_half_closed;
+      return Seq(
+          If(
+              has_message,
+              [call, message = std::move(message)]() mutable {
+                return call->client_to_server_messages.sender.Push(
+                    std::move(message));
+              },
+              []() { return Immediate(true); }),
+          [call, end_of_stream](bool) -> LoopCtl<absl::Status> {
+            if (end_of_stream && !call->client_half_closed) {
+              call->client_half_closed = true;
+              call->client_to_server_messages.sender.Close();
+            }
+            return Continue();
+          });
+    });
+  });
+  // Sends the server's initial metadata, then its messages.
+  auto send = Seq(
+      call->server_initial_metadata.receiver.Next(),
+      [s, call_arena](NextResult<ServerMetadataHandle> headers) {
+        const bool has_headers = headers.has_value();
+        ServerFragmentFrame frame;
+        frame.stream_id = s->id;
+        if (has_headers) {
+          frame.headers =
+              MoveToArena(std::move(*headers), call_arena, s->arena.get());
+        }
+        return If(
+            has_headers,
+            [s, frame = std::move(frame)]() mutable {
+              return WriteFrame(s->outgoing,
+                                OutgoingFrame{std::move(frame), s->Ref()});
+            },
+            []() { return Immediate(absl::OkStatus()); });
+      },
+      [s, call, call_arena](absl::Status) {
+        return ForEach(
+            std::move(call->server_to_client_messages.receiver),
+            [s, call_arena](MessageHandle message) {
+              ServerFragmentFrame frame;
+              frame.stream_id = s->id;
+              frame.message =
+                  MoveToArena(std::move(message), call_arena, s->arena.get());
+              return WriteFrame(s->outgoing,
+                                OutgoingFrame{std::move(frame), s->Ref()});
+            });
+      });
+  CallArgs call_args{
+      MoveToArena(std::move(s->client_initial_metadata), s->arena.get(),
+                  call_arena),
+      ClientInitialMetadataOutstandingToken::Empty(),
+      &call->polling_entity,
+      &call->server_initial_metadata.sender,
+      &call->client_to_server_messages.receiver,
+      &call->server_to_client_messages.sender};
+  // Once the handler is done nothing more can be sent, so close the pipes
+  // to let the sender finish before the trailers are queued.
+  auto handle = Map(call_handler(std::move(call_args)),
+                    [call](ServerMetadataHandle trailers) {
+                      call->server_initial_metadata.sender.Close();
+                      call->server_to_client_messages.sender.Close();
+                      return trailers;
+                    });
+  // The call resolves to the trailers it sent, or to the error that ended
+  // it: the client cancelling, the transport closing, or the call falling
+  // too far behind.  Either way the stream stops taking frames, so that any
+  // still being delivered are dropped.
+  return OnCancel(
+      Map(Race(Map(s->cancellation.Next(),
+                   [](absl::Status status) {
+                     return ServerMetadataFromStatus(status);
+                   }),
+               Map(std::move(receive),
+                   [](absl::Status status) {
+                     return ServerMetadataFromStatus(status);
+                   }),
+               Seq(Join(std::move(handle), std::move(send)),
+                   [s](std::tuple<ServerMetadataHandle, absl::Status> result) {
+                     ServerMetadataHandle trailers =
+                         std::move(std::get<0>(result));
+                     ServerFragmentFrame frame;
+                     frame.stream_id = s->id;
+                     frame.trailers = CopyToArena(*trailers, s->arena.get());
+                     return Map(WriteFrame(s->outgoing,
+                                           OutgoingFrame{std::move(frame),
+                                                         s->Ref()}),
+                                [trailers = std::move(trailers)](
+                                    absl::Status status) mutable {
+                                  if (!status.ok()) {
+                                    return ServerMetadataFromStatus(status);
+                                  }
+                                  return std::move(trailers);
+                                });
+                   })),
+          [stream, table](ServerMetadataHandle result) {
+            table->Remove(stream->id);
+            stream->frames.MarkClosed();
+            return result;
+          }),
+      // Cancelled by the server: end the client's call too.
+      [stream, table]() {
+        table->Remove(stream->id);
+        stream->frames.MarkClosed();
+        ServerFragmentFrame frame;
+        frame.stream_id = stream->id;
+        frame.trailers = ServerMetadataFromStatus(absl::CancelledError(),
+                                                  stream->arena.get());
+        stream->outgoing.UnbufferedImmediateSend(
+            OutgoingFrame{std::move(frame), stream});
+      });
+}
+
+ArenaPromise<ServerMetadataHandle> ServerTransport::MakeCallPromise(
+    RefCountedPtr<Stream> stream, CallHandler call_handler) {
+  return CallPromise(std::move(stream), table_, std::move(call_handler));
+}
+
+void ServerTransport::StartCall(RefCountedPtr<Stream> stream,
+                                CallHandler call_handler) {
+  // The call holds the party's ref until it is done.
+  auto* party = new CallParty(stream, event_engine());
+  party->Spawn(
+      "chaotic_good_server_call",
+      [stream = std::move(stream), table = table_,
+       call_handler = std::move(call_handler)]() mutable {
+        return CallPromise(std::move(stream), std::move(table),
+                           std::move(call_handler));
+      },
+      [party](ServerMetadataHandle) { party->Unref(); });
+}
+
+void ServerTransport::OnTransportClosed(absl::Status) {
+  absl::flat_hash_map<uint32_t, RefCountedPtr<Stream>> streams;
+  {
+    MutexLock lock(&table_->mu);
+    streams.swap(table_->streams);
+  }
+  // Outside the lock: waking a call may finish it, and finishing removes
+  // its stream.
+  for (auto& p : streams) p.second->Cancel(absl::CancelledError());
+}
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
@@ -0,0 +1,140 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_SERVER_TRANSPORT_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_SERVER_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/ext/transport/chaotic_good/chaotic_good_transport.h"
+#include "src/core/ext/transport/chaotic_good/frame.h"
+#include "src/core/ext/transport/chaotic_good/frame_header.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/promise/mpsc.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/promise_endpoint.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+
+// The server side of a chaotic good connection.  Each stream the client
+// opens is handed to an acceptor, which creates a call for it and runs
+// MakeCallPromise() in that call.  Given a call handler instead, the
+// transport runs each call itself, on a party using the stream's arena.
+class ServerTransport final : public ChaoticGoodTransport {
+ public:
+  struct Stream;
+
+  // Runs a call: given the client's initial metadata and the call's pipes,
+  // returns the promise of its trailing metadata.  Called in the call's
+  // activity, with the call's arena as context.
+  using CallHandler = NextPromiseFactory;
+  // Called, from the transport's reader, for each stream the client opens.
+  using AcceptStreamFn = absl::AnyInvocable<void(RefCountedPtr<Stream>)>;
+
+  ServerTransport(std::unique_ptr<PromiseEndpoint> control_endpoint,
+                  std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+                  std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+                      event_engine,
+                  AcceptStreamFn accept_stream,
+                  OnClosedFn on_closed = nullptr);
+  ServerTransport(std::unique_ptr<PromiseEndpoint> control_endpoint,
+                  std::vector<std::unique_ptr<PromiseEndpoint>> data_endpoints,
+                  std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+                      event_engine,
+                  CallHandler call_handler, OnClosedFn on_closed = nullptr);
+  ~ServerTransport() override;
+
+  // Returns the promise of an accepted stream's call, resolving to the
+  // trailing metadata sent to the client.  Must be called in the call's
+  // activity, with the call's arena as context.  The promise does not use
+  // the transport, so the call may outlive it.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      RefCountedPtr<Stream> stream, CallHandler call_handler);
+
+ private:
+  class CallParty;
+  struct CallState;
+
+  // The streams the client has open.  Refcounted because calls remove
+  // their own stream when they finish.
+  struct StreamTable : public RefCounted<StreamTable> {
+    void Remove(uint32_t stream_id);
+
+    Mutex mu;
+    // Streams are opened with increasing ids; ids up to this one are used.
+    uint32_t last_stream_id ABSL_GUARDED_BY(mu) = 0;
+    absl::flat_hash_map<uint32_t, RefCountedPtr<Stream>> streams
+        ABSL_GUARDED_BY(mu);
+  };
+
+  absl::StatusOr<PayloadHandler> OnControlFrame(const FrameHeader& header,
+                                                SliceBuffer& frame,
+                                                HPackParser* parser) override;
+  void OnTransportClosed(absl::Status status) override;
+
+  RefCountedPtr<Stream> LookupStream(uint32_t stream_id);
+  // Runs the call of stream on a new CallParty.
+  void StartCall(RefCountedPtr<Stream> stream, CallHandler call_handler);
+  static auto CallPromise(RefCountedPtr<Stream> stream,
+                          RefCountedPtr<StreamTable> table,
+                          CallHandler call_handler);
+
+  AcceptStreamFn accept_stream_;
+  const RefCountedPtr<StreamTable> table_ = MakeRefCounted<StreamTable>();
+};
+
+// A stream opened by the client.  Only the transport looks inside; its
+// acceptor just hands it back to MakeCallPromise().
+struct ServerTransport::Stream : public StreamBase {
+  Stream(uint32_t id, std::shared_ptr<MemoryAllocator> memory_allocator,
+         MpscSender<OutgoingFrame> outgoing);
+
+  const uint32_t id;
+  // Set before the stream is accepted, read by its call.
+  ClientMetadataHandle client_initial_metadata;
+  // The client's frames after the initial metadata, read by the call.  The
+  // transport bounds what is queued here by size; see QueueToStream().
+  // Closed once the call is done, so that frames still being delivered are
+  // dropped.
+  MpscReceiver<ClientFragmentFrame> frames;
+  MpscSender<ClientFragmentFrame> frames_sender;
+  // The call's own sender to the control writer, which fails once the
+  // transport is gone.
+  MpscSender<OutgoingFrame> outgoing;
+};
+
+}  // namespace chaotic_good
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHAOTIC_GOOD_SERVER_TRANSPORT_H
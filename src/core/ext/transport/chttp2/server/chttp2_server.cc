@@ -51,6 +51,7 @@
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/shm/shm_handshaker.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
@@ -68,6 +69,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 #include "src/core/lib/iomgr/tcp_server.h"
@@ -101,6 +103,7 @@ using ::grpc_event_engine::experimental::EventEngine;
 const char kUnixUriPrefix[] = "unix:";
 const char kUnixAbstractUriPrefix[] = "unix-abstract:";
 const char kVSockUriPrefix[] = "vsock:";
+const char kShmUriPrefix[] = "shm:";
 
 class Chttp2ServerListener : public Server::ListenerInterface {
  public:
@@ -929,6 +932,7 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
   std::vector<grpc_error_handle> error_list;
   std::string parsed_addr = URI::PercentDecode(addr);
   absl::string_view parsed_addr_unprefixed{parsed_addr};
+  ChannelArgs listener_args = args;
   // Using lambda to avoid use of goto.
   grpc_error_handle error = [&]() {
     grpc_error_handle error;
@@ -940,6 +944,14 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
           grpc_resolve_unix_abstract_domain_address(parsed_addr_unprefixed);
     } else if (absl::ConsumePrefix(&parsed_addr_unprefixed, kVSockUriPrefix)) {
       resolved_or = grpc_resolve_vsock_address(parsed_addr_unprefixed);
+    } else if (absl::ConsumePrefix(&parsed_addr_unprefixed, kShmUriPrefix)) {
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+      resolved_or = grpc_resolve_unix_domain_address(parsed_addr_unprefixed);
+      listener_args = listener_args.Set(GRPC_ARG_SHM_TRANSPORT, true);
+#else
+      resolved_or = absl::UnimplementedError(
+          "shm: addresses are not supported on this platform");
+#endif
     } else {
       resolved_or =
           GetDNSResolver()->LookupHostnameBlocking(parsed_addr, "https");
@@ -955,8 +967,8 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
         grpc_sockaddr_set_port(&addr, *port_num);
       }
       int port_temp = -1;
-      error = Chttp2ServerListener::Create(server, &addr, args, args_modifier,
-                                           &port_temp);
+      error = Chttp2ServerListener::Create(server, &addr, listener_args,
+                                           args_modifier, &port_temp);
       if (!error.ok()) {
         error_list.push_back(error);
       } else {
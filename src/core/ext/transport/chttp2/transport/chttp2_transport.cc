@@ -317,6 +317,15 @@ void ForEachContextListEntryExecute(void* arg, Timestamps* ts,
 grpc_chttp2_transport::~grpc_chttp2_transport() {
   size_t i;
 
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    const auto& hpack_stats = hpack_compressor.table_stats();
+    gpr_log(GPR_INFO,
+            "%s[%p]: hpack encoder table hits=%" PRIu64 " inserts=%" PRIu64
+            " literals=%" PRIu64,
+            is_client ? "CLIENT" : "SERVER", this, hpack_stats.dynamic_hits,
+            hpack_stats.dynamic_inserts, hpack_stats.literals);
+  }
+
   event_engine.reset();
 
   if (channelz_socket != nullptr) {
@@ -384,6 +393,11 @@ static void read_channel_args(grpc_chttp2_transport* t,
   if (max_hpack_table_size >= 0) {
     t->hpack_compressor.SetMaxUsableSize(max_hpack_table_size);
   }
+  auto hpack_indexed_headers =
+      channel_args.GetString(GRPC_ARG_HTTP2_HPACK_INDEXED_HEADERS);
+  if (hpack_indexed_headers.has_value()) {
+    t->hpack_compressor.SetIndexedHeaders(*hpack_indexed_headers);
+  }
 
   t->write_buffer_size =
       std::max(0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)
@@ -23,6 +23,11 @@
 #include <algorithm>
 #include <cstdint>
 
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
@@ -114,6 +119,35 @@ void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
 }
 
+void HPackCompressor::SetIndexedHeaders(absl::string_view header_names) {
+  indexed_headers_.clear();
+  for (absl::string_view entry :
+       absl::StrSplit(header_names, ',', absl::SkipWhitespace())) {
+    // Metadata keys are always lower case on the wire.
+    std::string name = absl::AsciiStrToLower(absl::StripAsciiWhitespace(entry));
+    // Binary header values are rarely repeated and are encoded differently;
+    // core headers are already compressed by their own traits.
+    if (name.empty() || absl::EndsWith(name, "-bin") ||
+        absl::StartsWith(name, ":") ||
+        ValidateHeaderKeyIsLegal(name) != ValidateMetadataResult::kOk) {
+      gpr_log(GPR_ERROR, "Not indexing unsupported HPACK header '%s'",
+              name.c_str());
+      continue;
+    }
+    indexed_headers_.emplace_back(Slice::FromCopiedString(name));
+  }
+}
+
+size_t HPackCompressor::test_only_indexed_values(
+    absl::string_view name) const {
+  for (const auto& indexed_header : indexed_headers_) {
+    if (indexed_header.key.as_string_view() == name) {
+      return indexed_header.values.size();
+    }
+  }
+  return 0;
+}
+
 void HPackCompressor::SetMaxTableSize(uint32_t max_table_size) {
   if (table_.SetMaxSize(std::min(max_usable_size_, max_table_size))) {
     advertise_table_size_change_ = true;
@@ -243,6 +277,7 @@ class StringKey {
 
 namespace hpack_encoder_detail {
 void Encoder::EmitIndexed(uint32_t elem_index) {
+  if (elem_index > hpack_constants::kLastStaticEntry) ++dynamic_hits_;
   VarintWriter<1> w(elem_index);
   w.Write(0x80, output_.AddTiny(w.length()));
 }
@@ -258,6 +293,7 @@ uint32_t Encoder::EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice key_slice,
   emit.WritePrefix(output_.AddTiny(emit.prefix_length()));
   // Allocate an index in the hpack table for this newly emitted entry.
   // (we do so here because we know the length of the key and value)
+  ++dynamic_inserts_;
   uint32_t index = compressor_->table_.AllocateIndex(
       key_len + value_len + hpack_constants::kEntryOverhead);
   output_.Append(emit.data());
@@ -266,6 +302,7 @@ uint32_t Encoder::EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice key_slice,
 
 void Encoder::EmitLitHdrWithBinaryStringKeyNotIdx(Slice key_slice,
                                                   Slice value_slice) {
+  ++literals_;
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x00, output_.AddTiny(key.prefix_length()));
   output_.Append(key.key());
@@ -284,6 +321,7 @@ uint32_t Encoder::EmitLitHdrWithBinaryStringKeyIncIdx(Slice key_slice,
   emit.WritePrefix(output_.AddTiny(emit.prefix_length()));
   // Allocate an index in the hpack table for this newly emitted entry.
   // (we do so here because we know the length of the key and value)
+  ++dynamic_inserts_;
   uint32_t index = compressor_->table_.AllocateIndex(
       key_len + emit.hpack_length() + hpack_constants::kEntryOverhead);
   output_.Append(emit.data());
@@ -292,6 +330,7 @@ uint32_t Encoder::EmitLitHdrWithBinaryStringKeyIncIdx(Slice key_slice,
 
 void Encoder::EmitLitHdrWithBinaryStringKeyNotIdx(uint32_t key_index,
                                                   Slice value_slice) {
+  ++literals_;
   BinaryStringValue emit(std::move(value_slice), use_true_binary_metadata_);
   VarintWriter<4> key(key_index);
   uint8_t* data = output_.AddTiny(key.length() + emit.prefix_length());
@@ -302,6 +341,7 @@ void Encoder::EmitLitHdrWithBinaryStringKeyNotIdx(uint32_t key_index,
 
 void Encoder::EmitLitHdrWithNonBinaryStringKeyNotIdx(Slice key_slice,
                                                      Slice value_slice) {
+  ++literals_;
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x00, output_.AddTiny(key.prefix_length()));
   output_.Append(key.key());
@@ -315,7 +355,7 @@ void Encoder::AdvertiseTableSizeChange() {
   w.Write(0x20, output_.AddTiny(w.length()));
 }
 
-void SliceIndex::EmitTo(absl::string_view key, const Slice& value,
+void SliceIndex::EmitTo(const Slice& key, const Slice& value,
                         Encoder* encoder) {
   auto& table = encoder->hpack_table();
   using It = std::vector<ValueIndex>::iterator;
@@ -323,8 +363,7 @@ void SliceIndex::EmitTo(absl::string_view key, const Slice& value,
   size_t transport_length =
       key.length() + value.length() + hpack_constants::kEntryOverhead;
   if (transport_length > HPackEncoderTable::MaxEntrySize()) {
-    encoder->EmitLitHdrWithNonBinaryStringKeyNotIdx(
-        Slice::FromStaticString(key), value.Ref());
+    encoder->EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
     return;
   }
   // Linear scan through previous values to see if we find the value.
@@ -337,7 +376,7 @@ void SliceIndex::EmitTo(absl::string_view key, const Slice& value,
       } else {
         // Not current, emit a new literal and update the index.
         it->index = encoder->EmitLitHdrWithNonBinaryStringKeyIncIdx(
-            Slice::FromStaticString(key), value.Ref());
+            key.Ref(), value.Ref());
       }
       // Bubble this entry up if we can - ensures that the most used values end
       // up towards the start of the array.
@@ -353,13 +392,25 @@ void SliceIndex::EmitTo(absl::string_view key, const Slice& value,
     }
     prev = it;
   }
-  // No hit, emit a new literal and add it to the index.
+  // No hit, emit a new literal and add it to the index. Entries towards the
+  // end have been hit least recently, so make room by dropping the last one.
   uint32_t index = encoder->EmitLitHdrWithNonBinaryStringKeyIncIdx(
-      Slice::FromStaticString(key), value.Ref());
+      key.Ref(), value.Ref());
+  while (!values_.empty() &&
+         !table.ConvertableToDynamicIndex(values_.back().index)) {
+    values_.pop_back();
+  }
+  if (values_.size() >= kMaxValues) values_.pop_back();
   values_.emplace_back(value.Ref(), index);
 }
 
 void Encoder::Encode(const Slice& key, const Slice& value) {
+  for (auto& indexed_header : compressor_->indexed_headers_) {
+    if (indexed_header.key == key) {
+      indexed_header.values.EmitTo(indexed_header.key, value, this);
+      return;
+    }
+  }
   if (absl::EndsWith(key.as_string_view(), "-bin")) {
     EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
   } else {
@@ -512,5 +563,12 @@ Encoder::Encoder(HPackCompressor* compressor, bool use_true_binary_metadata,
   }
 }
 
+Encoder::~Encoder() {
+  auto& stats = compressor_->table_stats_;
+  stats.dynamic_hits += dynamic_hits_;
+  stats.dynamic_inserts += dynamic_inserts_;
+  stats.literals += literals_;
+}
+
 }  // namespace hpack_encoder_detail
 }  // namespace grpc_core
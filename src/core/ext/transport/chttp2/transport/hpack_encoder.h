@@ -24,6 +24,7 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -55,6 +56,9 @@ class Encoder {
  public:
   Encoder(HPackCompressor* compressor, bool use_true_binary_metadata,
           SliceBuffer& output);
+  ~Encoder();
+  Encoder(const Encoder&) = delete;
+  Encoder& operator=(const Encoder&) = delete;
 
   void Encode(const Slice& key, const Slice& value);
   template <typename MetadataTrait>
@@ -89,6 +93,11 @@ class Encoder {
   const bool use_true_binary_metadata_;
   HPackCompressor* const compressor_;
   SliceBuffer& output_;
+  // Counts for this header block, folded into the compressor's table stats
+  // when encoding finishes.
+  uint32_t dynamic_hits_ = 0;
+  uint32_t dynamic_inserts_ = 0;
+  uint32_t literals_ = 0;
 };
 
 // Compressor is partially specialized on CompressionTraits, but leaves
@@ -252,7 +261,14 @@ class Compressor<MetadataTrait, SmallIntegralValuesCompressor<N>> {
 
 class SliceIndex {
  public:
-  void EmitTo(absl::string_view key, const Slice& value, Encoder* encoder);
+  // The most values remembered at once. Once full, the least recently hit
+  // value is forgotten to make room for a new one, so that a header with
+  // many distinct values neither grows the index nor slows down the scan.
+  static constexpr size_t kMaxValues = 64;
+
+  void EmitTo(const Slice& key, const Slice& value, Encoder* encoder);
+
+  size_t size() const { return values_.size(); }
 
  private:
   struct ValueIndex {
@@ -268,7 +284,8 @@ template <typename MetadataTrait>
 class Compressor<MetadataTrait, SmallSetOfValuesCompressor> {
  public:
   void EncodeWith(MetadataTrait, const Slice& value, Encoder* encoder) {
-    index_.EmitTo(MetadataTrait::key(), value, encoder);
+    index_.EmitTo(Slice::FromStaticString(MetadataTrait::key()), value,
+                  encoder);
   }
 
  private:
@@ -332,10 +349,29 @@ class HPackCompressor {
 
   void SetMaxTableSize(uint32_t max_table_size);
   void SetMaxUsableSize(uint32_t max_table_size);
+  // Set the application (non-core) headers whose values should be added to
+  // the dynamic table when sent, from a comma separated list of header names.
+  // Without this, application headers are always sent as literals.
+  void SetIndexedHeaders(absl::string_view header_names);
+
+  // How headers were encoded over the life of this compressor. The dynamic
+  // table hit ratio (dynamic_hits / (dynamic_hits + dynamic_inserts)) is a
+  // good indicator of whether the table size is adequate for the workload.
+  struct TableStats {
+    // Headers sent as a reference to a dynamic table entry.
+    uint64_t dynamic_hits = 0;
+    // Headers sent as literals and added to the dynamic table.
+    uint64_t dynamic_inserts = 0;
+    // Headers sent as literals without being added to the dynamic table.
+    uint64_t literals = 0;
+  };
+  const TableStats& table_stats() const { return table_stats_; }
 
   uint32_t test_only_table_size() const {
     return table_.test_only_table_size();
   }
+  // Number of values remembered for a header passed to SetIndexedHeaders().
+  size_t test_only_indexed_values(absl::string_view name) const;
 
   struct EncodeHeaderOptions {
     uint32_t stream_id;
@@ -376,9 +412,19 @@ class HPackCompressor {
   // of this size
   bool advertise_table_size_change_ = false;
   HPackEncoderTable table_;
+  TableStats table_stats_;
 
   grpc_metadata_batch::StatefulCompressor<hpack_encoder_detail::Compressor>
       compression_state_;
+
+  // Application headers selected by SetIndexedHeaders(), with the values
+  // of each that have been added to the dynamic table.
+  struct IndexedHeader {
+    explicit IndexedHeader(Slice key) : key(std::move(key)) {}
+    Slice key;
+    hpack_encoder_detail::SliceIndex values;
+  };
+  std::vector<IndexedHeader> indexed_headers_;
 };
 
 namespace hpack_encoder_detail {
@@ -339,6 +339,17 @@ absl::string_view HPackParser::String::string_view() const {
   GPR_UNREACHABLE_CODE(return absl::string_view());
 }
 
+namespace {
+// The shortest huffman code is five bits long, which bounds the number of
+// symbols a huffman coded string of `length` bytes can decode to. Reserving
+// that much up front keeps the decoder's sink from reallocating as it grows.
+// Only bytes that have actually been received are counted, so that a large
+// length prefix alone cannot make us allocate.
+size_t MaxHuffDecodedLength(size_t length, size_t remaining) {
+  return std::min(length, remaining) * 8 / 5;
+}
+}  // namespace
+
 template <typename Out>
 HpackParseStatus HPackParser::String::ParseHuff(Input* input, uint32_t length,
                                                 Out output) {
@@ -490,6 +501,7 @@ HPackParser::String::StringResult HPackParser::String::Parse(Input* input,
   if (is_huff) {
     // Huffman coded
     std::vector<uint8_t> output;
+    output.reserve(MaxHuffDecodedLength(length, input->remaining()));
     HpackParseStatus sts =
         ParseHuff(input, length, [&output](uint8_t c) { output.push_back(c); });
     size_t wire_len = output.size();
@@ -513,6 +525,7 @@ HPackParser::String::StringResult HPackParser::String::ParseBinary(
   } else {
     // Huffman encoded...
     std::vector<uint8_t> decompressed;
+    decompressed.reserve(MaxHuffDecodedLength(length, input->remaining()));
     // State here says either we don't know if it's base64 or binary, or we do
     // and what is it.
     enum class State { kUnsure, kBinary, kBase64 };
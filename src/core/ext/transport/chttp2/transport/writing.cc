@@ -54,6 +54,7 @@
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/match.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -228,9 +229,23 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   }
 }
 
-// How many bytes would we like to put on the wire during a single syscall
-static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
-  return 1024 * 1024;
+// Bounds on how many bytes we would like to put on the wire during a single
+// syscall.
+static constexpr int64_t kMinTargetWriteSize = 1024 * 1024;
+static constexpr int64_t kMaxTargetWriteSize = 16 * 1024 * 1024;
+// Each visit of a stream during a write may frame at most this fraction of the
+// target write size (but always at least one frame), so that streams with
+// large messages are interleaved with the others instead of starving them.
+static constexpr uint32_t kStreamQuantumDivisor = 8;
+
+// How many bytes would we like to put on the wire during a single syscall.
+// Aim for twice the estimated bandwidth-delay product so that one write keeps
+// a fast connection busy until the next one is ready, but never go below the
+// size that amortizes the syscall for everyone else.
+static uint32_t target_write_size(grpc_chttp2_transport* t) {
+  return static_cast<uint32_t>(grpc_core::Clamp(
+      2 * t->flow_control.bdp_estimator()->EstimateBdp(), kMinTargetWriteSize,
+      kMaxTargetWriteSize));
 }
 
 namespace {
@@ -263,7 +278,8 @@ namespace {
 
 class WriteContext {
  public:
-  explicit WriteContext(grpc_chttp2_transport* t) : t_(t) {
+  explicit WriteContext(grpc_chttp2_transport* t)
+      : t_(t), target_write_size_(target_write_size(t)) {
     grpc_core::global_stats().IncrementHttp2WritesBegun();
   }
 
@@ -327,7 +343,7 @@ class WriteContext {
   }
 
   grpc_chttp2_stream* NextStream() {
-    if (t_->outbuf.length > target_write_size(t_)) {
+    if (t_->outbuf.length > target_write_size_) {
       result_.partial = true;
       return nullptr;
     }
@@ -344,6 +360,16 @@ class WriteContext {
   void IncWindowUpdateWrites() { ++flow_control_writes_; }
   void IncMessageWrites() { ++message_writes_; }
   void IncTrailingMetadataWrites() { ++trailing_metadata_writes_; }
+  void IncStreamsWritten() { ++streams_written_; }
+
+  // The maximum number of data bytes a stream may frame each time it is
+  // popped from the writable list. A stream with more data is put back at the
+  // end of the list, so that writable streams share each write round-robin.
+  size_t stream_quantum() const {
+    return std::max<size_t>(
+        target_write_size_ / kStreamQuantumDivisor,
+        t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]);
+  }
 
   void NoteScheduledResults() { result_.early_results_scheduled = true; }
 
@@ -351,11 +377,21 @@ class WriteContext {
 
   grpc_chttp2_begin_write_result Result() {
     result_.writing = t_->outbuf.count > 0;
+    if (result_.writing) {
+      grpc_core::global_stats().IncrementHttp2WriteTargetSize(
+          target_write_size_);
+      grpc_core::global_stats().IncrementHttp2StreamsPerWrite(
+          streams_written_);
+    }
+    if (result_.partial) {
+      grpc_core::global_stats().IncrementHttp2WritesPartial();
+    }
     return result_;
   }
 
  private:
   grpc_chttp2_transport* const t_;
+  const uint32_t target_write_size_;
 
   // stats histogram counters: we increment these throughout this function,
   // and at the end publish to the central stats histograms
@@ -363,6 +399,7 @@ class WriteContext {
   int initial_metadata_writes_ = 0;
   int trailing_metadata_writes_ = 0;
   int message_writes_ = 0;
+  int streams_written_ = 0;
   grpc_chttp2_begin_write_result result_ = {false, false, false};
 };
 
@@ -409,6 +446,10 @@ class DataSendContext {
 
   bool is_last_frame() const { return is_last_frame_; }
 
+  size_t bytes_sent() const {
+    return s_->sending_bytes - sending_bytes_before_;
+  }
+
   void CallCallbacks() {
     if (update_list(
             t_, s_,
@@ -516,8 +557,10 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
+    const size_t quantum = write_context_->stream_quantum();
     while (s_->flow_controlled_buffer.length > 0 &&
-           data_send_context.max_outgoing() > 0) {
+           data_send_context.max_outgoing() > 0 &&
+           data_send_context.bytes_sent() < quantum) {
       data_send_context.FlushBytes();
     }
     grpc_chttp2_reset_ping_clock(t_);
@@ -654,6 +697,7 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
         }
       }
       outbuf_relative_start_pos += num_stream_bytes;
+      ctx.IncStreamsWritten();
     }
     if (stream_ctx.stream_became_writable()) {
       if (!grpc_chttp2_list_add_writing_stream(t, s)) {
@@ -23,10 +23,12 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -89,38 +91,44 @@ void ResetSendMessage(grpc_transport_stream_op_batch* batch) {
   std::exchange(batch->payload->send_message.send_message, nullptr)->Clear();
 }
 
-struct shared_mu {
-  shared_mu() {
-    // Share one lock between both sides since both sides get affected
+// Lock shared by the two streams of one call: the client-side stream and the
+// server-side stream it was accepted as.  Both sides get affected by any op on
+// either, but calls have nothing to do with each other, so each call gets its
+// own lock rather than sharing one across the transport.
+struct stream_mu {
+  stream_mu() {
     gpr_mu_init(&mu);
-    gpr_ref_init(&refs, 2);
+    gpr_ref_init(&refs, 1);
   }
 
-  ~shared_mu() { gpr_mu_destroy(&mu); }
+  ~stream_mu() { gpr_mu_destroy(&mu); }
+
+  void ref() { gpr_ref(&refs); }
+
+  void unref() {
+    if (gpr_unref(&refs)) {
+      this->~stream_mu();
+      gpr_free(this);
+    }
+  }
 
   gpr_mu mu;
   gpr_refcount refs;
 };
 
 struct inproc_transport {
-  inproc_transport(const grpc_transport_vtable* vtable, shared_mu* mu,
-                   bool is_client)
-      : mu(mu),
-        is_client(is_client),
+  inproc_transport(const grpc_transport_vtable* vtable, bool is_client)
+      : is_client(is_client),
         state_tracker(is_client ? "inproc_client" : "inproc_server",
                       GRPC_CHANNEL_READY) {
     base.vtable = vtable;
+    gpr_mu_init(&mu);
     // Start each side of transport with 2 refs since they each have a ref
     // to the other
     gpr_ref_init(&refs, 2);
   }
 
-  ~inproc_transport() {
-    if (gpr_unref(&mu->refs)) {
-      mu->~shared_mu();
-      gpr_free(mu);
-    }
-  }
+  ~inproc_transport() { gpr_mu_destroy(&mu); }
 
   void ref() {
     INPROC_LOG(GPR_INFO, "ref_transport %p", this);
@@ -138,14 +146,18 @@ struct inproc_transport {
   }
 
   grpc_transport base;
-  shared_mu* mu;
+  // Guards the transport's own state: the stream list and connectivity.
+  // Streams are guarded by their stream_mu, which may be held when taking
+  // this but never the other way around.
+  gpr_mu mu;
   gpr_refcount refs;
   bool is_client;
   grpc_core::ConnectivityStateTracker state_tracker;
   void (*accept_stream_cb)(void* user_data, grpc_transport* transport,
                            const void* server_data);
   void* accept_stream_data;
-  bool is_closed = false;
+  // Set under mu; read without it when starting ops on streams.
+  std::atomic<bool> is_closed{false};
   struct inproc_transport* other_side;
   struct inproc_stream* stream_list = nullptr;
 };
@@ -158,16 +170,27 @@ struct inproc_stream {
     ref("inproc_init_stream:init");
     ref("inproc_init_stream:list");
 
+    // The client side creates the call's lock and the server side shares it.
+    // Set it before listing the stream, since closing the transport takes it.
+    inproc_stream* cs = const_cast<inproc_stream*>(
+        static_cast<const inproc_stream*>(server_data));
+    if (cs == nullptr) {
+      mu = new (gpr_malloc(sizeof(*mu))) stream_mu();
+    } else {
+      mu = cs->mu;
+      mu->ref();
+    }
+
     stream_list_prev = nullptr;
-    gpr_mu_lock(&t->mu->mu);
+    gpr_mu_lock(&t->mu);
     stream_list_next = t->stream_list;
     if (t->stream_list) {
       t->stream_list->stream_list_prev = this;
     }
     t->stream_list = this;
-    gpr_mu_unlock(&t->mu->mu);
+    gpr_mu_unlock(&t->mu);
 
-    if (!server_data) {
+    if (cs == nullptr) {
       t->ref();
       inproc_transport* st = t->other_side;
       st->ref();
@@ -180,15 +203,12 @@ struct inproc_stream {
       (*st->accept_stream_cb)(st->accept_stream_data, &st->base, this);
     } else {
       // This is the server-side and is being called through accept_stream_cb
-      inproc_stream* cs = const_cast<inproc_stream*>(
-          static_cast<const inproc_stream*>(server_data));
       other_side = cs;
       // Ref the server-side stream on behalf of the client now
       ref("inproc_init_stream:srv");
 
-      // Now we are about to affect the other side, so lock the transport
-      // to make sure that it doesn't get destroyed
-      gpr_mu_lock(&t->mu->mu);
+      // Now we are about to affect the other side, so take the call's lock
+      gpr_mu_lock(&mu->mu);
       cs->other_side = this;
       // Now transfer from the other side's write_buffer if any to the to_read
       // buffer
@@ -211,11 +231,14 @@ struct inproc_stream {
         maybe_process_ops_locked(this, cancel_other_error);
       }
 
-      gpr_mu_unlock(&t->mu->mu);
+      gpr_mu_unlock(&mu->mu);
     }
   }
 
-  ~inproc_stream() { t->unref(); }
+  ~inproc_stream() {
+    mu->unref();
+    t->unref();
+  }
 
 #ifndef NDEBUG
 #define STREAM_REF(refs, reason) grpc_stream_ref(refs, reason)
@@ -239,6 +262,7 @@ struct inproc_stream {
   inproc_transport* t;
   grpc_stream_refcount* refs;
   grpc_core::Arena* arena;
+  stream_mu* mu;
 
   grpc_metadata_batch to_read_initial_md{arena};
   bool to_read_initial_md_filled = false;
@@ -282,6 +306,7 @@ struct inproc_stream {
 
   grpc_core::Timestamp deadline = grpc_core::Timestamp::InfFuture();
 
+  // Guarded by t->mu rather than by mu.
   bool listed = true;
   struct inproc_stream* stream_list_prev;
   struct inproc_stream* stream_list_next;
@@ -357,7 +382,9 @@ void close_stream_locked(inproc_stream* s) {
     s->write_buffer_initial_md.Clear();
     s->write_buffer_trailing_md.Clear();
 
-    if (s->listed) {
+    gpr_mu_lock(&s->t->mu);
+    bool was_listed = s->listed;
+    if (was_listed) {
       inproc_stream* p = s->stream_list_prev;
       inproc_stream* n = s->stream_list_next;
       if (p != nullptr) {
@@ -369,8 +396,9 @@ void close_stream_locked(inproc_stream* s) {
         n->stream_list_prev = p;
       }
       s->listed = false;
-      s->unref("close_stream:list");
     }
+    gpr_mu_unlock(&s->t->mu);
+    if (was_listed) s->unref("close_stream:list");
     s->closed = true;
     s->unref("close_stream:closing");
   }
@@ -914,7 +942,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                        grpc_transport_stream_op_batch* op) {
   INPROC_LOG(GPR_INFO, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu* mu = &s->t->mu->mu;  // save aside in case s gets closed
+  gpr_mu* mu = &s->mu->mu;  // save aside in case s gets closed
   gpr_mu_lock(mu);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
@@ -960,7 +988,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
 
   inproc_stream* other = s->other_side;
   if (error.ok() && (op->send_initial_metadata || op->send_trailing_metadata)) {
-    if (s->t->is_closed) {
+    if (s->t->is_closed.load(std::memory_order_acquire)) {
       error = GRPC_ERROR_CREATE("Endpoint already shutdown");
     }
     if (error.ok() && op->send_initial_metadata) {
@@ -1089,28 +1117,46 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
   gpr_mu_unlock(mu);
 }
 
-void close_transport_locked(inproc_transport* t) {
-  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed);
+// Must be called with t->mu held.  Returns the streams that the caller must
+// cancel once it has released t->mu, each ref'ed for the purpose.
+std::vector<inproc_stream*> close_transport_locked(inproc_transport* t) {
+  std::vector<inproc_stream*> streams;
+  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed.load());
   t->state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, absl::Status(),
                             "close transport");
-  if (!t->is_closed) {
-    t->is_closed = true;
-    // Also end all streams on this transport
-    while (t->stream_list != nullptr) {
-      // cancel_stream_locked also adjusts stream list
+  if (!t->is_closed.load(std::memory_order_relaxed)) {
+    t->is_closed.store(true, std::memory_order_release);
+    // Also end all streams on this transport.  They can only be locked
+    // without t->mu held, so collect them for the caller.
+    for (inproc_stream* s = t->stream_list; s != nullptr;
+         s = s->stream_list_next) {
+      s->ref("close_transport");
+      streams.push_back(s);
+    }
+  }
+  return streams;
+}
+
+void cancel_closed_transport_streams(
+    const std::vector<inproc_stream*>& streams) {
+  for (inproc_stream* s : streams) {
+    gpr_mu_lock(&s->mu->mu);
+    // The stream may have finished since the transport was closed.
+    if (!s->closed) {
       cancel_stream_locked(
-          t->stream_list,
-          grpc_error_set_int(GRPC_ERROR_CREATE("Transport closed"),
-                             grpc_core::StatusIntProperty::kRpcStatus,
-                             GRPC_STATUS_UNAVAILABLE));
+          s, grpc_error_set_int(GRPC_ERROR_CREATE("Transport closed"),
+                                grpc_core::StatusIntProperty::kRpcStatus,
+                                GRPC_STATUS_UNAVAILABLE));
     }
+    gpr_mu_unlock(&s->mu->mu);
+    s->unref("close_transport");
   }
 }
 
 void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "perform_transport_op %p %p", t, op);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&t->mu);
   if (op->start_connectivity_watch != nullptr) {
     t->state_tracker.AddWatcher(op->start_connectivity_watch_state,
                                 std::move(op->start_connectivity_watch));
@@ -1134,20 +1180,21 @@ void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
     do_close = true;
   }
 
+  std::vector<inproc_stream*> streams_to_cancel;
   if (do_close) {
-    close_transport_locked(t);
+    streams_to_cancel = close_transport_locked(t);
   }
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_unlock(&t->mu);
+  cancel_closed_transport_streams(streams_to_cancel);
 }
 
-void destroy_stream(grpc_transport* gt, grpc_stream* gs,
+void destroy_stream(grpc_transport* /*gt*/, grpc_stream* gs,
                     grpc_closure* then_schedule_closure) {
   INPROC_LOG(GPR_INFO, "destroy_stream %p %p", gs, then_schedule_closure);
-  inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&s->mu->mu);
   close_stream_locked(s);
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_unlock(&s->mu->mu);
   s->~inproc_stream();
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, then_schedule_closure,
                           absl::OkStatus());
@@ -1156,9 +1203,10 @@ void destroy_stream(grpc_transport* gt, grpc_stream* gs,
 void destroy_transport(grpc_transport* gt) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "destroy_transport %p", t);
-  gpr_mu_lock(&t->mu->mu);
-  close_transport_locked(t);
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_lock(&t->mu);
+  std::vector<inproc_stream*> streams_to_cancel = close_transport_locked(t);
+  gpr_mu_unlock(&t->mu);
+  cancel_closed_transport_streams(streams_to_cancel);
   t->other_side->unref();
   t->unref();
 }
@@ -1198,11 +1246,10 @@ const grpc_transport_vtable inproc_vtable = {sizeof(inproc_stream),
 void inproc_transports_create(grpc_transport** server_transport,
                               grpc_transport** client_transport) {
   INPROC_LOG(GPR_INFO, "inproc_transports_create");
-  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
   inproc_transport* st = new (gpr_malloc(sizeof(*st)))
-      inproc_transport(&inproc_vtable, mu, /*is_client=*/false);
+      inproc_transport(&inproc_vtable, /*is_client=*/false);
   inproc_transport* ct = new (gpr_malloc(sizeof(*ct)))
-      inproc_transport(&inproc_vtable, mu, /*is_client=*/true);
+      inproc_transport(&inproc_vtable, /*is_client=*/true);
   st->other_side = ct;
   ct->other_side = st;
   *server_transport = reinterpret_cast<grpc_transport*>(st);
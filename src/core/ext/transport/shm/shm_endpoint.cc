@@ -0,0 +1,733 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_refcount.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS (1024 + 9)
+#define F_GET_SEALS (1024 + 10)
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+// The segment layout is shared with the other process, so both must agree
+// on it; the header records enough of it to catch a mismatch.
+
+// "GRPCSHM1"
+constexpr uint64_t kSegmentMagic = 0x4752504353484d31;
+// Blocks per direction, and their size.  Each write is split into blocks,
+// so a block holds a typical chttp2 write whole.
+constexpr uint32_t kBlockCount = 64;
+constexpr uint32_t kBlockSize = 64 * 1024;
+constexpr size_t kCacheLineSize = 64;
+// The seals every segment carries.  Its size is fixed, so a peer cannot
+// truncate it under the other side's mapping, where reads would fault.
+// Writes stay allowed: both sides write blocks.
+constexpr int kSegmentSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory queues need address free atomics");
+
+// A single producer, single consumer queue of block descriptors: a block's
+// index in the high half and the number of bytes it holds in the low half.
+// It has room for every block of a direction, so it never fills up.
+struct DescriptorQueue {
+  // The next slot the producer fills.
+  alignas(kCacheLineSize) std::atomic<uint64_t> head;
+  // The next slot the consumer takes.
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail;
+  // Set by the consumer before it waits on its wakeup fd, and cleared by
+  // the producer that wakes it.
+  alignas(kCacheLineSize) std::atomic<uint32_t> consumer_waiting;
+  uint64_t slots[kBlockCount];
+};
+
+// One direction of a connection, written by the side with its index.
+struct Direction {
+  // Filled blocks, from the writer to the reader.
+  DescriptorQueue ready;
+  // Blocks the reader is done with, from the reader back to the writer.
+  DescriptorQueue free;
+};
+
+struct SegmentHeader {
+  uint64_t magic;
+  uint32_t block_count;
+  uint32_t block_size;
+  Direction directions[2];
+};
+
+constexpr size_t kBlocksOffset = (sizeof(SegmentHeader) + 4095) / 4096 * 4096;
+constexpr size_t kSegmentSize =
+    kBlocksOffset + 2 * size_t{kBlockCount} * kBlockSize;
+
+uint64_t MakeDescriptor(uint32_t index, uint32_t length) {
+  return (uint64_t{index} << 32) | length;
+}
+
+void Push(DescriptorQueue* queue, uint64_t descriptor) {
+  uint64_t head = queue->head.load(std::memory_order_relaxed);
+  queue->slots[head % kBlockCount] = descriptor;
+  queue->head.store(head + 1, std::memory_order_release);
+}
+
+bool Pop(DescriptorQueue* queue, uint64_t* descriptor) {
+  uint64_t tail = queue->tail.load(std::memory_order_relaxed);
+  if (tail == queue->head.load(std::memory_order_acquire)) return false;
+  *descriptor = queue->slots[tail % kBlockCount];
+  queue->tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+// Called by the consumer of an empty queue before it waits.  Returns false
+// if an entry arrived meanwhile, in which case it should not wait.
+bool PrepareToWait(DescriptorQueue* queue) {
+  queue->consumer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (queue->tail.load(std::memory_order_relaxed) !=
+      queue->head.load(std::memory_order_acquire)) {
+    queue->consumer_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+// Called by the producer after a push.  Returns true if the consumer was
+// waiting, and so must be woken.
+bool TakeConsumerWaiting(DescriptorQueue* queue) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return queue->consumer_waiting.load(std::memory_order_relaxed) != 0 &&
+         queue->consumer_waiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+//
+// Segment
+//
+
+// This process's mapping of a connection's segment.  Outlives the endpoint
+// while slices of it are still referenced.
+class Segment : public RefCounted<Segment> {
+ public:
+  Segment(uint8_t* base, ShmSide side, int peer_wakeup_fd)
+      : base_(base),
+        header_(reinterpret_cast<SegmentHeader*>(base)),
+        side_(static_cast<int>(side)),
+        peer_wakeup_fd_(peer_wakeup_fd) {
+    for (uint32_t i = 0; i < kBlockCount; ++i) {
+      block_refs_[i].segment = this;
+      block_refs_[i].index = i;
+    }
+  }
+
+  ~Segment() override {
+    munmap(base_, kSegmentSize);
+    close(peer_wakeup_fd_);
+  }
+
+  Direction* outgoing() { return &header_->directions[side_]; }
+  Direction* incoming() { return &header_->directions[1 - side_]; }
+
+  uint8_t* OutgoingBlock(uint32_t index) { return Block(side_, index); }
+
+  void WakePeer() {
+    uint64_t one = 1;
+    ssize_t r;
+    do {
+      r = write(peer_wakeup_fd_, &one, sizeof(one));
+    } while (r < 0 && errno == EINTR);
+  }
+
+  // Turns a descriptor taken from the incoming ready queue into a slice.
+  // The slice points into the segment until half the blocks are held that
+  // way; past that its bytes are copied, so that the peer always has blocks
+  // to write into however long the slices are kept.
+  //
+  // The segment stays writable by the peer, which is trusted to leave a
+  // block alone once it is queued.  A misbehaving peer can still change the
+  // bytes of a slice after they are delivered, so parsers must not rely on
+  // reading the same bytes twice.
+  absl::StatusOr<grpc_slice> TakeBlock(uint64_t descriptor) {
+    const uint32_t index = descriptor >> 32;
+    const uint32_t length = static_cast<uint32_t>(descriptor);
+    if (index >= kBlockCount || length == 0 || length > kBlockSize) {
+      return absl::InternalError("Corrupt shared memory block descriptor");
+    }
+    BlockRef& ref = block_refs_[index];
+    if (ref.in_use.exchange(true, std::memory_order_relaxed)) {
+      return absl::InternalError("Shared memory block delivered twice");
+    }
+    uint8_t* data = Block(1 - side_, index);
+    if (held_blocks_.load(std::memory_order_relaxed) >= kBlockCount / 2) {
+      grpc_slice slice = grpc_slice_from_copied_buffer(
+          reinterpret_cast<const char*>(data), length);
+      ReturnBlock(index);
+      return slice;
+    }
+    held_blocks_.fetch_add(1, std::memory_order_relaxed);
+    new (&ref.refcount) grpc_slice_refcount(&Segment::DestroyBlockRef);
+    Ref().release();
+    grpc_slice slice;
+    slice.refcount = &ref.refcount;
+    slice.data.refcounted.bytes = data;
+    slice.data.refcounted.length = length;
+    return slice;
+  }
+
+ private:
+  // The refcount of the slices pointing into an incoming block.
+  struct BlockRef {
+    grpc_slice_refcount refcount;
+    Segment* segment = nullptr;
+    uint32_t index = 0;
+    std::atomic<bool> in_use{false};
+  };
+
+  static void DestroyBlockRef(grpc_slice_refcount* refcount) {
+    BlockRef* ref = reinterpret_cast<BlockRef*>(refcount);
+    Segment* segment = ref->segment;
+    segment->held_blocks_.fetch_sub(1, std::memory_order_relaxed);
+    segment->ReturnBlock(ref->index);
+    segment->Unref();
+  }
+
+  uint8_t* Block(int direction, uint32_t index) {
+    return base_ + kBlocksOffset +
+           (size_t{static_cast<uint32_t>(direction)} * kBlockCount + index) *
+               kBlockSize;
+  }
+
+  // Hands an incoming block back to the peer.  Slices are released from any
+  // thread, so pushes are serialized here.
+  void ReturnBlock(uint32_t index) {
+    DescriptorQueue* free = &incoming()->free;
+    block_refs_[index].in_use.store(false, std::memory_order_relaxed);
+    {
+      MutexLock lock(&return_mu_);
+      Push(free, MakeDescriptor(index, 0));
+    }
+    if (TakeConsumerWaiting(free)) WakePeer();
+  }
+
+  uint8_t* const base_;
+  SegmentHeader* const header_;
+  const int side_;
+  const int peer_wakeup_fd_;
+  Mutex return_mu_;
+  // Incoming blocks currently referenced by slices.
+  std::atomic<uint32_t> held_blocks_{0};
+  BlockRef block_refs_[kBlockCount];
+};
+
+//
+// ShmEndpoint
+//
+
+class ShmEndpoint {
+ public:
+  ShmEndpoint(RefCountedPtr<Segment> segment, grpc_fd* wakeup_fd,
+              grpc_fd* control_fd, std::string peer, std::string local_address)
+      : segment_(std::move(segment)),
+        wakeup_fd_(wakeup_fd),
+        control_fd_(control_fd),
+        peer_(std::move(peer)),
+        local_address_(std::move(local_address)) {
+    base_.vtable = &kVtable;
+    GRPC_CLOSURE_INIT(&on_wakeup_, OnWakeup, this, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_control_readable_, OnControlReadable, this,
+                      grpc_schedule_on_exec_ctx);
+    // Watch for the peer going away for as long as the endpoint lives.
+    refs_.Ref();
+    grpc_fd_notify_on_read(control_fd_, &on_control_readable_);
+  }
+
+  grpc_endpoint* base() { return &base_; }
+
+  static const grpc_endpoint_vtable kVtable;
+
+ private:
+  ~ShmEndpoint() {
+    grpc_fd_orphan(wakeup_fd_, nullptr, nullptr, "shm_endpoint");
+    grpc_fd_orphan(control_fd_, nullptr, nullptr, "shm_endpoint");
+  }
+
+  static ShmEndpoint* FromBase(grpc_endpoint* ep) {
+    return reinterpret_cast<ShmEndpoint*>(ep);
+  }
+
+  void Unref() {
+    if (refs_.Unref()) delete this;
+  }
+
+  void Read(grpc_slice_buffer* slices, grpc_closure* cb);
+  void Write(grpc_slice_buffer* slices, grpc_closure* cb);
+  void Shutdown(grpc_error_handle why);
+
+  // Each returns true once the pending operation is done, with *error set
+  // to its result; otherwise the wakeup fd has been armed to continue it.
+  bool ContinueReadLocked(grpc_error_handle* error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  bool ContinueWriteLocked(grpc_error_handle* error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ArmWakeupLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  static void OnWakeup(void* arg, grpc_error_handle error);
+  static void OnControlReadable(void* arg, grpc_error_handle error);
+
+  // vtable
+  static void EndpointRead(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                           grpc_closure* cb, bool /*urgent*/,
+                           int /*min_progress_size*/) {
+    FromBase(ep)->Read(slices, cb);
+  }
+  static void EndpointWrite(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                            grpc_closure* cb, void* /*arg*/,
+                            int /*max_frame_size*/) {
+    FromBase(ep)->Write(slices, cb);
+  }
+  static void EndpointAddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+    grpc_pollset_add_fd(pollset, FromBase(ep)->wakeup_fd_);
+    grpc_pollset_add_fd(pollset, FromBase(ep)->control_fd_);
+  }
+  static void EndpointAddToPollsetSet(grpc_endpoint* ep,
+                                      grpc_pollset_set* pollset_set) {
+    grpc_pollset_set_add_fd(pollset_set, FromBase(ep)->wakeup_fd_);
+    grpc_pollset_set_add_fd(pollset_set, FromBase(ep)->control_fd_);
+  }
+  static void EndpointDeleteFromPollsetSet(grpc_endpoint* ep,
+                                           grpc_pollset_set* pollset_set) {
+    grpc_pollset_set_del_fd(pollset_set, FromBase(ep)->wakeup_fd_);
+    grpc_pollset_set_del_fd(pollset_set, FromBase(ep)->control_fd_);
+  }
+  static void EndpointShutdown(grpc_endpoint* ep, grpc_error_handle why) {
+    FromBase(ep)->Shutdown(why);
+  }
+  static void EndpointDestroy(grpc_endpoint* ep) {
+    ShmEndpoint* self = FromBase(ep);
+    self->Shutdown(GRPC_ERROR_CREATE("Endpoint destroyed"));
+    self->Unref();
+  }
+  static absl::string_view EndpointGetPeer(grpc_endpoint* ep) {
+    return FromBase(ep)->peer_;
+  }
+  static absl::string_view EndpointGetLocalAddress(grpc_endpoint* ep) {
+    return FromBase(ep)->local_address_;
+  }
+  // There is no one fd carrying the connection's bytes.
+  static int EndpointGetFd(grpc_endpoint* /*ep*/) { return -1; }
+  static bool EndpointCanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  // Must stay the first member: the vtable functions cast from it.
+  grpc_endpoint base_;
+  RefCount refs_;
+  const RefCountedPtr<Segment> segment_;
+  grpc_fd* const wakeup_fd_;
+  grpc_fd* const control_fd_;
+  const std::string peer_;
+  const std::string local_address_;
+  grpc_closure on_wakeup_;
+  grpc_closure on_control_readable_;
+
+  Mutex mu_;
+  grpc_error_handle shutdown_error_ ABSL_GUARDED_BY(mu_);
+  bool wakeup_armed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_slice_buffer* read_buffer_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* read_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* write_buffer_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* write_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+};
+
+const grpc_endpoint_vtable ShmEndpoint::kVtable = {
+    ShmEndpoint::EndpointRead,
+    ShmEndpoint::EndpointWrite,
+    ShmEndpoint::EndpointAddToPollset,
+    ShmEndpoint::EndpointAddToPollsetSet,
+    ShmEndpoint::EndpointDeleteFromPollsetSet,
+    ShmEndpoint::EndpointShutdown,
+    ShmEndpoint::EndpointDestroy,
+    ShmEndpoint::EndpointGetPeer,
+    ShmEndpoint::EndpointGetLocalAddress,
+    ShmEndpoint::EndpointGetFd,
+    ShmEndpoint::EndpointCanTrackErr};
+
+void ShmEndpoint::Read(grpc_slice_buffer* slices, grpc_closure* cb) {
+  grpc_slice_buffer_reset_and_unref(slices);
+  grpc_error_handle error;
+  {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(read_cb_ == nullptr);
+    if (!shutdown_error_.ok()) {
+      error = shutdown_error_;
+    } else {
+      read_buffer_ = slices;
+      if (!ContinueReadLocked(&error)) {
+        read_cb_ = cb;
+        return;
+      }
+      read_buffer_ = nullptr;
+    }
+  }
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+}
+
+bool ShmEndpoint::ContinueReadLocked(grpc_error_handle* error) {
+  DescriptorQueue* ready = &segment_->incoming()->ready;
+  while (true) {
+    uint64_t descriptor;
+    while (Pop(ready, &descriptor)) {
+      absl::StatusOr<grpc_slice> slice = segment_->TakeBlock(descriptor);
+      if (!slice.ok()) {
+        *error = slice.status();
+        return true;
+      }
+      grpc_slice_buffer_add(read_buffer_, *slice);
+    }
+    if (read_buffer_->length > 0) return true;
+    if (PrepareToWait(ready)) {
+      ArmWakeupLocked();
+      return false;
+    }
+  }
+}
+
+void ShmEndpoint::Write(grpc_slice_buffer* slices, grpc_closure* cb) {
+  grpc_error_handle error;
+  {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(write_cb_ == nullptr);
+    if (!shutdown_error_.ok()) {
+      error = shutdown_error_;
+    } else {
+      write_buffer_ = slices;
+      if (!ContinueWriteLocked(&error)) {
+        write_cb_ = cb;
+        return;
+      }
+      write_buffer_ = nullptr;
+    }
+  }
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+}
+
+bool ShmEndpoint::ContinueWriteLocked(grpc_error_handle* error) {
+  Direction* outgoing = segment_->outgoing();
+  while (write_buffer_->length > 0) {
+    uint64_t descriptor;
+    if (!Pop(&outgoing->free, &descriptor)) {
+      if (PrepareToWait(&outgoing->free)) {
+        ArmWakeupLocked();
+        return false;
+      }
+      continue;
+    }
+    const uint32_t index = descriptor >> 32;
+    if (index >= kBlockCount) {
+      *error = absl::InternalError("Corrupt shared memory block descriptor");
+      return true;
+    }
+    const uint32_t length = static_cast<uint32_t>(
+        std::min<size_t>(write_buffer_->length, kBlockSize));
+    grpc_slice_buffer_move_first_into_buffer(write_buffer_, length,
+                                             segment_->OutgoingBlock(index));
+    Push(&outgoing->ready, MakeDescriptor(index, length));
+    if (TakeConsumerWaiting(&outgoing->ready)) segment_->WakePeer();
+  }
+  return true;
+}
+
+void ShmEndpoint::ArmWakeupLocked() {
+  if (wakeup_armed_) return;
+  wakeup_armed_ = true;
+  refs_.Ref();
+  grpc_fd_notify_on_read(wakeup_fd_, &on_wakeup_);
+}
+
+void ShmEndpoint::OnWakeup(void* arg, grpc_error_handle error) {
+  ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+  if (error.ok()) {
+    // Reset the eventfd's counter; whatever woke us is checked below.
+    uint64_t value;
+    ssize_t r;
+    do {
+      r = read(grpc_fd_wrapped_fd(self->wakeup_fd_), &value, sizeof(value));
+    } while (r < 0 && errno == EINTR);
+  }
+  grpc_closure* read_cb = nullptr;
+  grpc_closure* write_cb = nullptr;
+  grpc_error_handle read_error;
+  grpc_error_handle write_error;
+  {
+    MutexLock lock(&self->mu_);
+    self->wakeup_armed_ = false;
+    if (!error.ok() && self->shutdown_error_.ok()) {
+      self->shutdown_error_ = error;
+    }
+    if (self->read_cb_ != nullptr) {
+      if (!self->shutdown_error_.ok()) {
+        read_error = self->shutdown_error_;
+      }
+      if (!read_error.ok() || self->ContinueReadLocked(&read_error)) {
+        read_cb = std::exchange(self->read_cb_, nullptr);
+        self->read_buffer_ = nullptr;
+      }
+    }
+    if (self->write_cb_ != nullptr) {
+      if (!self->shutdown_error_.ok()) {
+        write_error = self->shutdown_error_;
+      }
+      if (!write_error.ok() || self->ContinueWriteLocked(&write_error)) {
+        write_cb = std::exchange(self->write_cb_, nullptr);
+        self->write_buffer_ = nullptr;
+      }
+    }
+  }
+  if (read_cb != nullptr) ExecCtx::Run(DEBUG_LOCATION, read_cb, read_error);
+  if (write_cb != nullptr) ExecCtx::Run(DEBUG_LOCATION, write_cb, write_error);
+  self->Unref();
+}
+
+void ShmEndpoint::OnControlReadable(void* arg, grpc_error_handle error) {
+  ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+  if (error.ok()) {
+    // Nothing is ever sent on the control socket once the connection is up,
+    // so it only becomes readable when the peer goes away.
+    char byte;
+    ssize_t r = recv(grpc_fd_wrapped_fd(self->control_fd_), &byte, 1,
+                     MSG_PEEK | MSG_DONTWAIT);
+    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      grpc_fd_notify_on_read(self->control_fd_, &self->on_control_readable_);
+      return;
+    }
+    if (r == 0) {
+      error = GRPC_ERROR_CREATE("Peer closed");
+    } else if (r < 0) {
+      error = GRPC_OS_ERROR(errno, "recv");
+    } else {
+      error = GRPC_ERROR_CREATE("Unexpected data on shared memory control");
+    }
+    self->Shutdown(grpc_error_set_int(error, StatusIntProperty::kRpcStatus,
+                                      GRPC_STATUS_UNAVAILABLE));
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::Shutdown(grpc_error_handle why) {
+  {
+    MutexLock lock(&mu_);
+    if (!shutdown_error_.ok()) return;
+    if (why.ok()) why = GRPC_ERROR_CREATE("Endpoint shutdown");
+    shutdown_error_ = why;
+  }
+  // Runs any armed callbacks with the error, which fails pending reads and
+  // writes.  Shutting down the control socket tells the peer.
+  grpc_fd_shutdown(wakeup_fd_, why);
+  grpc_fd_shutdown(control_fd_, why);
+}
+
+absl::Status MakeFdCloseOnExecAndNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+    return GRPC_OS_ERROR(errno, "fcntl");
+  }
+  flags = fcntl(fd, F_GETFD, 0);
+  if (flags < 0 || fcntl(fd, F_SETFD, flags | FD_CLOEXEC) != 0) {
+    return GRPC_OS_ERROR(errno, "fcntl");
+  }
+  return absl::OkStatus();
+}
+
+// Maps a segment made by CreateShmConnection(), possibly in another
+// process, checking that it is sealed and laid out as this process expects.
+absl::StatusOr<uint8_t*> MapSegment(int memfd) {
+  const int seals = fcntl(memfd, F_GET_SEALS);
+  if (seals < 0) return GRPC_OS_ERROR(errno, "fcntl");
+  if ((seals & kSegmentSeals) != kSegmentSeals) {
+    return absl::InternalError("Shared memory segment is not sealed");
+  }
+  struct stat st;
+  if (fstat(memfd, &st) != 0) return GRPC_OS_ERROR(errno, "fstat");
+  if (static_cast<size_t>(st.st_size) < kSegmentSize) {
+    return absl::InternalError("Shared memory segment too small");
+  }
+  void* base = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    memfd, 0);
+  if (base == MAP_FAILED) return GRPC_OS_ERROR(errno, "mmap");
+  const SegmentHeader* header = static_cast<const SegmentHeader*>(base);
+  if (header->magic != kSegmentMagic || header->block_count != kBlockCount ||
+      header->block_size != kBlockSize) {
+    munmap(base, kSegmentSize);
+    return absl::InternalError("Incompatible shared memory segment");
+  }
+  return static_cast<uint8_t*>(base);
+}
+
+}  // namespace
+
+absl::StatusOr<ShmConnectionFds> CreateShmConnection() {
+  ShmConnectionFds fds;
+  fds.memfd =
+      syscall(SYS_memfd_create, "grpc-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fds.memfd < 0) return GRPC_OS_ERROR(errno, "memfd_create");
+  absl::Status status;
+  if (ftruncate(fds.memfd, kSegmentSize) != 0) {
+    status = GRPC_OS_ERROR(errno, "ftruncate");
+  } else {
+    void* base = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fds.memfd, 0);
+    if (base == MAP_FAILED) {
+      status = GRPC_OS_ERROR(errno, "mmap");
+    } else {
+      // The segment starts zeroed.  Every block starts out free.
+      SegmentHeader* header = static_cast<SegmentHeader*>(base);
+      header->magic = kSegmentMagic;
+      header->block_count = kBlockCount;
+      header->block_size = kBlockSize;
+      for (Direction& direction : header->directions) {
+        for (uint32_t i = 0; i < kBlockCount; ++i) {
+          Push(&direction.free, MakeDescriptor(i, 0));
+        }
+      }
+      munmap(base, kSegmentSize);
+      if (fcntl(fds.memfd, F_ADD_SEALS, kSegmentSeals) != 0) {
+        status = GRPC_OS_ERROR(errno, "fcntl");
+      }
+    }
+  }
+  for (int i = 0; i < 2 && status.ok(); ++i) {
+    fds.wakeup_fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fds.wakeup_fds[i] < 0) status = GRPC_OS_ERROR(errno, "eventfd");
+  }
+  if (!status.ok()) {
+    CloseShmConnectionFds(fds);
+    return status;
+  }
+  return fds;
+}
+
+void CloseShmConnectionFds(const ShmConnectionFds& fds) {
+  if (fds.memfd >= 0) close(fds.memfd);
+  for (int fd : fds.wakeup_fds) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+absl::StatusOr<grpc_endpoint*> CreateShmEndpoint(ShmSide side,
+                                                 ShmConnectionFds fds,
+                                                 grpc_fd* control,
+                                                 std::string peer,
+                                                 std::string local_address) {
+  const int own = static_cast<int>(side);
+  absl::StatusOr<uint8_t*> base = MapSegment(fds.memfd);
+  close(fds.memfd);
+  absl::Status status = base.status();
+  for (int fd : fds.wakeup_fds) {
+    if (status.ok()) status = MakeFdCloseOnExecAndNonBlocking(fd);
+  }
+  if (!status.ok()) {
+    if (base.ok()) munmap(*base, kSegmentSize);
+    close(fds.wakeup_fds[0]);
+    close(fds.wakeup_fds[1]);
+    grpc_fd_orphan(control, nullptr, nullptr, "shm_endpoint_failed");
+    return status;
+  }
+  auto segment =
+      MakeRefCounted<Segment>(*base, side, fds.wakeup_fds[1 - own]);
+  grpc_fd* wakeup_fd = grpc_fd_create(
+      fds.wakeup_fds[own], absl::StrCat("shm-wakeup:", peer).c_str(), false);
+  auto* endpoint =
+      new ShmEndpoint(std::move(segment), wakeup_fd, control, std::move(peer),
+                      std::move(local_address));
+  return endpoint->base();
+}
+
+grpc_endpoint_pair CreateShmEndpointPair(const char* name) {
+  ExecCtx exec_ctx;
+  auto fds = CreateShmConnection();
+  GPR_ASSERT(fds.ok());
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  GPR_ASSERT(MakeFdCloseOnExecAndNonBlocking(sv[0]).ok());
+  GPR_ASSERT(MakeFdCloseOnExecAndNonBlocking(sv[1]).ok());
+  ShmConnectionFds server_fds;
+  server_fds.memfd = dup(fds->memfd);
+  server_fds.wakeup_fds[0] = dup(fds->wakeup_fds[0]);
+  server_fds.wakeup_fds[1] = dup(fds->wakeup_fds[1]);
+  std::string client_name = absl::StrCat("shm:", name, ":client");
+  std::string server_name = absl::StrCat("shm:", name, ":server");
+  grpc_endpoint_pair p;
+  auto client = CreateShmEndpoint(
+      ShmSide::kClient, *fds,
+      grpc_fd_create(sv[0], client_name.c_str(), false), server_name,
+      client_name);
+  auto server = CreateShmEndpoint(
+      ShmSide::kServer, server_fds,
+      grpc_fd_create(sv[1], server_name.c_str(), false), client_name,
+      server_name);
+  GPR_ASSERT(client.ok() && server.ok());
+  p.client = *client;
+  p.server = *server;
+  return p;
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
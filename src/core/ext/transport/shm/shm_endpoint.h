@@ -0,0 +1,80 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <string>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include "src/core/lib/iomgr/ev_posix.h"
+
+namespace grpc_core {
+
+// An endpoint between two processes on the same host, carrying bytes through
+// a shared memory segment instead of the kernel.
+//
+// The segment holds a pool of fixed size blocks for each direction.  The
+// writer copies outgoing bytes into free blocks and queues them to the
+// reader, which hands them up as slices pointing into the segment; a block
+// goes back to the writer once its slices are unreferenced.  Each side has
+// an eventfd that the other signals when it has filled or freed a block the
+// side is waiting for.  A unix socket between the processes, the one the
+// segment was handed over on, tells each side when the other goes away.
+
+// The file descriptors shared by both sides of a connection.
+struct ShmConnectionFds {
+  int memfd = -1;
+  // Indexed by side; each side waits on its own and signals the other.
+  int wakeup_fds[2] = {-1, -1};
+};
+
+// The side of a connection an endpoint is on.  The client creates the
+// connection and hands its fds to the server.
+enum class ShmSide { kClient = 0, kServer = 1 };
+
+// Creates a new, empty shared memory connection.  Its segment is sealed at
+// its size, and CreateShmEndpoint() refuses segments that are not.
+absl::StatusOr<ShmConnectionFds> CreateShmConnection();
+
+// Closes every fd in fds.
+void CloseShmConnectionFds(const ShmConnectionFds& fds);
+
+// Creates one side of the connection described by fds, taking ownership of
+// fds and of control, the socket to the other side.  peer and local_address
+// are reported by the endpoint as its addresses.
+absl::StatusOr<grpc_endpoint*> CreateShmEndpoint(ShmSide side,
+                                                 ShmConnectionFds fds,
+                                                 grpc_fd* control,
+                                                 std::string peer,
+                                                 std::string local_address);
+
+// Creates both sides of a connection within this process, for tests and
+// benchmarks.
+grpc_endpoint_pair CreateShmEndpointPair(const char* name);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
@@ -0,0 +1,366 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_handshaker.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/iomgr/tcp_server.h"
+#include "src/core/lib/transport/handshaker.h"
+#include "src/core/lib/transport/handshaker_factory.h"
+#include "src/core/lib/transport/handshaker_registry.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The client's only message on the unix socket: this, with the connection's
+// memfd and eventfds attached.  Nothing else is ever sent on it.
+constexpr char kHandshakeMagic[8] = {'G', 'R', 'P', 'C', 'S', 'H', 'M', '1'};
+constexpr size_t kHandshakeFdCount = 3;
+
+union ControlBuffer {
+  struct cmsghdr align;
+  char buf[CMSG_SPACE(kHandshakeFdCount * sizeof(int))];
+};
+
+absl::Status SendShmConnection(int socket, const ShmConnectionFds& fds) {
+  char payload[sizeof(kHandshakeMagic)];
+  memcpy(payload, kHandshakeMagic, sizeof(payload));
+  struct iovec iov = {payload, sizeof(payload)};
+  ControlBuffer control;
+  memset(&control, 0, sizeof(control));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(kHandshakeFdCount * sizeof(int));
+  const int sent[kHandshakeFdCount] = {fds.memfd, fds.wakeup_fds[0],
+                                       fds.wakeup_fds[1]};
+  memcpy(CMSG_DATA(cmsg), sent, sizeof(sent));
+  ssize_t r;
+  do {
+    r = sendmsg(socket, &msg, MSG_NOSIGNAL);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) return GRPC_OS_ERROR(errno, "sendmsg");
+  if (static_cast<size_t>(r) != sizeof(payload)) {
+    return absl::InternalError("Short write of shared memory handshake");
+  }
+  return absl::OkStatus();
+}
+
+// Returns nullopt if the client's message has not arrived yet.
+absl::StatusOr<absl::optional<ShmConnectionFds>> ReceiveShmConnection(
+    int socket) {
+  char payload[sizeof(kHandshakeMagic)];
+  struct iovec iov = {payload, sizeof(payload)};
+  ControlBuffer control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t r;
+  do {
+    r = recvmsg(socket, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return absl::nullopt;
+    return GRPC_OS_ERROR(errno, "recvmsg");
+  }
+  std::vector<int> received;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count; ++i) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(fd));
+      received.push_back(fd);
+    }
+  }
+  if (r == 0 || static_cast<size_t>(r) != sizeof(payload) ||
+      memcmp(payload, kHandshakeMagic, sizeof(payload)) != 0 ||
+      received.size() != kHandshakeFdCount ||
+      (msg.msg_flags & MSG_CTRUNC) != 0) {
+    for (int fd : received) close(fd);
+    return absl::UnavailableError(
+        r == 0 ? "Peer closed during shared memory handshake"
+               : "Malformed shared memory handshake");
+  }
+  ShmConnectionFds fds;
+  fds.memfd = received[0];
+  fds.wakeup_fds[0] = received[1];
+  fds.wakeup_fds[1] = received[2];
+  return fds;
+}
+
+// Takes over the unix socket of a fresh connection and replaces the endpoint
+// with a shared memory one.  The client creates the connection and sends it
+// over the socket; the server waits for it.  From then on the socket only
+// tells each side when the other has gone.
+class ShmHandshaker : public Handshaker {
+ public:
+  ShmHandshaker(bool is_client, grpc_pollset_set* interested_parties)
+      : is_client_(is_client), interested_parties_(interested_parties) {}
+
+  void Shutdown(grpc_error_handle why) override;
+  void DoHandshake(grpc_tcp_server_acceptor* acceptor,
+                   grpc_closure* on_handshake_done,
+                   HandshakerArgs* args) override;
+  const char* name() const override { return "shm"; }
+
+ private:
+  static void OnFdReleased(void* arg, grpc_error_handle error);
+  static void OnSocketReadable(void* arg, grpc_error_handle error);
+
+  // Hands the result to the handshake manager.  The caller must drop the
+  // handshake's ref afterwards, outside the lock.
+  void FinishLocked(absl::StatusOr<grpc_endpoint*> endpoint)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const bool is_client_;
+  grpc_pollset_set* const interested_parties_;
+
+  Mutex mu_;
+  bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  bool finished_ ABSL_GUARDED_BY(mu_) = false;
+  HandshakerArgs* args_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* on_handshake_done_ ABSL_GUARDED_BY(mu_) = nullptr;
+  std::string peer_ ABSL_GUARDED_BY(mu_);
+  std::string local_address_ ABSL_GUARDED_BY(mu_);
+  // The unix socket, once released by the original endpoint.
+  int fd_ = -1;
+  // The unix socket while the server waits for the client's message.
+  grpc_fd* socket_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure on_fd_released_;
+  grpc_closure on_socket_readable_;
+};
+
+void ShmHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                                grpc_closure* on_handshake_done,
+                                HandshakerArgs* args) {
+  grpc_endpoint* endpoint;
+  {
+    MutexLock lock(&mu_);
+    args_ = args;
+    on_handshake_done_ = on_handshake_done;
+    // Held until the handshake finishes.
+    Ref().release();
+    if (grpc_endpoint_get_fd(args->endpoint) < 0 ||
+        args->read_buffer->length > 0) {
+      FinishLocked(absl::InternalError(
+          "Shared memory needs a fresh unix socket connection"));
+      endpoint = nullptr;
+    } else {
+      peer_ = std::string(grpc_endpoint_get_peer(args->endpoint));
+      local_address_ =
+          std::string(grpc_endpoint_get_local_address(args->endpoint));
+      endpoint = std::exchange(args->endpoint, nullptr);
+    }
+  }
+  if (endpoint == nullptr) {
+    Unref();
+    return;
+  }
+  grpc_tcp_destroy_and_release_fd(
+      endpoint, &fd_,
+      GRPC_CLOSURE_INIT(&on_fd_released_, &ShmHandshaker::OnFdReleased, this,
+                        grpc_schedule_on_exec_ctx));
+}
+
+void ShmHandshaker::OnFdReleased(void* arg, grpc_error_handle error) {
+  auto* self = static_cast<ShmHandshaker*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    if (error.ok() && self->is_shutdown_) {
+      error = GRPC_ERROR_CREATE("Handshaker shutdown");
+    }
+    if (!error.ok()) {
+      if (self->fd_ >= 0) close(self->fd_);
+      self->FinishLocked(error);
+    } else if (self->is_client_) {
+      auto fds = CreateShmConnection();
+      absl::Status status = fds.status();
+      if (status.ok()) {
+        status = SendShmConnection(self->fd_, *fds);
+        if (!status.ok()) CloseShmConnectionFds(*fds);
+      }
+      if (!status.ok()) {
+        close(self->fd_);
+        self->FinishLocked(status);
+      } else {
+        self->FinishLocked(CreateShmEndpoint(
+            ShmSide::kClient, *fds,
+            grpc_fd_create(self->fd_, "shm-control", false), self->peer_,
+            self->local_address_));
+      }
+    } else {
+      self->socket_ = grpc_fd_create(self->fd_, "shm-control", false);
+      grpc_pollset_set_add_fd(self->interested_parties_, self->socket_);
+      grpc_fd_notify_on_read(
+          self->socket_,
+          GRPC_CLOSURE_INIT(&self->on_socket_readable_,
+                            &ShmHandshaker::OnSocketReadable, self,
+                            grpc_schedule_on_exec_ctx));
+      return;
+    }
+  }
+  self->Unref();
+}
+
+void ShmHandshaker::OnSocketReadable(void* arg, grpc_error_handle error) {
+  auto* self = static_cast<ShmHandshaker*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    if (error.ok() && self->is_shutdown_) {
+      error = GRPC_ERROR_CREATE("Handshaker shutdown");
+    }
+    absl::StatusOr<absl::optional<ShmConnectionFds>> fds = error;
+    if (error.ok()) {
+      fds = ReceiveShmConnection(grpc_fd_wrapped_fd(self->socket_));
+      if (fds.ok() && !fds->has_value()) {
+        grpc_fd_notify_on_read(self->socket_, &self->on_socket_readable_);
+        return;
+      }
+    }
+    grpc_pollset_set_del_fd(self->interested_parties_, self->socket_);
+    grpc_fd* socket = std::exchange(self->socket_, nullptr);
+    if (!fds.ok()) {
+      grpc_fd_orphan(socket, nullptr, nullptr, "shm_handshake_failed");
+      self->FinishLocked(fds.status());
+    } else {
+      self->FinishLocked(CreateShmEndpoint(ShmSide::kServer, **fds, socket,
+                                           self->peer_,
+                                           self->local_address_));
+    }
+  }
+  self->Unref();
+}
+
+void ShmHandshaker::FinishLocked(absl::StatusOr<grpc_endpoint*> endpoint) {
+  finished_ = true;
+  grpc_error_handle error;
+  if (endpoint.ok()) {
+    args_->endpoint = *endpoint;
+  } else {
+    error = endpoint.status();
+    if (args_->endpoint != nullptr) {
+      grpc_endpoint_shutdown(args_->endpoint, error);
+      grpc_endpoint_destroy(args_->endpoint);
+      args_->endpoint = nullptr;
+    }
+    grpc_slice_buffer_destroy(args_->read_buffer);
+    gpr_free(args_->read_buffer);
+    args_->read_buffer = nullptr;
+    args_->args = ChannelArgs();
+  }
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, error);
+}
+
+void ShmHandshaker::Shutdown(grpc_error_handle why) {
+  MutexLock lock(&mu_);
+  if (is_shutdown_ || finished_) return;
+  is_shutdown_ = true;
+  // Fails the wait for the client's message, if that is where we are;
+  // otherwise the release of the socket notices the shutdown.
+  if (socket_ != nullptr) grpc_fd_shutdown(socket_, why);
+}
+
+class ShmHandshakerFactory : public HandshakerFactory {
+ public:
+  explicit ShmHandshakerFactory(bool is_client) : is_client_(is_client) {}
+
+  void AddHandshakers(const ChannelArgs& args,
+                      grpc_pollset_set* interested_parties,
+                      HandshakeManager* handshake_mgr) override {
+    if (!args.GetBool(GRPC_ARG_SHM_TRANSPORT).value_or(false)) return;
+    handshake_mgr->Add(
+        MakeRefCounted<ShmHandshaker>(is_client_, interested_parties));
+  }
+  // Runs once connected, before any security handshake, so that those run
+  // over shared memory too.
+  HandshakerPriority Priority() override {
+    return HandshakerPriority::kReadAheadSecurityHandshakers;
+  }
+  ~ShmHandshakerFactory() override = default;
+
+ private:
+  const bool is_client_;
+};
+
+}  // namespace
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder) {
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      HANDSHAKER_CLIENT, std::make_unique<ShmHandshakerFactory>(true));
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      HANDSHAKER_SERVER, std::make_unique<ShmHandshakerFactory>(false));
+}
+
+}  // namespace grpc_core
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+namespace grpc_core {
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* /*builder*/) {}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
@@ -0,0 +1,39 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/config/core_configuration.h"
+
+/// Channel arg (bool) marking a unix socket connection that should carry its
+/// bytes through shared memory instead.  Set on addresses resolved from
+/// "shm:" targets, and on servers listening on "shm:" addresses.
+#define GRPC_ARG_SHM_TRANSPORT "grpc.internal.shm_transport"
+
+/// URI scheme for shared memory connections.  The path is that of the unix
+/// socket the connection is set up over.
+#define GRPC_SHM_URI_SCHEME "shm"
+
+namespace grpc_core {
+
+// Registers the client and server handshakers that move a unix socket
+// connection onto shared memory.  Does nothing on platforms without it.
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
@@ -21,9 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
 
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -46,12 +52,18 @@ class ChannelzRegistry {
 
   // Returns the allocated JSON string that represents the proto
   // GetTopChannelsResponse as per channelz.proto.
+  //
+  // Pages are consistent only for nodes registered before the first one is
+  // requested: each of those still registered is returned once, in uuid
+  // order.  A node registered while the pages are read may be missed by all
+  // of them, because its uuid is allocated before it is added to its shard,
+  // so a page can end past it before it appears.
   static std::string GetTopChannels(intptr_t start_channel_id) {
     return Default()->InternalGetTopChannels(start_channel_id);
   }
 
   // Returns the allocated JSON string that represents the proto
-  // GetServersResponse as per channelz.proto.
+  // GetServersResponse as per channelz.proto.  Paginated as GetTopChannels().
   static std::string GetServers(intptr_t start_server_id) {
     return Default()->InternalGetServers(start_server_id);
   }
@@ -63,12 +75,37 @@ class ChannelzRegistry {
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (Shard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
+  // Nodes are spread across shards by uuid, so that registering and
+  // unregistering them, which happens for every connection, only contends
+  // with other nodes in the same shard.
+  static constexpr size_t kNumShards = 16;
+
+  // Shards locked by different threads must not share a cacheline.  The
+  // registry is heap allocated, and only C++17 aligns heap allocations to
+  // more than max_align_t, so earlier versions pad instead.
+#if __cplusplus >= 201703L
+  struct alignas(GPR_CACHELINE_SIZE) Shard {
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+  };
+#else
+  struct ShardHeader {
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+  };
+  struct Shard : public ShardHeader {
+    uint8_t padding[GPR_CACHELINE_SIZE - sizeof(ShardHeader)];
+  };
+#endif
+
   // Returned the singleton instance of ChannelzRegistry;
   static ChannelzRegistry* Default();
 
@@ -86,12 +123,19 @@ class ChannelzRegistry {
   std::string InternalGetTopChannels(intptr_t start_channel_id);
   std::string InternalGetServers(intptr_t start_server_id);
 
+  // Returns refs to the first max_results nodes of type type with uuids of at
+  // least start_id, in uuid order.  Each shard is read under its own lock, so
+  // the result is a consistent snapshot of every shard, though not
+  // necessarily of all shards at the same instant.
+  std::vector<RefCountedPtr<BaseNode>> InternalGetNodes(
+      BaseNode::EntityType type, intptr_t start_id, size_t max_results);
+
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  Shard& ShardFor(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  std::atomic<intptr_t> uuid_generator_{0};
+  Shard shards_[kNumShards];
 };
 
 }  // namespace channelz
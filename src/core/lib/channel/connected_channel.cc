@@ -887,8 +887,9 @@ grpc_channel_filter MakeConnectedFilter() {
 }
 
 ArenaPromise<ServerMetadataHandle> MakeTransportCallPromise(
-    grpc_transport* transport, CallArgs call_args, NextPromiseFactory) {
-  return transport->vtable->make_call_promise(transport, std::move(call_args));
+    grpc_transport* transport, CallArgs call_args, NextPromiseFactory next) {
+  return transport->vtable->make_call_promise(transport, std::move(call_args),
+                                              std::move(next));
 }
 
 const grpc_channel_filter kPromiseBasedTransportFilter =
@@ -24,6 +24,9 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_split.h"
 
@@ -38,6 +41,11 @@
 
 namespace grpc_core {
 
+namespace {
+// Prefix of the grpc-accept-encoding token advertising a deflate dictionary.
+constexpr absl::string_view kDeflateDictionaryPrefix = "deflate-dict-";
+}  // namespace
+
 const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
@@ -205,17 +213,27 @@ absl::string_view CompressionAlgorithmSet::ToString() const {
 }
 
 Slice CompressionAlgorithmSet::ToSlice() const {
-  return Slice::FromStaticString(ToString());
+  if (!deflate_dictionary_id_.has_value()) {
+    return Slice::FromStaticString(ToString());
+  }
+  return Slice::FromCopiedString(
+      absl::StrCat(ToString(), ",", kDeflateDictionaryPrefix,
+                   absl::Hex(*deflate_dictionary_id_, absl::kZeroPad8)));
 }
 
 CompressionAlgorithmSet CompressionAlgorithmSet::FromString(
     absl::string_view str) {
   CompressionAlgorithmSet set{GRPC_COMPRESS_NONE};
   for (auto algorithm : absl::StrSplit(str, ',')) {
-    auto parsed =
-        ParseCompressionAlgorithm(absl::StripAsciiWhitespace(algorithm));
+    algorithm = absl::StripAsciiWhitespace(algorithm);
+    auto parsed = ParseCompressionAlgorithm(algorithm);
     if (parsed.has_value()) {
       set.Set(*parsed);
+    } else if (absl::ConsumePrefix(&algorithm, kDeflateDictionaryPrefix)) {
+      uint32_t id;
+      if (algorithm.size() == 8 && absl::SimpleHexAtoi(algorithm, &id)) {
+        set.SetDeflateDictionaryId(id);
+      }
     }
   }
   return set;
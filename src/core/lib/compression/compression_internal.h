@@ -73,19 +73,30 @@ class CompressionAlgorithmSet {
   // Add algorithm to this set.
   void Set(grpc_compression_algorithm algorithm);
 
+  // The id (the zlib DICTID, ie. the adler32 of the dictionary) of a preset
+  // deflate dictionary that is accepted along with these algorithms, if any.
+  absl::optional<uint32_t> deflate_dictionary_id() const {
+    return deflate_dictionary_id_;
+  }
+  void SetDeflateDictionaryId(uint32_t id) { deflate_dictionary_id_ = id; }
+
   // Return a comma separated string of the algorithms in this set.
   absl::string_view ToString() const;
+  // As ToString(), plus a "deflate-dict-<id>" token if a dictionary is set.
+  // Peers that don't know about dictionaries ignore the extra token.
   Slice ToSlice() const;
 
   // Return a bitmask of the algorithms in this set.
   uint32_t ToLegacyBitmask() const;
 
   bool operator==(const CompressionAlgorithmSet& other) const {
-    return set_ == other.set_;
+    return set_ == other.set_ &&
+           deflate_dictionary_id_ == other.deflate_dictionary_id_;
   }
 
  private:
   BitSet<GRPC_COMPRESS_ALGORITHMS_COUNT> set_;
+  absl::optional<uint32_t> deflate_dictionary_id_;
 };
 
 }  // namespace grpc_core
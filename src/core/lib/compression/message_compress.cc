@@ -20,26 +20,48 @@
 
 #include "src/core/lib/compression/message_compress.h"
 
+#include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <zconf.h>
 #include <zlib.h>
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
+// Output blocks grow geometrically up to this size, so that large messages do
+// not end up spread over thousands of small slices.
+#define MAX_OUTPUT_BLOCK_SIZE (64 * 1024)
+// Largest output block we'll allocate up front from a size found in the input.
+#define MAX_PRESIZED_BLOCK_SIZE (4 * 1024 * 1024)
 
+// Run 'flate' over all of 'input', appending the result to 'output'.
+// The first output block is first_block_size bytes (at least
+// OUTPUT_BLOCK_SIZE). The last input slice is passed with last_flush:
+// Z_FINISH to end the stream, or Z_SYNC_FLUSH (deflate only) to leave it open
+// at a byte boundary.
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
-                     int (*flate)(z_stream* zs, int flush)) {
+                     int (*flate)(z_stream* zs, int flush),
+                     size_t first_block_size = OUTPUT_BLOCK_SIZE,
+                     int last_flush = Z_FINISH) {
   int r = Z_STREAM_END;  // Do not fail on an empty input.
   int flush;
   size_t i;
-  grpc_slice outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+  size_t block_size = first_block_size;
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(block_size);
   const uInt uint_max = ~uInt{0};
 
   GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
@@ -47,14 +69,15 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
   zs->next_out = GRPC_SLICE_START_PTR(outbuf);
   flush = Z_NO_FLUSH;
   for (i = 0; i < input->count; i++) {
-    if (i == input->count - 1) flush = Z_FINISH;
+    if (i == input->count - 1) flush = last_flush;
     GPR_ASSERT(GRPC_SLICE_LENGTH(input->slices[i]) <= uint_max);
     zs->avail_in = static_cast<uInt> GRPC_SLICE_LENGTH(input->slices[i]);
     zs->next_in = GRPC_SLICE_START_PTR(input->slices[i]);
     do {
       if (zs->avail_out == 0) {
         grpc_slice_buffer_add_indexed(output, outbuf);
-        outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+        block_size = std::min<size_t>(2 * block_size, MAX_OUTPUT_BLOCK_SIZE);
+        outbuf = GRPC_SLICE_MALLOC(block_size);
         GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
         zs->avail_out = static_cast<uInt> GRPC_SLICE_LENGTH(outbuf);
         zs->next_out = GRPC_SLICE_START_PTR(outbuf);
@@ -70,7 +93,7 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
       goto error;
     }
   }
-  if (r != Z_STREAM_END) {
+  if (last_flush == Z_FINISH && r != Z_STREAM_END) {
     gpr_log(GPR_INFO, "zlib: Data error");
     goto error;
   }
@@ -93,8 +116,204 @@ static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
 
 static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
 
+namespace {
+
+// Compresses a large input as independent chunks, concurrently.
+// Each chunk is deflated into raw deflate blocks, ending with a sync flush
+// (all chunks but the last) or the final block (the last chunk). Their
+// concatenation is a single valid deflate stream, which gets the usual zlib
+// or gzip header and a trailer with the chunk checksums combined.
+class ParallelDeflate {
+ public:
+  ParallelDeflate(grpc_slice_buffer* input, size_t chunk_size, int level,
+                  bool gzip);
+
+  size_t num_chunks() const { return chunks_.size(); }
+
+  // Compress chunks until there are none left to start.
+  void CompressChunks();
+  // Block until all chunks have been compressed.
+  void WaitForChunks();
+  // Append the full compressed stream to output.
+  // Returns false (leaving output unchanged) if compression failed or did not
+  // make the input smaller.
+  bool Finish(grpc_slice_buffer* output);
+
+ private:
+  struct Chunk {
+    grpc_core::SliceBuffer input;
+    grpc_core::SliceBuffer output;
+    // adler32 (zlib) or crc32 (gzip) of input.
+    uLong check = 0;
+    size_t input_length = 0;
+    bool ok = false;
+  };
+
+  void CompressChunk(Chunk* chunk, bool last);
+
+  const int level_;
+  const bool gzip_;
+  const size_t input_length_;
+  std::vector<Chunk> chunks_;
+  std::atomic<size_t> next_chunk_{0};
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  size_t chunks_done_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+ParallelDeflate::ParallelDeflate(grpc_slice_buffer* input, size_t chunk_size,
+                                 int level, bool gzip)
+    : level_(level),
+      gzip_(gzip),
+      input_length_(input->length),
+      // The last chunk absorbs the remainder, so it's between chunk_size and
+      // 2 * chunk_size long.
+      chunks_(std::max<size_t>(1, input->length / chunk_size)) {
+  size_t slice_index = 0;
+  size_t offset = 0;
+  for (size_t c = 0; c < chunks_.size(); c++) {
+    Chunk& chunk = chunks_[c];
+    chunk.input_length = c + 1 == chunks_.size()
+                             ? input->length - c * chunk_size
+                             : chunk_size;
+    size_t want = chunk.input_length;
+    while (want > 0) {
+      const grpc_slice& slice = input->slices[slice_index];
+      const size_t take = std::min(want, GRPC_SLICE_LENGTH(slice) - offset);
+      if (take > 0) {
+        chunk.input.Append(
+            grpc_core::Slice(grpc_slice_sub(slice, offset, offset + take)));
+      }
+      offset += take;
+      want -= take;
+      if (offset == GRPC_SLICE_LENGTH(slice)) {
+        ++slice_index;
+        offset = 0;
+      }
+    }
+  }
+}
+
+void ParallelDeflate::CompressChunks() {
+  size_t compressed = 0;
+  for (size_t i = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+       i < chunks_.size();
+       i = next_chunk_.fetch_add(1, std::memory_order_relaxed)) {
+    CompressChunk(&chunks_[i], i + 1 == chunks_.size());
+    ++compressed;
+  }
+  if (compressed == 0) return;
+  grpc_core::MutexLock lock(&mu_);
+  chunks_done_ += compressed;
+  if (chunks_done_ == chunks_.size()) cv_.SignalAll();
+}
+
+void ParallelDeflate::WaitForChunks() {
+  grpc_core::MutexLock lock(&mu_);
+  while (chunks_done_ != chunks_.size()) cv_.Wait(&mu_);
+}
+
+void ParallelDeflate::CompressChunk(Chunk* chunk, bool last) {
+  grpc_slice_buffer* input = chunk->input.c_slice_buffer();
+  chunk->check = gzip_ ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+  for (size_t i = 0; i < input->count; i++) {
+    const uInt len = static_cast<uInt>(GRPC_SLICE_LENGTH(input->slices[i]));
+    const Bytef* data = GRPC_SLICE_START_PTR(input->slices[i]);
+    chunk->check = gzip_ ? crc32(chunk->check, data, len)
+                         : adler32(chunk->check, data, len);
+  }
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+  zs.zalloc = zalloc_gpr;
+  zs.zfree = zfree_gpr;
+  int r = deflateInit2(&zs, level_, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  GPR_ASSERT(r == Z_OK);
+  chunk->ok = zlib_body(&zs, input, chunk->output.c_slice_buffer(), deflate,
+                        OUTPUT_BLOCK_SIZE, last ? Z_FINISH : Z_SYNC_FLUSH);
+  deflateEnd(&zs);
+  chunk->input.Clear();
+}
+
+bool ParallelDeflate::Finish(grpc_slice_buffer* output) {
+  const int level = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  grpc_core::SliceBuffer out;
+  uLong check = 0;
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    if (!chunks_[i].ok) return false;
+    if (i == 0) {
+      check = chunks_[i].check;
+    } else if (gzip_) {
+      check = crc32_combine(check, chunks_[i].check,
+                            static_cast<z_off_t>(chunks_[i].input_length));
+    } else {
+      check = adler32_combine(check, chunks_[i].check,
+                              static_cast<z_off_t>(chunks_[i].input_length));
+    }
+  }
+  // Headers and trailers as written by deflate() itself (RFC 1950, RFC 1952).
+  if (gzip_) {
+    const uint8_t header[10] = {
+        0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0,
+        static_cast<uint8_t>(level == 9 ? 2 : (level < 2 ? 4 : 0)), 0xff};
+    out.Append(grpc_core::Slice::FromCopiedBuffer(header, sizeof(header)));
+  } else {
+    const int level_flags = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    uint32_t header = (Z_DEFLATED + (7 << 4)) << 8 | level_flags << 6;
+    header += 31 - header % 31;
+    const uint8_t header_bytes[2] = {static_cast<uint8_t>(header >> 8),
+                                     static_cast<uint8_t>(header)};
+    out.Append(grpc_core::Slice::FromCopiedBuffer(header_bytes,
+                                                  sizeof(header_bytes)));
+  }
+  for (Chunk& chunk : chunks_) {
+    grpc_slice_buffer_move_into(chunk.output.c_slice_buffer(),
+                                out.c_slice_buffer());
+  }
+  if (gzip_) {
+    const uint32_t isize = static_cast<uint32_t>(input_length_);
+    const uint8_t trailer[8] = {
+        static_cast<uint8_t>(check),         static_cast<uint8_t>(check >> 8),
+        static_cast<uint8_t>(check >> 16),   static_cast<uint8_t>(check >> 24),
+        static_cast<uint8_t>(isize),         static_cast<uint8_t>(isize >> 8),
+        static_cast<uint8_t>(isize >> 16),   static_cast<uint8_t>(isize >> 24)};
+    out.Append(grpc_core::Slice::FromCopiedBuffer(trailer, sizeof(trailer)));
+  } else {
+    const uint8_t trailer[4] = {
+        static_cast<uint8_t>(check >> 24), static_cast<uint8_t>(check >> 16),
+        static_cast<uint8_t>(check >> 8), static_cast<uint8_t>(check)};
+    out.Append(grpc_core::Slice::FromCopiedBuffer(trailer, sizeof(trailer)));
+  }
+  if (out.Length() >= input_length_) return false;
+  grpc_slice_buffer_move_into(out.c_slice_buffer(), output);
+  return true;
+}
+
+}  // namespace
+
+static int zlib_compress_parallel(
+    grpc_slice_buffer* input, grpc_slice_buffer* output, int gzip,
+    const grpc_core::MessageCompressionOptions& options) {
+  auto job = std::make_shared<ParallelDeflate>(
+      input, options.parallel_chunk_size, options.zlib_level, gzip != 0);
+  // The calling thread compresses too, so it only ever waits for chunks that
+  // are already being compressed elsewhere.
+  const size_t helpers =
+      std::min<size_t>(job->num_chunks(), gpr_cpu_num_cores()) - 1;
+  for (size_t i = 0; i < helpers; i++) {
+    options.event_engine->Run([job] { job->CompressChunks(); });
+  }
+  job->CompressChunks();
+  job->WaitForChunks();
+  return job->Finish(output);
+}
+
 static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                         int gzip) {
+                         int gzip,
+                         const grpc_core::MessageCompressionOptions& options) {
+  if (options.event_engine != nullptr && options.parallel_chunk_size > 0 &&
+      input->length >= 2 * options.parallel_chunk_size) {
+    return zlib_compress_parallel(input, output, gzip, options);
+  }
   z_stream zs;
   int r;
   size_t i;
@@ -103,9 +322,15 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   memset(&zs, 0, sizeof(zs));
   zs.zalloc = zalloc_gpr;
   zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
+  r = deflateInit2(&zs, options.zlib_level, Z_DEFLATED, 15 | (gzip ? 16 : 0),
                    8, Z_DEFAULT_STRATEGY);
   GPR_ASSERT(r == Z_OK);
+  if (!gzip && !options.deflate_dictionary.empty()) {
+    r = deflateSetDictionary(
+        &zs, reinterpret_cast<const Bytef*>(options.deflate_dictionary.data()),
+        static_cast<uInt>(options.deflate_dictionary.size()));
+    GPR_ASSERT(r == Z_OK);
+  }
   r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
@@ -118,8 +343,58 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   return r;
 }
 
+// The gzip trailer ends with the uncompressed size (mod 2^32): use it to size
+// the first output block. The trailer comes from the peer, so the block is
+// kept within a typical compression ratio of the input and within
+// max_output_size (if non-zero); larger messages grow the output as usual.
+static size_t gzip_decompressed_size_hint(const grpc_slice_buffer* input,
+                                          size_t max_output_size) {
+  // 10 byte header, 8 byte trailer.
+  if (input->length < 18) return 0;
+  uint8_t isize[4];
+  size_t remaining = sizeof(isize);
+  for (size_t i = input->count; remaining > 0 && i-- > 0;) {
+    const size_t len = GRPC_SLICE_LENGTH(input->slices[i]);
+    const size_t take = std::min(len, remaining);
+    memcpy(isize + remaining - take,
+           GRPC_SLICE_START_PTR(input->slices[i]) + len - take, take);
+    remaining -= take;
+  }
+  const size_t hint = static_cast<uint32_t>(isize[0]) |
+                      static_cast<uint32_t>(isize[1]) << 8 |
+                      static_cast<uint32_t>(isize[2]) << 16 |
+                      static_cast<uint32_t>(isize[3]) << 24;
+  static constexpr size_t kMaxPresizedRatio = 8;
+  size_t limit = std::min<size_t>(input->length * kMaxPresizedRatio,
+                                  MAX_PRESIZED_BLOCK_SIZE);
+  if (max_output_size != 0) limit = std::min(limit, max_output_size);
+  return std::min(hint, limit);
+}
+
+// inflate(), supplying the preset dictionary that zs->opaque points to (an
+// absl::string_view, possibly empty) if the stream asks for one.
+static int inflate_with_dictionary(z_stream* zs, int flush) {
+  int r = inflate(zs, flush);
+  if (r != Z_NEED_DICT) return r;
+  const auto* dictionary = static_cast<const absl::string_view*>(zs->opaque);
+  if (dictionary->empty()) {
+    gpr_log(GPR_INFO, "zlib: stream needs a dictionary, but none configured");
+    return Z_DATA_ERROR;
+  }
+  // Fails if the stream's dictionary id doesn't match.
+  r = inflateSetDictionary(zs,
+                           reinterpret_cast<const Bytef*>(dictionary->data()),
+                           static_cast<uInt>(dictionary->size()));
+  if (r != Z_OK) {
+    gpr_log(GPR_INFO, "zlib: stream needs a different dictionary");
+    return Z_DATA_ERROR;
+  }
+  return inflate(zs, flush);
+}
+
 static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                           int gzip) {
+                           int gzip, absl::string_view dictionary,
+                           size_t max_output_size) {
   z_stream zs;
   int r;
   size_t i;
@@ -128,9 +403,17 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   memset(&zs, 0, sizeof(zs));
   zs.zalloc = zalloc_gpr;
   zs.zfree = zfree_gpr;
+  zs.opaque = &dictionary;
   r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
   GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  // One extra byte so that an exactly sized block doesn't leave a trailing
+  // empty one.
+  const size_t first_block_size =
+      gzip ? std::max<size_t>(
+                 OUTPUT_BLOCK_SIZE,
+                 gzip_decompressed_size_hint(input, max_output_size) + 1)
+           : OUTPUT_BLOCK_SIZE;
+  r = zlib_body(&zs, input, output, inflate_with_dictionary, first_block_size);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_core::CSliceUnref(output->slices[i]);
@@ -151,16 +434,17 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
 }
 
 static int compress_inner(grpc_compression_algorithm algorithm,
-                          grpc_slice_buffer* input, grpc_slice_buffer* output) {
+                          grpc_slice_buffer* input, grpc_slice_buffer* output,
+                          const grpc_core::MessageCompressionOptions& options) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       // the fallback path always needs to be send uncompressed: we simply
       // rely on that here
       return 0;
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(input, output, 0, options);
     case GRPC_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(input, output, 1, options);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -170,7 +454,14 @@ static int compress_inner(grpc_compression_algorithm algorithm,
 
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+  return grpc_msg_compress(algorithm, input, output,
+                           grpc_core::MessageCompressionOptions());
+}
+
+int grpc_msg_compress(grpc_compression_algorithm algorithm,
+                      grpc_slice_buffer* input, grpc_slice_buffer* output,
+                      const grpc_core::MessageCompressionOptions& options) {
+  if (!compress_inner(algorithm, input, output, options)) {
     copy(input, output);
     return 0;
   }
@@ -179,16 +470,35 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  return grpc_msg_decompress(algorithm, input, output,
+                             grpc_core::MessageDecompressionOptions());
+}
+
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output,
+                        const grpc_core::MessageDecompressionOptions& options) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       return copy(input, output);
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_decompress(input, output, 0);
+      return zlib_decompress(input, output, 0, options.deflate_dictionary,
+                             options.max_output_size);
     case GRPC_COMPRESS_GZIP:
-      return zlib_decompress(input, output, 1);
+      return zlib_decompress(input, output, 1, options.deflate_dictionary,
+                             options.max_output_size);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
   gpr_log(GPR_ERROR, "invalid compression algorithm %d", algorithm);
   return 0;
 }
+
+namespace grpc_core {
+
+uint32_t DeflateDictionaryId(absl::string_view dictionary) {
+  return adler32(adler32(0L, Z_NULL, 0),
+                 reinterpret_cast<const Bytef*>(dictionary.data()),
+                 static_cast<uInt>(dictionary.size()));
+}
+
+}  // namespace grpc_core
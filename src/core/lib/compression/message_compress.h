@@ -21,19 +21,66 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/compression_types.h>
 #include <grpc/slice.h>
 
+namespace grpc_core {
+
+// Tuning for grpc_msg_compress.
+struct MessageCompressionOptions {
+  // zlib compression level (0-9) used by deflate and gzip, or -1 for zlib's
+  // default.
+  int zlib_level = -1;
+  // If non-zero (and event_engine is set), deflate and gzip inputs of at
+  // least twice this many bytes are split into chunks of this size that are
+  // compressed concurrently. The chunks are joined into one standard deflate
+  // stream, so receivers need no support for this.
+  size_t parallel_chunk_size = 0;
+  // Where to run parallel chunk compression.
+  grpc_event_engine::experimental::EventEngine* event_engine = nullptr;
+  // If not empty, a preset dictionary for deflate (not gzip, whose format has
+  // no room for one). The compressed stream names it by DeflateDictionaryId()
+  // and can only be decompressed with the same dictionary. Messages that get
+  // compressed in parallel chunks don't use it.
+  absl::string_view deflate_dictionary;
+};
+
+// Options for grpc_msg_decompress.
+struct MessageDecompressionOptions {
+  // The dictionary to use for deflate streams that ask for one.
+  absl::string_view deflate_dictionary;
+  // If non-zero, the largest decompressed message the caller will accept.
+  // Only used to bound how much output space is allocated up front.
+  size_t max_output_size = 0;
+};
+
+// The id that deflate streams use to refer to 'dictionary'.
+uint32_t DeflateDictionaryId(absl::string_view dictionary);
+
+}  // namespace grpc_core
+
 // compress 'input' to 'output' using 'algorithm'.
 // On success, appends compressed slices to output and returns 1.
 // On failure, appends uncompressed slices to output and returns 0.
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output);
+int grpc_msg_compress(grpc_compression_algorithm algorithm,
+                      grpc_slice_buffer* input, grpc_slice_buffer* output,
+                      const grpc_core::MessageCompressionOptions& options);
 
 // decompress 'input' to 'output' using 'algorithm'.
 // On success, appends slices to output and returns 1.
 // On failure, output is unchanged, and returns 0.
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output,
+                        const grpc_core::MessageDecompressionOptions& options);
 
 #endif  // GRPC_SRC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H
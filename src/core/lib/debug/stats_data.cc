@@ -84,6 +84,8 @@ const absl::string_view
     GlobalStats::counter_name[static_cast<int>(Counter::COUNT)] = {
         "client_calls_created",
         "server_calls_created",
+        "call_arena_pool_hits",
+        "call_arena_pool_misses",
         "client_channels_created",
         "client_subchannels_created",
         "server_channels_created",
@@ -97,6 +99,7 @@ const absl::string_view
         "http2_writes_begun",
         "http2_transport_stalls",
         "http2_stream_stalls",
+        "http2_writes_partial",
         "cq_pluck_creates",
         "cq_next_creates",
         "cq_callback_creates",
@@ -106,6 +109,10 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     Counter::COUNT)] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of call arenas created from storage cached by a channel's arena "
+    "pool",
+    "Number of call arenas created by a channel's arena pool that needed new "
+    "storage",
     "Number of client channels created",
     "Number of client subchannels created",
     "Number of server channels created",
@@ -122,6 +129,8 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     "control window",
     "Number of times sending was completely stalled by the stream flow control "
     "window",
+    "Number of HTTP2 writes that stopped at the write size target while "
+    "streams were still writable",
     "Number of completion queues created for cq_pluck (indicates sync api "
     "usage)",
     "Number of completion queues created for cq_next (indicates cq async api "
@@ -136,6 +145,7 @@ const absl::string_view
         "tcp_write_iov_size",       "tcp_read_size",
         "tcp_read_offer",           "tcp_read_offer_iov_size",
         "http2_send_message_size",  "http2_metadata_size",
+        "http2_write_target_size",  "http2_streams_per_write",
         "wrr_subchannel_list_size", "wrr_subchannel_ready_size",
 };
 const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
@@ -148,6 +158,9 @@ const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     "Number of byte segments offered to each syscall_read",
     "Size of messages received by HTTP2 transport",
     "Number of bytes consumed by metadata, according to HPACK accounting rules",
+    "Number of bytes each HTTP2 write aims to put on the wire, based on the "
+    "BDP estimate",
+    "Number of times a stream contributed frames to each HTTP2 write",
     "Number of subchannels in a subchannel list at picker creation time",
     "Number of READY subchannels in a subchannel list at picker creation time",
 };
@@ -262,6 +275,8 @@ int Histogram_80_10::BucketFor(int value) {
 GlobalStats::GlobalStats()
     : client_calls_created{0},
       server_calls_created{0},
+      call_arena_pool_hits{0},
+      call_arena_pool_misses{0},
       client_channels_created{0},
       client_subchannels_created{0},
       server_channels_created{0},
@@ -275,6 +290,7 @@ GlobalStats::GlobalStats()
       http2_writes_begun{0},
       http2_transport_stalls{0},
       http2_stream_stalls{0},
+      http2_writes_partial{0},
       cq_pluck_creates{0},
       cq_next_creates{0},
       cq_callback_creates{0},
@@ -307,6 +323,12 @@ HistogramView GlobalStats::histogram(Histogram which) const {
     case Histogram::kHttp2MetadataSize:
       return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
                            http2_metadata_size.buckets()};
+    case Histogram::kHttp2WriteTargetSize:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           http2_write_target_size.buckets()};
+    case Histogram::kHttp2StreamsPerWrite:
+      return HistogramView{&Histogram_10000_20::BucketFor, kStatsTable4, 20,
+                           http2_streams_per_write.buckets()};
     case Histogram::kWrrSubchannelListSize:
       return HistogramView{&Histogram_10000_20::BucketFor, kStatsTable4, 20,
                            wrr_subchannel_list_size.buckets()};
@@ -322,6 +344,10 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.client_calls_created.load(std::memory_order_relaxed);
     result->server_calls_created +=
         data.server_calls_created.load(std::memory_order_relaxed);
+    result->call_arena_pool_hits +=
+        data.call_arena_pool_hits.load(std::memory_order_relaxed);
+    result->call_arena_pool_misses +=
+        data.call_arena_pool_misses.load(std::memory_order_relaxed);
     result->client_channels_created +=
         data.client_channels_created.load(std::memory_order_relaxed);
     result->client_subchannels_created +=
@@ -346,6 +372,8 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.http2_transport_stalls.load(std::memory_order_relaxed);
     result->http2_stream_stalls +=
         data.http2_stream_stalls.load(std::memory_order_relaxed);
+    result->http2_writes_partial +=
+        data.http2_writes_partial.load(std::memory_order_relaxed);
     result->cq_pluck_creates +=
         data.cq_pluck_creates.load(std::memory_order_relaxed);
     result->cq_next_creates +=
@@ -361,6 +389,8 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
     data.tcp_read_offer_iov_size.Collect(&result->tcp_read_offer_iov_size);
     data.http2_send_message_size.Collect(&result->http2_send_message_size);
     data.http2_metadata_size.Collect(&result->http2_metadata_size);
+    data.http2_write_target_size.Collect(&result->http2_write_target_size);
+    data.http2_streams_per_write.Collect(&result->http2_streams_per_write);
     data.wrr_subchannel_list_size.Collect(&result->wrr_subchannel_list_size);
     data.wrr_subchannel_ready_size.Collect(&result->wrr_subchannel_ready_size);
   }
@@ -372,6 +402,10 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
       client_calls_created - other.client_calls_created;
   result->server_calls_created =
       server_calls_created - other.server_calls_created;
+  result->call_arena_pool_hits =
+      call_arena_pool_hits - other.call_arena_pool_hits;
+  result->call_arena_pool_misses =
+      call_arena_pool_misses - other.call_arena_pool_misses;
   result->client_channels_created =
       client_channels_created - other.client_channels_created;
   result->client_subchannels_created =
@@ -391,6 +425,8 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->http2_transport_stalls =
       http2_transport_stalls - other.http2_transport_stalls;
   result->http2_stream_stalls = http2_stream_stalls - other.http2_stream_stalls;
+  result->http2_writes_partial =
+      http2_writes_partial - other.http2_writes_partial;
   result->cq_pluck_creates = cq_pluck_creates - other.cq_pluck_creates;
   result->cq_next_creates = cq_next_creates - other.cq_next_creates;
   result->cq_callback_creates = cq_callback_creates - other.cq_callback_creates;
@@ -405,6 +441,10 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->http2_send_message_size =
       http2_send_message_size - other.http2_send_message_size;
   result->http2_metadata_size = http2_metadata_size - other.http2_metadata_size;
+  result->http2_write_target_size =
+      http2_write_target_size - other.http2_write_target_size;
+  result->http2_streams_per_write =
+      http2_streams_per_write - other.http2_streams_per_write;
   result->wrr_subchannel_list_size =
       wrr_subchannel_list_size - other.wrr_subchannel_list_size;
   result->wrr_subchannel_ready_size =
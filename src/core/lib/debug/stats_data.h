@@ -126,6 +126,8 @@ struct GlobalStats {
   enum class Counter {
     kClientCallsCreated,
     kServerCallsCreated,
+    kCallArenaPoolHits,
+    kCallArenaPoolMisses,
     kClientChannelsCreated,
     kClientSubchannelsCreated,
     kServerChannelsCreated,
@@ -139,6 +141,7 @@ struct GlobalStats {
     kHttp2WritesBegun,
     kHttp2TransportStalls,
     kHttp2StreamStalls,
+    kHttp2WritesPartial,
     kCqPluckCreates,
     kCqNextCreates,
     kCqCallbackCreates,
@@ -154,6 +157,8 @@ struct GlobalStats {
     kTcpReadOfferIovSize,
     kHttp2SendMessageSize,
     kHttp2MetadataSize,
+    kHttp2WriteTargetSize,
+    kHttp2StreamsPerWrite,
     kWrrSubchannelListSize,
     kWrrSubchannelReadySize,
     COUNT
@@ -169,6 +174,8 @@ struct GlobalStats {
     struct {
       uint64_t client_calls_created;
       uint64_t server_calls_created;
+      uint64_t call_arena_pool_hits;
+      uint64_t call_arena_pool_misses;
       uint64_t client_channels_created;
       uint64_t client_subchannels_created;
       uint64_t server_channels_created;
@@ -182,6 +189,7 @@ struct GlobalStats {
       uint64_t http2_writes_begun;
       uint64_t http2_transport_stalls;
       uint64_t http2_stream_stalls;
+      uint64_t http2_writes_partial;
       uint64_t cq_pluck_creates;
       uint64_t cq_next_creates;
       uint64_t cq_callback_creates;
@@ -197,6 +205,8 @@ struct GlobalStats {
   Histogram_80_10 tcp_read_offer_iov_size;
   Histogram_16777216_20 http2_send_message_size;
   Histogram_65536_26 http2_metadata_size;
+  Histogram_16777216_20 http2_write_target_size;
+  Histogram_10000_20 http2_streams_per_write;
   Histogram_10000_20 wrr_subchannel_list_size;
   Histogram_10000_20 wrr_subchannel_ready_size;
   HistogramView histogram(Histogram which) const;
@@ -213,6 +223,14 @@ class GlobalStatsCollector {
     data_.this_cpu().server_calls_created.fetch_add(1,
                                                     std::memory_order_relaxed);
   }
+  void IncrementCallArenaPoolHits() {
+    data_.this_cpu().call_arena_pool_hits.fetch_add(1,
+                                                    std::memory_order_relaxed);
+  }
+  void IncrementCallArenaPoolMisses() {
+    data_.this_cpu().call_arena_pool_misses.fetch_add(
+        1, std::memory_order_relaxed);
+  }
   void IncrementClientChannelsCreated() {
     data_.this_cpu().client_channels_created.fetch_add(
         1, std::memory_order_relaxed);
@@ -259,6 +277,10 @@ class GlobalStatsCollector {
     data_.this_cpu().http2_stream_stalls.fetch_add(1,
                                                    std::memory_order_relaxed);
   }
+  void IncrementHttp2WritesPartial() {
+    data_.this_cpu().http2_writes_partial.fetch_add(1,
+                                                    std::memory_order_relaxed);
+  }
   void IncrementCqPluckCreates() {
     data_.this_cpu().cq_pluck_creates.fetch_add(1, std::memory_order_relaxed);
   }
@@ -296,6 +318,12 @@ class GlobalStatsCollector {
   void IncrementHttp2MetadataSize(int value) {
     data_.this_cpu().http2_metadata_size.Increment(value);
   }
+  void IncrementHttp2WriteTargetSize(int value) {
+    data_.this_cpu().http2_write_target_size.Increment(value);
+  }
+  void IncrementHttp2StreamsPerWrite(int value) {
+    data_.this_cpu().http2_streams_per_write.Increment(value);
+  }
   void IncrementWrrSubchannelListSize(int value) {
     data_.this_cpu().wrr_subchannel_list_size.Increment(value);
   }
@@ -307,6 +335,8 @@ class GlobalStatsCollector {
   struct Data {
     std::atomic<uint64_t> client_calls_created{0};
     std::atomic<uint64_t> server_calls_created{0};
+    std::atomic<uint64_t> call_arena_pool_hits{0};
+    std::atomic<uint64_t> call_arena_pool_misses{0};
     std::atomic<uint64_t> client_channels_created{0};
     std::atomic<uint64_t> client_subchannels_created{0};
     std::atomic<uint64_t> server_channels_created{0};
@@ -320,6 +350,7 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> http2_writes_begun{0};
     std::atomic<uint64_t> http2_transport_stalls{0};
     std::atomic<uint64_t> http2_stream_stalls{0};
+    std::atomic<uint64_t> http2_writes_partial{0};
     std::atomic<uint64_t> cq_pluck_creates{0};
     std::atomic<uint64_t> cq_next_creates{0};
     std::atomic<uint64_t> cq_callback_creates{0};
@@ -332,6 +363,8 @@ class GlobalStatsCollector {
     HistogramCollector_80_10 tcp_read_offer_iov_size;
     HistogramCollector_16777216_20 http2_send_message_size;
     HistogramCollector_65536_26 http2_metadata_size;
+    HistogramCollector_16777216_20 http2_write_target_size;
+    HistogramCollector_10000_20 http2_streams_per_write;
     HistogramCollector_10000_20 wrr_subchannel_list_size;
     HistogramCollector_10000_20 wrr_subchannel_ready_size;
   };
@@ -0,0 +1,775 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.h"
+
+#include <stdint.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+// This polling engine is only relevant on linux kernels supporting io_uring
+// multishot poll requests.
+#ifdef GRPC_LINUX_IO_URING
+#include <endian.h>
+#include <errno.h>
+#include <limits.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/lockfree_event.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix_default.h"
+#include "src/core/lib/gprpp/crash.h"
+#include "src/core/lib/gprpp/fork.h"
+#include "src/core/lib/gprpp/status_helper.h"
+#include "src/core/lib/gprpp/strerror.h"
+#include "src/core/lib/gprpp/sync.h"
+
+#define MAX_IO_URING_EVENTS_HANDLED_PER_ITERATION 1
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+// Number of submission queue entries. The completion queue is sized
+// kCompletionQueueEntries so that a burst of readiness notifications on many
+// connections does not overflow it.
+constexpr uint32_t kSubmissionQueueEntries = 256;
+constexpr uint32_t kCompletionQueueEntries = 4096;
+
+// Reserved user_data values. Handle requests use (generation << 32) | index,
+// and the generation never reaches UINT32_MAX before wrapping to 0.
+constexpr uint64_t kWakeupTag = ~uint64_t{0};
+constexpr uint64_t kRemoveTag = ~uint64_t{0} - 1;
+
+// Events each handle is watched for. POLLERR and POLLHUP are always reported.
+constexpr uint32_t kHandlePollMask = POLLIN | POLLPRI | POLLOUT;
+
+int IoUringSetup(uint32_t entries, struct io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, uint32_t to_submit, uint32_t min_complete,
+                 uint32_t flags, void* arg, size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, arg_size));
+}
+
+// The ring indices are shared with the kernel, which reads them with acquire
+// and release semantics.
+inline uint32_t LoadAcquire(const uint32_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void StoreRelease(uint32_t* p, uint32_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+void PrepareRequest(struct io_uring_sqe* sqe, uint8_t opcode, int fd,
+                    uint32_t poll_mask, uint64_t addr, uint64_t user_data) {
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = addr;
+  sqe->user_data = user_data;
+  if (opcode == IORING_OP_POLL_ADD) {
+#if __BYTE_ORDER == __BIG_ENDIAN
+    poll_mask = (poll_mask << 16) | (poll_mask >> 16);
+#endif
+    sqe->poll32_events = poll_mask;
+    sqe->len = IORING_POLL_ADD_MULTI;
+  }
+}
+
+}  // namespace
+
+class IoUringEventHandle : public EventHandle {
+ public:
+  IoUringEventHandle(int fd, uint32_t index, IoUringPoller* poller)
+      : fd_(fd),
+        index_(index),
+        poller_(poller),
+        read_closure_(std::make_unique<LockfreeEvent>(poller->GetScheduler())),
+        write_closure_(std::make_unique<LockfreeEvent>(poller->GetScheduler())),
+        error_closure_(
+            std::make_unique<LockfreeEvent>(poller->GetScheduler())) {
+    read_closure_->InitEvent();
+    write_closure_->InitEvent();
+    error_closure_->InitEvent();
+    pending_read_.store(false, std::memory_order_relaxed);
+    pending_write_.store(false, std::memory_order_relaxed);
+    pending_error_.store(false, std::memory_order_relaxed);
+  }
+  void ReInit(int fd) {
+    fd_ = fd;
+    read_closure_->InitEvent();
+    write_closure_->InitEvent();
+    error_closure_->InitEvent();
+    pending_read_.store(false, std::memory_order_relaxed);
+    pending_write_.store(false, std::memory_order_relaxed);
+    pending_error_.store(false, std::memory_order_relaxed);
+  }
+  IoUringPoller* Poller() override { return poller_; }
+  // The user_data attached to the poll request of the current incarnation of
+  // this handle. Must be called with the poller's mu_ held.
+  uint64_t UserData() const {
+    return (static_cast<uint64_t>(generation_) << 32) | index_;
+  }
+  bool SetPendingActions(bool pending_read, bool pending_write,
+                         bool pending_error) {
+    // See Epoll1EventHandle::SetPendingActions for why these are atomics.
+    if (pending_read) {
+      pending_read_.store(true, std::memory_order_release);
+    }
+    if (pending_write) {
+      pending_write_.store(true, std::memory_order_release);
+    }
+    if (pending_error) {
+      pending_error_.store(true, std::memory_order_release);
+    }
+    return pending_read || pending_write || pending_error;
+  }
+  int WrappedFd() override { return fd_; }
+  void OrphanHandle(PosixEngineClosure* on_done, int* release_fd,
+                    absl::string_view reason) override;
+  void ShutdownHandle(absl::Status why) override;
+  void NotifyOnRead(PosixEngineClosure* on_read) override;
+  void NotifyOnWrite(PosixEngineClosure* on_write) override;
+  void NotifyOnError(PosixEngineClosure* on_error) override;
+  void SetReadable() override;
+  void SetWritable() override;
+  void SetHasError() override;
+  bool IsHandleShutdown() override;
+  inline void ExecutePendingActions() {
+    // These may execute in Parallel with ShutdownHandle. Thats not an issue
+    // because the lockfree event implementation should be able to handle it.
+    if (pending_read_.exchange(false, std::memory_order_acq_rel)) {
+      read_closure_->SetReady();
+    }
+    if (pending_write_.exchange(false, std::memory_order_acq_rel)) {
+      write_closure_->SetReady();
+    }
+    if (pending_error_.exchange(false, std::memory_order_acq_rel)) {
+      error_closure_->SetReady();
+    }
+  }
+  ~IoUringEventHandle() override = default;
+
+ private:
+  friend class IoUringPoller;
+  void HandleShutdownInternal(absl::Status why);
+  // See Epoll1EventHandle::ShutdownHandle for explanation on why a mutex is
+  // required.
+  grpc_core::Mutex mu_;
+  int fd_;
+  // Position of this handle in IoUringPoller::handles_.
+  const uint32_t index_;
+  // Incremented every time the handle is orphaned, so that completions for
+  // the poll requests of previous incarnations can be recognized and dropped.
+  // Guarded by the poller's mu_.
+  uint32_t generation_ = 0;
+  // Guarded by the poller's mu_.
+  bool track_err_ = false;
+  std::atomic<bool> pending_read_{false};
+  std::atomic<bool> pending_write_{false};
+  std::atomic<bool> pending_error_{false};
+  IoUringPoller* poller_;
+  std::unique_ptr<LockfreeEvent> read_closure_;
+  std::unique_ptr<LockfreeEvent> write_closure_;
+  std::unique_ptr<LockfreeEvent> error_closure_;
+};
+
+namespace {
+
+void TeardownRing(IoUringPoller::Ring* ring);
+
+// Create an io_uring instance and map its submission and completion queues.
+bool SetupRing(uint32_t entries, uint32_t cq_entries,
+               IoUringPoller::Ring* ring) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+  params.cq_entries = cq_entries;
+  int fd = IoUringSetup(entries, &params);
+  if (fd < 0) {
+    gpr_log(GPR_DEBUG, "io_uring_setup unavailable: %s",
+            grpc_core::StrError(errno).c_str());
+    return false;
+  }
+  ring->fd = fd;
+  // IORING_FEAT_EXT_ARG is needed to wait with a timeout without a separate
+  // timeout request. IORING_FEAT_NODROP guarantees completions are not lost
+  // if the completion queue overflows.
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0 ||
+      (params.features & IORING_FEAT_NODROP) == 0) {
+    gpr_log(GPR_DEBUG, "io_uring lacks required features: 0x%x",
+            params.features);
+    TeardownRing(ring);
+    return false;
+  }
+  ring->sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring->sq_ring_size = ring->cq_ring_size =
+        std::max(ring->sq_ring_size, ring->cq_ring_size);
+  }
+  ring->sq_ring_ptr =
+      mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ring_ptr == MAP_FAILED) {
+    ring->sq_ring_ptr = nullptr;
+    TeardownRing(ring);
+    return false;
+  }
+  if (single_mmap) {
+    ring->cq_ring_ptr = ring->sq_ring_ptr;
+  } else {
+    ring->cq_ring_ptr =
+        mmap(nullptr, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ring_ptr == MAP_FAILED) {
+      ring->cq_ring_ptr = nullptr;
+      TeardownRing(ring);
+      return false;
+    }
+  }
+  ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes_ptr = mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (ring->sqes_ptr == MAP_FAILED) {
+    ring->sqes_ptr = nullptr;
+    TeardownRing(ring);
+    return false;
+  }
+  char* sq = static_cast<char*>(ring->sq_ring_ptr);
+  char* cq = static_cast<char*>(ring->cq_ring_ptr);
+  ring->sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+  ring->sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  ring->sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  ring->sq_entries = params.sq_entries;
+  ring->sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  ring->cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  ring->cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  ring->cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  ring->cqes = cq + params.cq_off.cqes;
+  return true;
+}
+
+void TeardownRing(IoUringPoller::Ring* ring) {
+  if (ring->sqes_ptr != nullptr) {
+    munmap(ring->sqes_ptr, ring->sqes_size);
+    ring->sqes_ptr = nullptr;
+  }
+  if (ring->cq_ring_ptr != nullptr && ring->cq_ring_ptr != ring->sq_ring_ptr) {
+    munmap(ring->cq_ring_ptr, ring->cq_ring_size);
+  }
+  ring->cq_ring_ptr = nullptr;
+  if (ring->sq_ring_ptr != nullptr) {
+    munmap(ring->sq_ring_ptr, ring->sq_ring_size);
+    ring->sq_ring_ptr = nullptr;
+  }
+  if (ring->fd >= 0) {
+    close(ring->fd);
+    ring->fd = -1;
+  }
+}
+
+struct io_uring_sqe* SqeAt(IoUringPoller::Ring* ring, uint32_t index) {
+  return static_cast<struct io_uring_sqe*>(ring->sqes_ptr) + index;
+}
+
+struct io_uring_cqe* CqeAt(IoUringPoller::Ring* ring, uint32_t index) {
+  return static_cast<struct io_uring_cqe*>(ring->cqes) + index;
+}
+
+// Multishot poll requests were added in linux 5.13. Older kernels reject the
+// IORING_POLL_ADD_MULTI flag (or silently treat the request as one-shot), so
+// arm a multishot poll on an eventfd and check that the completion carries
+// IORING_CQE_F_MORE.
+bool ProbeMultishotPoll() {
+  IoUringPoller::Ring ring;
+  if (!SetupRing(8, 16, &ring)) {
+    return false;
+  }
+  int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (efd < 0) {
+    TeardownRing(&ring);
+    return false;
+  }
+  bool supported = false;
+  uint32_t tail = *ring.sq_tail;
+  uint32_t index = tail & ring.sq_mask;
+  PrepareRequest(SqeAt(&ring, index), IORING_OP_POLL_ADD, efd, POLLIN, 0, 1);
+  ring.sq_array[index] = index;
+  StoreRelease(ring.sq_tail, tail + 1);
+  uint64_t value = 1;
+  if (IoUringEnter(ring.fd, 1, 0, 0, nullptr, 0) == 1 &&
+      write(efd, &value, sizeof(value)) == sizeof(value)) {
+    struct __kernel_timespec ts = {1, 0};
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    int r;
+    do {
+      r = IoUringEnter(ring.fd, 0, 1,
+                       IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                       sizeof(arg));
+    } while (r < 0 && errno == EINTR);
+    uint32_t head = *ring.cq_head;
+    if (head != LoadAcquire(ring.cq_tail)) {
+      struct io_uring_cqe* cqe = CqeAt(&ring, head & ring.cq_mask);
+      supported = cqe->user_data == 1 && cqe->res > 0 &&
+                  (cqe->flags & IORING_CQE_F_MORE) != 0;
+      StoreRelease(ring.cq_head, head + 1);
+    }
+  }
+  close(efd);
+  TeardownRing(&ring);
+  return supported;
+}
+
+}  // namespace
+
+void IoUringEventHandle::OrphanHandle(PosixEngineClosure* on_done,
+                                      int* release_fd,
+                                      absl::string_view reason) {
+  bool is_release_fd = (release_fd != nullptr);
+  if (!read_closure_->IsShutdown()) {
+    HandleShutdownInternal(absl::Status(absl::StatusCode::kUnknown, reason));
+  }
+
+  // Drop all completions that are still in flight for this incarnation of the
+  // handle, and cancel its poll request.
+  uint64_t user_data;
+  {
+    grpc_core::MutexLock lock(&poller_->mu_);
+    user_data = UserData();
+    ++generation_;
+  }
+  // Submitted right away rather than on the next Work() call: the fd is
+  // closed or handed back below, and must not stay polled by the ring.
+  poller_->QueueRequest(IORING_OP_POLL_REMOVE, -1, 0, user_data, kRemoveTag,
+                        /*submit_now=*/true);
+
+  // If release_fd is not NULL, we should be relinquishing control of the file
+  // descriptor fd->fd (but we still own the grpc_fd structure).
+  if (is_release_fd) {
+    *release_fd = fd_;
+  } else {
+    shutdown(fd_, SHUT_RDWR);
+    close(fd_);
+  }
+
+  {
+    // See Epoll1Poller::ShutdownHandle for explanation on why a mutex is
+    // required here.
+    grpc_core::MutexLock lock(&mu_);
+    read_closure_->DestroyEvent();
+    write_closure_->DestroyEvent();
+    error_closure_->DestroyEvent();
+  }
+  pending_read_.store(false, std::memory_order_release);
+  pending_write_.store(false, std::memory_order_release);
+  pending_error_.store(false, std::memory_order_release);
+  {
+    grpc_core::MutexLock lock(&poller_->mu_);
+    poller_->free_handles_list_.push_back(this);
+  }
+  if (on_done != nullptr) {
+    on_done->SetStatus(absl::OkStatus());
+    poller_->GetScheduler()->Run(on_done);
+  }
+}
+
+void IoUringEventHandle::HandleShutdownInternal(absl::Status why) {
+  grpc_core::StatusSetInt(&why, grpc_core::StatusIntProperty::kRpcStatus,
+                          GRPC_STATUS_UNAVAILABLE);
+  if (read_closure_->SetShutdown(why)) {
+    write_closure_->SetShutdown(why);
+    error_closure_->SetShutdown(why);
+  }
+}
+
+IoUringPoller::IoUringPoller(Scheduler* scheduler)
+    : scheduler_(scheduler), was_kicked_(false), closed_(false) {
+  GPR_ASSERT(
+      SetupRing(kSubmissionQueueEntries, kCompletionQueueEntries, &ring_));
+  wakeup_fd_ = *CreateWakeupFd();
+  GPR_ASSERT(wakeup_fd_ != nullptr);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", ring_.fd);
+  QueueRequest(IORING_OP_POLL_ADD, wakeup_fd_->ReadFd(), POLLIN, 0,
+               kWakeupTag);
+}
+
+void IoUringPoller::Shutdown() { delete this; }
+
+void IoUringPoller::Close() {
+  grpc_core::MutexLock lock(&mu_);
+  if (closed_) return;
+  // Closing the ring cancels all outstanding poll requests.
+  TeardownRing(&ring_);
+  while (!free_handles_list_.empty()) {
+    IoUringEventHandle* handle = free_handles_list_.front();
+    free_handles_list_.pop_front();
+    delete handle;
+  }
+  handles_.clear();
+  closed_ = true;
+}
+
+IoUringPoller::~IoUringPoller() { Close(); }
+
+EventHandle* IoUringPoller::CreateHandle(int fd, absl::string_view /*name*/,
+                                         bool track_err) {
+  IoUringEventHandle* new_handle = nullptr;
+  uint64_t user_data;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (free_handles_list_.empty()) {
+      new_handle = new IoUringEventHandle(
+          fd, static_cast<uint32_t>(handles_.size()), this);
+      handles_.push_back(new_handle);
+    } else {
+      new_handle = free_handles_list_.front();
+      free_handles_list_.pop_front();
+      new_handle->ReInit(fd);
+    }
+    new_handle->track_err_ = track_err;
+    user_data = new_handle->UserData();
+  }
+  QueueRequest(IORING_OP_POLL_ADD, fd, kHandlePollMask, 0, user_data);
+  return new_handle;
+}
+
+void IoUringPoller::QueueRequest(uint8_t opcode, int fd, uint32_t poll_mask,
+                                 uint64_t addr, uint64_t user_data,
+                                 bool submit_now) {
+  grpc_core::MutexLock lock(&sq_mu_);
+  uint32_t tail = *ring_.sq_tail;
+  if (tail - LoadAcquire(ring_.sq_head) >= ring_.sq_entries) {
+    // Without SQPOLL the kernel consumes every submitted entry before
+    // io_uring_enter returns, which frees up the whole submission queue.
+    SubmitLocked();
+    GPR_ASSERT(tail - LoadAcquire(ring_.sq_head) < ring_.sq_entries);
+  }
+  uint32_t index = tail & ring_.sq_mask;
+  PrepareRequest(SqeAt(&ring_, index), opcode, fd, poll_mask, addr, user_data);
+  ring_.sq_array[index] = index;
+  StoreRelease(ring_.sq_tail, tail + 1);
+  ++unsubmitted_;
+  if (submit_now || in_wait_) {
+    // Without submit_now, only needed because the polling thread has already
+    // entered the kernel and would pick this entry up after its next wakeup.
+    SubmitLocked();
+  }
+}
+
+int IoUringPoller::SubmitLocked() {
+  if (unsubmitted_ == 0) return 0;
+  int r;
+  do {
+    r = IoUringEnter(ring_.fd, unsubmitted_, 0, 0, nullptr, 0);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) {
+    // EAGAIN/EBUSY: the kernel is short on resources or the completion queue
+    // overflowed. The entries stay queued and are retried by the next
+    // submission or by the next call to Work().
+    gpr_log(GPR_ERROR, "io_uring_enter (submit) failed: %s",
+            grpc_core::StrError(errno).c_str());
+    return r;
+  }
+  unsubmitted_ = 0;
+  return r;
+}
+
+int IoUringPoller::HarvestCompletions() {
+  // Only the thread executing Work() consumes completions.
+  uint32_t head = *ring_.cq_head;
+  uint32_t tail = LoadAcquire(ring_.cq_tail);
+  int n = 0;
+  while (head != tail && n < MAX_IO_URING_EVENTS) {
+    struct io_uring_cqe* cqe = CqeAt(&ring_, head & ring_.cq_mask);
+    events_[n].user_data = cqe->user_data;
+    events_[n].res = cqe->res;
+    events_[n].flags = cqe->flags;
+    ++head;
+    ++n;
+  }
+  StoreRelease(ring_.cq_head, head);
+  num_events_ = n;
+  cursor_ = 0;
+  return n;
+}
+
+// Process the completions found by DoUringWait() function.
+// - cursor_ points to the index of the first completion to be processed
+// - This function then processes up-to max_events_to_handle and updates
+//   cursor_.
+// It returns true, it there was a Kick that forced invocation of this
+// function. It also returns the list of handles with pending actions.
+bool IoUringPoller::ProcessCompletions(int max_events_to_handle,
+                                       Events& pending_events) {
+  bool was_kicked = false;
+  for (int idx = 0; idx < max_events_to_handle && cursor_ != num_events_;
+       idx++) {
+    const Completion& c = events_[cursor_++];
+    bool more = (c.flags & IORING_CQE_F_MORE) != 0;
+    if (c.user_data == kWakeupTag) {
+      if (c.res > 0) {
+        GPR_ASSERT(wakeup_fd_->ConsumeWakeup().ok());
+        was_kicked = true;
+      }
+      if (!more) {
+        QueueRequest(IORING_OP_POLL_ADD, wakeup_fd_->ReadFd(), POLLIN, 0,
+                     kWakeupTag);
+      }
+      continue;
+    }
+    if (c.user_data == kRemoveTag) {
+      continue;
+    }
+    uint32_t index = static_cast<uint32_t>(c.user_data);
+    uint32_t generation = static_cast<uint32_t>(c.user_data >> 32);
+    if (index >= handles_.size()) {
+      continue;
+    }
+    IoUringEventHandle* handle = handles_[index];
+    if (handle->generation_ != generation) {
+      // The handle was orphaned after this completion was posted.
+      continue;
+    }
+    if (!more) {
+      // The multishot request was terminated by the kernel, e.g. because the
+      // completion queue overflowed. Re-arm it.
+      QueueRequest(IORING_OP_POLL_ADD, handle->fd_, kHandlePollMask, 0,
+                   handle->UserData());
+    }
+    uint32_t revents;
+    if (c.res >= 0) {
+      revents = static_cast<uint32_t>(c.res);
+    } else if (c.res == -ECANCELED) {
+      continue;
+    } else {
+      revents = POLLERR;
+    }
+    bool track_err = handle->track_err_;
+    bool cancel = (revents & POLLHUP) != 0;
+    bool error = (revents & POLLERR) != 0;
+    bool read_ev = (revents & (POLLIN | POLLPRI)) != 0;
+    bool write_ev = (revents & POLLOUT) != 0;
+    bool err_fallback = error && !track_err;
+    if (handle->SetPendingActions(read_ev || cancel || err_fallback,
+                                  write_ev || cancel || err_fallback,
+                                  error && !err_fallback)) {
+      pending_events.push_back(handle);
+    }
+  }
+  return was_kicked;
+}
+
+// Submit all queued entries and wait for completions. This does not "process"
+// any of the completions yet; that is done in ProcessCompletions(). It returns
+// the number of completions harvested.
+int IoUringPoller::DoUringWait(EventEngine::Duration timeout) {
+  uint32_t to_submit;
+  {
+    grpc_core::MutexLock lock(&sq_mu_);
+    to_submit = unsubmitted_;
+    unsubmitted_ = 0;
+    in_wait_ = true;
+  }
+  struct __kernel_timespec ts;
+  int64_t timeout_ns = std::max<int64_t>(
+      0, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+  ts.tv_sec = timeout_ns / GPR_NS_PER_SEC;
+  ts.tv_nsec = timeout_ns % GPR_NS_PER_SEC;
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.ts = reinterpret_cast<uint64_t>(&ts);
+  int r;
+  do {
+    r = IoUringEnter(ring_.fd, to_submit, timeout_ns > 0 ? 1 : 0,
+                     IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                     sizeof(arg));
+    // Entries that were submitted before the wait got interrupted are not
+    // submitted again: the kernel only consumes what is in the queue.
+  } while (r < 0 && errno == EINTR);
+  int err = errno;
+  {
+    grpc_core::MutexLock lock(&sq_mu_);
+    in_wait_ = false;
+    if (r < 0 && err != ETIME) {
+      // Nothing was submitted, put the entries back.
+      unsubmitted_ += to_submit;
+    } else if (r >= 0 && static_cast<uint32_t>(r) < to_submit) {
+      // The kernel stopped short, e.g. on an invalid entry or for lack of
+      // memory. The rest is still in the queue: submit it next time.
+      unsubmitted_ += to_submit - r;
+    }
+  }
+  if (r < 0 && err != ETIME && err != EAGAIN && err != EBUSY) {
+    grpc_core::Crash(absl::StrFormat(
+        "(event_engine) IoUringPoller:%p encountered io_uring_enter error: %s",
+        this, grpc_core::StrError(err).c_str()));
+  }
+  return HarvestCompletions();
+}
+
+// Might be called multiple times
+void IoUringEventHandle::ShutdownHandle(absl::Status why) {
+  // See Epoll1EventHandle::ShutdownHandle for explanation on why a mutex is
+  // required here.
+  grpc_core::MutexLock lock(&mu_);
+  HandleShutdownInternal(why);
+}
+
+bool IoUringEventHandle::IsHandleShutdown() {
+  return read_closure_->IsShutdown();
+}
+
+void IoUringEventHandle::NotifyOnRead(PosixEngineClosure* on_read) {
+  read_closure_->NotifyOn(on_read);
+}
+
+void IoUringEventHandle::NotifyOnWrite(PosixEngineClosure* on_write) {
+  write_closure_->NotifyOn(on_write);
+}
+
+void IoUringEventHandle::NotifyOnError(PosixEngineClosure* on_error) {
+  error_closure_->NotifyOn(on_error);
+}
+
+void IoUringEventHandle::SetReadable() { read_closure_->SetReady(); }
+
+void IoUringEventHandle::SetWritable() { write_closure_->SetReady(); }
+
+void IoUringEventHandle::SetHasError() { error_closure_->SetReady(); }
+
+// Polls the registered Fds for events until timeout is reached or there is a
+// Kick(). If there is a Kick(), it collects and processes any previously
+// un-processed events. If there are no un-processed events, it returns
+// Poller::WorkResult::Kicked{}
+Poller::WorkResult IoUringPoller::Work(
+    EventEngine::Duration timeout,
+    absl::FunctionRef<void()> schedule_poll_again) {
+  Events pending_events;
+  bool was_kicked_ext = false;
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;) {
+    if (cursor_ == num_events_) {
+      if (DoUringWait(deadline - std::chrono::steady_clock::now()) == 0) {
+        return Poller::WorkResult::kDeadlineExceeded;
+      }
+    }
+    grpc_core::MutexLock lock(&mu_);
+    // If was_kicked_ is true, collect all pending events in this iteration.
+    if (ProcessCompletions(was_kicked_
+                               ? INT_MAX
+                               : MAX_IO_URING_EVENTS_HANDLED_PER_ITERATION,
+                           pending_events)) {
+      was_kicked_ = false;
+      was_kicked_ext = true;
+    }
+    if (was_kicked_ext) {
+      if (pending_events.empty()) {
+        return Poller::WorkResult::kKicked;
+      }
+      break;
+    }
+    // Completions for cancelled or stale requests carry no events. Unlike
+    // epoll, they must not be reported as a kick, so poll again instead.
+    if (!pending_events.empty()) {
+      break;
+    }
+  }
+  // Run the provided callback.
+  schedule_poll_again();
+  // Process all pending events inline.
+  for (auto& it : pending_events) {
+    it->ExecutePendingActions();
+  }
+  return was_kicked_ext ? Poller::WorkResult::kKicked : Poller::WorkResult::kOk;
+}
+
+void IoUringPoller::Kick() {
+  grpc_core::MutexLock lock(&mu_);
+  if (was_kicked_ || closed_) {
+    return;
+  }
+  was_kicked_ = true;
+  GPR_ASSERT(wakeup_fd_->Wakeup().ok());
+}
+
+bool IoUringPoller::IsSupported() {
+  static const bool kIoUringPollerSupported =
+      SupportsWakeupFd() && ProbeMultishotPoll();
+  return kIoUringPollerSupported;
+}
+
+IoUringPoller* MakeIoUringPoller(Scheduler* scheduler) {
+  // The io_uring instance is shared with a forked child, which would then
+  // receive completions for the parent's fds. Use epoll1 instead.
+  if (grpc_core::Fork::Enabled()) {
+    return nullptr;
+  }
+  if (IoUringPoller::IsSupported()) {
+    return new IoUringPoller(scheduler);
+  }
+  return nullptr;
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#else  // defined(GRPC_LINUX_IO_URING)
+
+namespace grpc_event_engine {
+namespace experimental {
+
+bool IoUringPoller::IsSupported() { return false; }
+
+// If GRPC_LINUX_IO_URING is not defined, it means io_uring is not available.
+// Return nullptr.
+IoUringPoller* MakeIoUringPoller(Scheduler* /*scheduler*/) { return nullptr; }
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // !defined(GRPC_LINUX_IO_URING)
@@ -0,0 +1,174 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
+#define GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/internal_errqueue.h"
+#include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/port.h"
+
+#define MAX_IO_URING_EVENTS 100
+
+namespace grpc_event_engine {
+namespace experimental {
+
+class IoUringEventHandle;
+
+// Definition of an io_uring based poller.
+//
+// Every handle is watched with a single multishot IORING_OP_POLL_ADD request,
+// so a readiness notification never has to be re-armed from user space.
+// Submission queue entries (arming a new handle, removing an orphaned one) are
+// queued without a syscall and are flushed by the io_uring_enter() call that
+// Work() makes to wait for completions. Entries are only submitted eagerly when
+// a thread is already blocked inside Work(), since that thread would otherwise
+// not observe them until its next wakeup, or when the handle they remove is
+// about to give up its fd.
+//
+// This is a readiness poller only: the posix endpoint and listener still
+// issue their own recvmsg/sendmsg/accept calls once a handle is readable or
+// writable. Completion based I/O through the ring (reads into provided buffer
+// rings, writes and multishot accept) needs its own endpoint and listener,
+// and is not implemented yet.
+class IoUringPoller : public PosixEventPoller {
+ public:
+  explicit IoUringPoller(Scheduler* scheduler);
+  EventHandle* CreateHandle(int fd, absl::string_view name,
+                            bool track_err) override;
+  Poller::WorkResult Work(
+      grpc_event_engine::experimental::EventEngine::Duration timeout,
+      absl::FunctionRef<void()> schedule_poll_again) override;
+  std::string Name() override { return "io_uring"; }
+  void Kick() override;
+  Scheduler* GetScheduler() { return scheduler_; }
+  void Shutdown() override;
+  bool CanTrackErrors() const override {
+#ifdef GRPC_POSIX_SOCKET_TCP
+    return KernelSupportsErrqueue();
+#else
+    return false;
+#endif
+  }
+  ~IoUringPoller() override;
+
+  // Returns true if the running kernel supports everything this poller needs:
+  // IORING_FEAT_EXT_ARG (timed waits) and multishot poll requests (5.13+).
+  static bool IsSupported();
+
+  // Memory shared with the kernel. Pointers are into the mmap'ed rings.
+  struct Ring {
+    int fd = -1;
+    void* sq_ring_ptr = nullptr;
+    size_t sq_ring_size = 0;
+    void* cq_ring_ptr = nullptr;
+    size_t cq_ring_size = 0;
+    void* sqes_ptr = nullptr;
+    size_t sqes_size = 0;
+    uint32_t* sq_head = nullptr;
+    uint32_t* sq_tail = nullptr;
+    uint32_t sq_mask = 0;
+    uint32_t sq_entries = 0;
+    uint32_t* sq_array = nullptr;
+    uint32_t* cq_head = nullptr;
+    uint32_t* cq_tail = nullptr;
+    uint32_t cq_mask = 0;
+    void* cqes = nullptr;
+  };
+
+ private:
+  friend class IoUringEventHandle;
+  // This initial vector size may need to be tuned
+  using Events = absl::InlinedVector<IoUringEventHandle*, 5>;
+  // A completion copied out of the completion queue ring.
+  struct Completion {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+  };
+
+  // Fill in one submission queue entry. Flushes the submission queue first if
+  // it is full. If submit_now is set or a thread is currently blocked in
+  // Work(), the entry is submitted immediately, otherwise it is left for the
+  // next Work() call.
+  void QueueRequest(uint8_t opcode, int fd, uint32_t poll_mask, uint64_t addr,
+                    uint64_t user_data, bool submit_now = false)
+      ABSL_LOCKS_EXCLUDED(sq_mu_);
+  int SubmitLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sq_mu_);
+  // Process the completions found by DoUringWait() function.
+  // - cursor_ points to the index of the first completion to be processed
+  // - This function then processes up-to max_events_to_handle and updates
+  //   cursor_.
+  // It returns true, it there was a Kick that forced invocation of this
+  // function. It also returns the list of handles with pending actions.
+  bool ProcessCompletions(int max_events_to_handle, Events& pending_events)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Submit all queued entries, wait for at least one completion (or until the
+  // timeout expires) and copy the completions into events_. It returns the
+  // number of completions harvested.
+  int DoUringWait(
+      grpc_event_engine::experimental::EventEngine::Duration timeout);
+  int HarvestCompletions();
+  void Close();
+
+  grpc_core::Mutex mu_;
+  Scheduler* scheduler_;
+  Ring ring_;
+  // Completions harvested by the last DoUringWait().
+  Completion events_[MAX_IO_URING_EVENTS];
+  int num_events_ = 0;
+  int cursor_ = 0;
+  bool was_kicked_ ABSL_GUARDED_BY(mu_);
+  // All handles ever created by this poller, indexed by the low 32 bits of the
+  // user_data of their poll requests. Handles are never deleted before the
+  // poller is closed, so that stale completions can be safely discarded.
+  std::vector<IoUringEventHandle*> handles_ ABSL_GUARDED_BY(mu_);
+  std::list<IoUringEventHandle*> free_handles_list_ ABSL_GUARDED_BY(mu_);
+  std::unique_ptr<WakeupFd> wakeup_fd_;
+  // Protects the submission queue tail.
+  grpc_core::Mutex sq_mu_;
+  // Number of entries written to the submission queue but not yet submitted.
+  uint32_t unsubmitted_ ABSL_GUARDED_BY(sq_mu_) = 0;
+  // True while a thread is blocked inside DoUringWait().
+  bool in_wait_ ABSL_GUARDED_BY(sq_mu_) = false;
+  bool closed_;
+};
+
+// Return an instance of an io_uring based poller tied to the specified
+// scheduler. It returns nullptr if the kernel does not support io_uring (or
+// if io_uring is disabled by a seccomp policy), or if fork support is enabled.
+IoUringPoller* MakeIoUringPoller(Scheduler* scheduler);
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_IO_URING_LINUX_H
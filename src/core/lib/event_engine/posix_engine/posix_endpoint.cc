@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <string.h>
 
 #include <algorithm>
 #include <cctype>
@@ -64,6 +65,10 @@
 #include <sys/prctl.h>         // IWYU pragma: keep
 #include <sys/resource.h>      // IWYU pragma: keep
 #endif
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#include <sys/mman.h>  // IWYU pragma: keep
+#include <unistd.h>    // IWYU pragma: keep
+#endif
 #include <netinet/in.h>  // IWYU pragma: keep
 
 #ifndef SOL_TCP
@@ -90,6 +95,12 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
 #define MAX_READ_IOVEC 64
 
 namespace grpc_event_engine {
@@ -210,6 +221,27 @@ bool CmsgIsZeroCopy(const cmsghdr& cmsg) {
 }
 #endif  // GRPC_LINUX_ERRQUEUE
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+// The leading fields of struct tcp_zerocopy_receive, which older libc headers
+// do not define. The kernel accepts any prefix of the struct that includes
+// the length field.
+struct TcpZerocopyReceiveArgs {
+  uint64_t address;
+  uint32_t length;
+  uint32_t recv_skip_hint;
+};
+
+// The size of the address space each endpoint reserves for mapping received
+// pages into, and so the largest single zerocopy read. Pages stay mapped
+// until their range of the window is reused or the window is unmapped, so
+// this also bounds the received memory an idle endpoint keeps pinned.
+constexpr size_t kRxZerocopyWindowSize = 8 * 1024 * 1024;
+
+void UnrefReceiveWindow(void* window) {
+  static_cast<TcpZerocopyReceiveWindow*>(window)->Unref();
+}
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
 absl::Status PosixOSError(int error_no, const char* call_name) {
   absl::Status s = absl::UnknownError(grpc_core::StrError(error_no));
   grpc_core::StatusSetInt(&s, grpc_core::StatusIntProperty::kErrorNo, error_no);
@@ -222,6 +254,22 @@ absl::Status PosixOSError(int error_no, const char* call_name) {
 
 }  // namespace
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+TcpZerocopyReceiveWindow* TcpZerocopyReceiveWindow::Create(int fd,
+                                                           size_t size) {
+  void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) return nullptr;
+  return new TcpZerocopyReceiveWindow(static_cast<char*>(base), size);
+}
+
+void TcpZerocopyReceiveWindow::Unref() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    munmap(base_, size_);
+    delete this;
+  }
+}
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
 #if defined(IOV_MAX) && IOV_MAX < 260
 #define MAX_WRITE_IOVEC IOV_MAX
 #else
@@ -317,6 +365,38 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
   GPR_ASSERT(incoming_buffer_->Length() != 0);
   GPR_DEBUG_ASSERT(min_progress_size_ > 0);
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  // If a large read is expected, try to map the data at the head of the
+  // receive queue instead of copying it into incoming_buffer_. Mapped data is
+  // staged in last_read_buffer_, which only ever holds data read earlier in
+  // this same Read() while frame size tuning is waiting for more bytes.
+  // Data the kernel has said cannot be mapped (see recv_skip_hint) is copied
+  // first, and reads shorter than a page are never mapped.
+  static const int kPageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+  const int expected_bytes = std::max(inq_, min_progress_size_);
+  if (rx_zerocopy_enabled_ && rx_zerocopy_skip_bytes_ == 0 &&
+      expected_bytes >= std::max(rx_zerocopy_threshold_, kPageSize)) {
+    const size_t mapped_bytes = TcpZerocopyReceive(
+        std::min(expected_bytes, max_read_chunk_size_), last_read_buffer_);
+    if (mapped_bytes > 0) {
+      // We no longer know how much is queued on the socket.
+      inq_ = 1;
+      if (!grpc_core::IsTcpFrameSizeTuningEnabled() ||
+          static_cast<size_t>(min_progress_size_) <= mapped_bytes) {
+        // Hand the mapped data to the caller. incoming_buffer_ holds only
+        // unused space, which is kept for the next read.
+        status = absl::OkStatus();
+        min_progress_size_ = 1;
+        incoming_buffer_->Swap(last_read_buffer_);
+        return true;
+      }
+      // Copy whatever else is queued, after the mapped data.
+      min_progress_size_ -= mapped_bytes;
+      read_hint_bytes_ = min_progress_size_;
+    }
+  }
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
   do {
     // Assume there is something on the queue. If we receive TCP_INQ from
     // kernel, we will update this value, otherwise, we have to assume there is
@@ -421,6 +501,12 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
 
   GPR_DEBUG_ASSERT(total_read_bytes > 0);
   status = absl::OkStatus();
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  rx_zerocopy_skip_bytes_ -=
+      std::min(rx_zerocopy_skip_bytes_, total_read_bytes);
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  read_hint_bytes_ =
+      std::max(read_hint_bytes_ - static_cast<int>(total_read_bytes), 1);
   if (grpc_core::IsTcpFrameSizeTuningEnabled()) {
     // Update min progress size based on the total number of bytes read in
     // this round.
@@ -454,6 +540,71 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
   return true;
 }
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+// Maps up to length bytes from the head of the socket's receive queue with
+// TCP_ZEROCOPY_RECEIVE and appends them to buf as a single slice pointing into
+// rx_zerocopy_window_. Only whole pages can be mapped, so this returns 0 if
+// the data at the head of the queue has to be copied, for example because it
+// is not page aligned. In that case the kernel reports how many bytes to copy
+// before trying again, which is recorded in rx_zerocopy_skip_bytes_.
+size_t PosixEndpointImpl::TcpZerocopyReceive(size_t length, SliceBuffer& buf) {
+  static const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  length = std::min(length, kRxZerocopyWindowSize);
+  length -= length % kPageSize;
+  if (length == 0) return 0;
+  if (rx_zerocopy_window_ != nullptr &&
+      rx_zerocopy_window_->remaining() < length) {
+    if (rx_zerocopy_window_->Unused()) {
+      // Every slice mapped into the window has been released, so its pages
+      // can be mapped over again.
+      rx_zerocopy_window_->Rewind();
+    } else {
+      // Leave the window to the slices still using it; the last one to be
+      // released unmaps it.
+      rx_zerocopy_window_->Unref();
+      rx_zerocopy_window_ = nullptr;
+    }
+  }
+  if (rx_zerocopy_window_ == nullptr) {
+    rx_zerocopy_window_ =
+        TcpZerocopyReceiveWindow::Create(fd_, kRxZerocopyWindowSize);
+    if (rx_zerocopy_window_ == nullptr) {
+      gpr_log(GPR_INFO, "Disabling TCP RX zerocopy on fd %d: mmap: %s", fd_,
+              grpc_core::StrError(errno).c_str());
+      rx_zerocopy_enabled_ = false;
+      return 0;
+    }
+  }
+  char* addr = rx_zerocopy_window_->next();
+  TcpZerocopyReceiveArgs zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uintptr_t>(addr);
+  zc.length = static_cast<uint32_t>(length);
+  socklen_t zc_len = sizeof(zc);
+  int err;
+  do {
+    err = getsockopt(fd_, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (err < 0 && errno == EINTR);
+  if (err < 0) {
+    if (errno != EAGAIN) {
+      gpr_log(GPR_INFO,
+              "Disabling TCP RX zerocopy on fd %d: TCP_ZEROCOPY_RECEIVE: %s",
+              fd_, grpc_core::StrError(errno).c_str());
+      rx_zerocopy_enabled_ = false;
+    }
+    return 0;
+  }
+  rx_zerocopy_skip_bytes_ = zc.recv_skip_hint;
+  const size_t mapped = zc.length;
+  if (mapped == 0) return 0;
+  rx_zerocopy_window_->Advance(mapped);
+  rx_zerocopy_window_->Ref();
+  buf.Append(Slice(grpc_slice_new_with_user_data(
+      addr, mapped, UnrefReceiveWindow, rx_zerocopy_window_)));
+  return mapped;
+}
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
 void PosixEndpointImpl::PerformReclamation() {
   read_mu_.Lock();
   if (incoming_buffer_ != nullptr) {
@@ -521,6 +672,26 @@ void PosixEndpointImpl::UpdateRcvLowat() {
 void PosixEndpointImpl::MaybeMakeReadSlices() {
   static const int kBigAlloc = 64 * 1024;
   static const int kSmallAlloc = 8 * 1024;
+  // Upper bound on a single slice sized from the caller's read hint. The
+  // chttp2 transport never hints more than the largest frame it accepts.
+  static const size_t kMaxHintedAlloc = 16 * 1024 * 1024;
+  // incoming_buffer_ only holds spare space here: bytes read earlier in this
+  // Read() are staged in last_read_buffer_ and already deducted from
+  // read_hint_bytes_, which counts the bytes still expected.
+  const size_t spare = incoming_buffer_->Length();
+  const size_t hinted_length =
+      std::min(static_cast<size_t>(read_hint_bytes_), kMaxHintedAlloc);
+  // The caller knows how many bytes it expects (e.g. the rest of an HTTP/2
+  // frame). Read them into one contiguous slice rather than a chain of small
+  // ones the upper layers would have to reassemble. recvmsg() fills the
+  // spare space in order, so that slice goes first unless the first spare
+  // slice is already big enough.
+  if (hinted_length >= static_cast<size_t>(kSmallAlloc * 3 / 2) &&
+      (incoming_buffer_->Count() == 0 ||
+       (*incoming_buffer_)[0].length() < hinted_length) &&
+      memory_owner_.GetPressureInfo().pressure_control_value < 0.8) {
+    incoming_buffer_->Prepend(Slice(memory_owner_.MakeSlice(hinted_length)));
+  }
   if (incoming_buffer_->Length() < std::max<size_t>(min_progress_size_, 1)) {
     size_t allocate_length = min_progress_size_;
     const size_t target_length = static_cast<size_t>(target_length_);
@@ -547,6 +718,8 @@ void PosixEndpointImpl::MaybeMakeReadSlices() {
             Slice(memory_owner_.MakeSlice(kSmallAlloc)));
       }
     }
+  }
+  if (incoming_buffer_->Length() > spare) {
     MaybePostReclaimer();
   }
 }
@@ -597,9 +770,13 @@ bool PosixEndpointImpl::Read(absl::AnyInvocable<void(absl::Status)> on_read,
   incoming_buffer_ = buffer;
   incoming_buffer_->Clear();
   incoming_buffer_->Swap(last_read_buffer_);
-  if (args != nullptr && grpc_core::IsTcpFrameSizeTuningEnabled()) {
-    min_progress_size_ = std::max(static_cast<int>(args->read_hint_bytes), 1);
+  if (grpc_core::IsTcpFrameSizeTuningEnabled()) {
+    read_hint_bytes_ =
+        args != nullptr ? std::max(static_cast<int>(args->read_hint_bytes), 1)
+                        : 1;
+    min_progress_size_ = read_hint_bytes_;
   } else {
+    read_hint_bytes_ = 1;
     min_progress_size_ = 1;
   }
   Ref().release();
@@ -1228,6 +1405,9 @@ PosixEndpointImpl ::~PosixEndpointImpl() {
   delete on_read_;
   delete on_write_;
   delete on_error_;
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  if (rx_zerocopy_window_ != nullptr) rx_zerocopy_window_->Unref();
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
 }
 
 PosixEndpointImpl::PosixEndpointImpl(EventHandle* handle,
@@ -1307,6 +1487,10 @@ PosixEndpointImpl::PosixEndpointImpl(EventHandle* handle,
 #else
   inq_capable_ = false;
 #endif  // GRPC_HAVE_TCP_INQ
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  rx_zerocopy_enabled_ = options.tcp_rx_zero_copy_enabled;
+  rx_zerocopy_threshold_ = options.tcp_rx_zerocopy_recv_bytes_threshold;
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
 
   on_read_ = PosixEngineClosure::ToPermanentClosure(
       [this](absl::Status status) { HandleRead(std::move(status)); });
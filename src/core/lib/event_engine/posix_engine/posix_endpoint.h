@@ -464,6 +464,40 @@ class TcpZerocopySendCtx {
   OptMemState zcopy_enobuf_state_ ABSL_GUARDED_BY(mu_) = OptMemState::kOpen;
 };
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+// A range of address space, mapped over a socket, that TCP_ZEROCOPY_RECEIVE
+// maps received pages into. An endpoint maps consecutive reads into
+// consecutive parts of the window, so that it does not have to mmap and
+// munmap around every read. Each slice handed out holds a ref, as does the
+// endpoint while the window is current; the window is unmapped when the last
+// ref is dropped.
+class TcpZerocopyReceiveWindow {
+ public:
+  // Returns nullptr, with errno set, if the window cannot be mapped.
+  static TcpZerocopyReceiveWindow* Create(int fd, size_t size);
+
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+  void Unref();
+  // True if only the endpoint refers to the window.
+  bool Unused() const { return refs_.load(std::memory_order_acquire) == 1; }
+
+  char* next() const { return base_ + offset_; }
+  size_t remaining() const { return size_ - offset_; }
+  void Advance(size_t bytes) { offset_ += bytes; }
+  void Rewind() { offset_ = 0; }
+
+ private:
+  TcpZerocopyReceiveWindow(char* base, size_t size)
+      : base_(base), size_(size) {}
+
+  char* const base_;
+  const size_t size_;
+  // Only touched by the endpoint, under its read lock.
+  size_t offset_ = 0;
+  std::atomic<size_t> refs_{1};
+};
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+
 class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
  public:
   PosixEndpointImpl(
@@ -508,6 +542,11 @@ class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
   void MaybeMakeReadSlices() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
   bool TcpDoRead(absl::Status& status) ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  size_t TcpZerocopyReceive(size_t length,
+                            grpc_event_engine::experimental::SliceBuffer& buf)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
   void FinishEstimate();
   void AddToEstimate(size_t bytes);
   void MaybePostReclaimer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
@@ -592,9 +631,26 @@ class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
   std::atomic<bool> stop_error_notification_{false};
   std::unique_ptr<TcpZerocopySendCtx> tcp_zerocopy_send_ctx_;
   TcpZerocopySendRecord* current_zerocopy_send_ = nullptr;
+  // True if large reads should try to map received pages with
+  // TCP_ZEROCOPY_RECEIVE. Cleared if the kernel turns out not to support it.
+  bool rx_zerocopy_enabled_ = false;
+  // Reads expected to be smaller than this are always copied.
+  int rx_zerocopy_threshold_ = PosixTcpOptions::kDefaultRecvBytesThreshold;
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  // Where received pages are currently being mapped.
+  TcpZerocopyReceiveWindow* rx_zerocopy_window_ = nullptr;
+  // Bytes at the head of the receive queue that the kernel said cannot be
+  // mapped and must be copied before zerocopy is worth trying again.
+  size_t rx_zerocopy_skip_bytes_ = 0;
+#endif  // GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
   // A hint from upper layers specifying the minimum number of bytes that need
   // to be read to make meaningful progress.
   int min_progress_size_ = 1;
+  // The number of bytes the upper layer expects the current Read() to
+  // deliver, used to size read buffers. Like min_progress_size_ it is only
+  // taken from the caller with frame size tuning enabled, but it shrinks as
+  // bytes arrive rather than gating when the read completes.
+  int read_hint_bytes_ = 1;
   TracedBufferList traced_buffers_;
   // The handle is owned by the PosixEndpointImpl object.
   EventHandle* handle_;
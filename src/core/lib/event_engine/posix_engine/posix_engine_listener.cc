@@ -25,10 +25,12 @@
 #include <unistd.h>      // IWYU pragma: keep
 
 #include <atomic>
+#include <iterator>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
@@ -102,10 +104,13 @@ absl::StatusOr<int> PosixEngineListenerImpl::Bind(
   // Update the callback. Any subsequent new sockets created and added to
   // acceptors_ in this function will invoke the new callback.
   acceptors_.UpdateOnAppendCallback(std::move(on_bind_new_fd));
+  const int first_new_socket = acceptors_.Size();
   if (used_port.has_value()) {
     requested_port = *used_port;
-    return ListenerContainerAddWildcardAddresses(acceptors_, options_,
-                                                 requested_port);
+    auto port = ListenerContainerAddWildcardAddresses(acceptors_, options_,
+                                                      requested_port);
+    if (port.ok()) AddReusePortSiblings(first_new_socket);
+    return port;
   }
   if (ResolvedAddressToV4Mapped(res_addr, &addr6_v4mapped)) {
     res_addr = addr6_v4mapped;
@@ -114,9 +119,30 @@ absl::StatusOr<int> PosixEngineListenerImpl::Bind(
   auto result = CreateAndPrepareListenerSocket(options_, res_addr);
   GRPC_RETURN_IF_ERROR(result.status());
   acceptors_.Append(*result);
+  AddReusePortSiblings(first_new_socket);
   return result->port;
 }
 
+void PosixEngineListenerImpl::AddReusePortSiblings(int first_new_socket) {
+  // Adding siblings appends to acceptors_, so collect the sockets first.
+  std::vector<ListenerSocketsContainer::ListenerSocket> sockets;
+  auto it = acceptors_.begin();
+  std::advance(it, first_new_socket);
+  for (; it != acceptors_.end(); ++it) {
+    sockets.push_back((*it)->Socket());
+  }
+  for (const auto& socket : sockets) {
+    auto status =
+        ListenerContainerAddReusePortSiblings(acceptors_, options_, socket);
+    if (!status.ok()) {
+      // The sockets already listening keep working, only with fewer accept
+      // queues than requested.
+      gpr_log(GPR_ERROR, "Failed to add SO_REUSEPORT listeners: %s",
+              status.ToString().c_str());
+    }
+  }
+}
+
 void PosixEngineListenerImpl::AsyncConnectionAcceptor::Start() {
   Ref();
   handle_->NotifyOnRead(notify_on_accept_);
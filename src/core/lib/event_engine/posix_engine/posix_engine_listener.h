@@ -174,6 +174,13 @@ class PosixEngineListenerImpl
   };
   friend class ListenerAsyncAcceptors;
   friend class AsyncConnectionAcceptor;
+  // Opens the extra SO_REUSEPORT sockets requested by
+  // options_.reuse_port_listeners for every socket added to acceptors_ from
+  // index first_new_socket onwards. Each socket gets its own acceptor and
+  // poller handle, so bursts of connections are accepted from several fds in
+  // parallel instead of serializing on one.
+  void AddReusePortSiblings(int first_new_socket)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   // The mutex ensures thread safety when multiple threads try to call Bind
   // and Start in parallel.
   grpc_core::Mutex mu_;
@@ -349,6 +349,42 @@ absl::StatusOr<int> ListenerContainerAddWildcardAddresses(
   }
 }
 
+absl::Status ListenerContainerAddReusePortSiblings(
+    ListenerSocketsContainer& listener_sockets, const PosixTcpOptions& options,
+    const ListenerSocket& socket) {
+  if (options.reuse_port_listeners <= 1 || !options.allow_reuse_port ||
+      !PosixSocketWrapper::IsSocketReusePortSupported() ||
+      socket.addr.address()->sa_family == AF_UNIX ||
+      ResolvedAddressIsVSock(socket.addr)) {
+    return absl::OkStatus();
+  }
+  // The socket may have been bound to port 0; its siblings must join the
+  // port that was picked for it.
+  ResolvedAddress addr = socket.addr;
+  ResolvedAddressSetPort(addr, socket.port);
+  absl::Status status;
+  int num_sockets = 1;
+  for (; num_sockets < options.reuse_port_listeners; ++num_sockets) {
+    auto sibling = CreateAndPrepareListenerSocket(options, addr);
+    if (!sibling.ok()) {
+      status = sibling.status();
+      break;
+    }
+    listener_sockets.Append(*sibling);
+  }
+  if (options.reuse_port_cpu_steering && num_sockets > 1) {
+    // Without the program, the kernel picks a socket by hashing the 4-tuple,
+    // so failing to attach it is not fatal.
+    PosixSocketWrapper sock = socket.sock;
+    auto steering_status = sock.SetSocketReusePortCpuSteering(num_sockets);
+    if (!steering_status.ok()) {
+      gpr_log(GPR_INFO, "Not steering connections by CPU: %s",
+              steering_status.ToString().c_str());
+    }
+  }
+  return status;
+}
+
 #else  // GRPC_POSIX_SOCKET_UTILS_COMMON
 
 absl::StatusOr<ListenerSocketsContainer::ListenerSocket>
@@ -375,6 +411,15 @@ absl::StatusOr<int> ListenerContainerAddAllLocalAddresses(
       "platform");
 }
 
+absl::Status ListenerContainerAddReusePortSiblings(
+    ListenerSocketsContainer& /*listener_sockets*/,
+    const PosixTcpOptions& /*options*/,
+    const ListenerSocketsContainer::ListenerSocket& /*socket*/) {
+  grpc_core::Crash(
+      "ListenerContainerAddReusePortSiblings is not supported on this "
+      "platform");
+}
+
 #endif  // GRPC_POSIX_SOCKET_UTILS_COMMON
 
 }  // namespace experimental
@@ -85,6 +85,18 @@ absl::StatusOr<int> ListenerContainerAddAllLocalAddresses(
     ListenerSocketsContainer& listener_sockets, const PosixTcpOptions& options,
     int requested_port);
 
+// Creates options.reuse_port_listeners - 1 more sockets listening on the same
+// address and port as the passed socket, and adds them to the passed
+// ListenerSocketsContainer object, so that the kernel spreads incoming
+// connections over the accept queues of all of them. If
+// options.reuse_port_cpu_steering is set, each connection goes to the socket
+// matching the CPU that received it. Does nothing unless SO_REUSEPORT is
+// allowed and applies to the socket. If a sibling cannot be created, the ones
+// created so far are kept and a Not-OK status is returned.
+absl::Status ListenerContainerAddReusePortSiblings(
+    ListenerSocketsContainer& listener_sockets, const PosixTcpOptions& options,
+    const ListenerSocketsContainer::ListenerSocket& socket);
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
 
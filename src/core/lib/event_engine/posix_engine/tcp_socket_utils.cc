@@ -20,6 +20,8 @@
 #include <inttypes.h>
 #include <limits.h>
 
+#include <algorithm>
+
 #include "absl/cleanup/cleanup.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -28,6 +30,7 @@
 
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/channel_arg_names.h>
+#include <grpc/support/cpu.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/crash.h"  // IWYU pragma: keep
@@ -43,6 +46,9 @@
 #include <netinet/tcp.h>
 #endif
 #include <fcntl.h>
+#ifdef GRPC_LINUX_REUSEPORT_CBPF
+#include <linux/filter.h>
+#endif
 #include <sys/socket.h>
 #include <unistd.h>
 #endif  //  GRPC_POSIX_SOCKET_UTILS_COMMON
@@ -179,6 +185,12 @@ PosixTcpOptions TcpOptionsFromEndpointConfig(const EndpointConfig& config) {
   options.tcp_tx_zero_copy_enabled =
       (AdjustValue(PosixTcpOptions::kZerocpTxEnabledDefault, 0, 1,
                    config.GetInt(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) != 0);
+  options.tcp_rx_zerocopy_recv_bytes_threshold =
+      AdjustValue(PosixTcpOptions::kDefaultRecvBytesThreshold, 0, INT_MAX,
+                  config.GetInt(GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD));
+  options.tcp_rx_zero_copy_enabled =
+      (AdjustValue(PosixTcpOptions::kZerocpRxEnabledDefault, 0, 1,
+                   config.GetInt(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) != 0);
   options.keep_alive_time_ms =
       AdjustValue(0, 1, INT_MAX, config.GetInt(GRPC_ARG_KEEPALIVE_TIME_MS));
   options.keep_alive_timeout_ms =
@@ -195,6 +207,17 @@ PosixTcpOptions TcpOptionsFromEndpointConfig(const EndpointConfig& config) {
         (AdjustValue(0, 1, INT_MAX, config.GetInt(GRPC_ARG_ALLOW_REUSEPORT)) !=
          0);
   }
+  options.reuse_port_listeners =
+      AdjustValue(1, 0, PosixTcpOptions::kMaxReusePortListeners,
+                  config.GetInt(GRPC_ARG_REUSEPORT_LISTENERS));
+  if (options.reuse_port_listeners == 0) {
+    options.reuse_port_listeners =
+        std::min(static_cast<int>(gpr_cpu_num_cores()),
+                 PosixTcpOptions::kMaxReusePortListeners);
+  }
+  options.reuse_port_cpu_steering =
+      (AdjustValue(0, 0, 1, config.GetInt(GRPC_ARG_REUSEPORT_CPU_STEERING)) !=
+       0);
   if (options.tcp_min_read_chunk_size > options.tcp_max_read_chunk_size) {
     options.tcp_min_read_chunk_size = options.tcp_max_read_chunk_size;
   }
@@ -480,6 +503,32 @@ absl::Status PosixSocketWrapper::SetSocketReusePort(int reuse) {
 #endif
 }
 
+absl::Status PosixSocketWrapper::SetSocketReusePortCpuSteering(
+    int num_sockets) {
+#ifndef GRPC_LINUX_REUSEPORT_CBPF
+  (void)num_sockets;
+  return absl::Status(absl::StatusCode::kUnimplemented,
+                      "SO_ATTACH_REUSEPORT_CBPF unavailable on compiling system");
+#else
+  // A = raw_smp_processor_id() % num_sockets; return A. The kernel falls back
+  // to hashing if A is not a valid index into the group.
+  struct sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(num_sockets)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog prog = {sizeof(code) / sizeof(code[0]), code};
+  if (0 != setsockopt(fd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog,
+                      sizeof(prog))) {
+    return absl::Status(absl::StatusCode::kInternal,
+                        absl::StrCat("setsockopt(SO_ATTACH_REUSEPORT_CBPF): ",
+                                     grpc_core::StrError(errno)));
+  }
+  return absl::OkStatus();
+#endif
+}
+
 bool PosixSocketWrapper::IsSocketReusePortSupported() {
   static bool kSupportSoReusePort = []() -> bool {
     int s = socket(AF_INET, SOCK_STREAM, 0);
@@ -836,6 +885,11 @@ absl::Status PosixSocketWrapper::SetSocketReusePort(int /*reuse*/) {
   grpc_core::Crash("unimplemented");
 }
 
+absl::Status PosixSocketWrapper::SetSocketReusePortCpuSteering(
+    int /*num_sockets*/) {
+  grpc_core::Crash("unimplemented");
+}
+
 absl::Status PosixSocketWrapper::SetSocketDscp(int /*dscp*/) {
   grpc_core::Crash("unimplemented");
 }
@@ -58,9 +58,12 @@ struct PosixTcpOptions {
   static constexpr int kMaxChunkSize = 32 * 1024 * 1024;
   static constexpr int kDefaultMaxSends = 4;
   static constexpr size_t kDefaultSendBytesThreshold = 16 * 1024;
+  static constexpr int kZerocpRxEnabledDefault = 0;
+  static constexpr int kDefaultRecvBytesThreshold = 64 * 1024;
   // Let the system decide the proper buffer size.
   static constexpr int kReadBufferSizeUnset = -1;
   static constexpr int kDscpNotSet = -1;
+  static constexpr int kMaxReusePortListeners = 1024;
   int tcp_read_chunk_size = kDefaultReadChunkSize;
   int tcp_min_read_chunk_size = kDefaultMinReadChunksize;
   int tcp_max_read_chunk_size = kDefaultMaxReadChunksize;
@@ -68,10 +71,14 @@ struct PosixTcpOptions {
   int tcp_tx_zerocopy_max_simultaneous_sends = kDefaultMaxSends;
   int tcp_receive_buffer_size = kReadBufferSizeUnset;
   bool tcp_tx_zero_copy_enabled = kZerocpTxEnabledDefault;
+  int tcp_rx_zerocopy_recv_bytes_threshold = kDefaultRecvBytesThreshold;
+  bool tcp_rx_zero_copy_enabled = kZerocpRxEnabledDefault;
   int keep_alive_time_ms = 0;
   int keep_alive_timeout_ms = 0;
   bool expand_wildcard_addrs = false;
   bool allow_reuse_port = false;
+  int reuse_port_listeners = 1;
+  bool reuse_port_cpu_steering = false;
   int dscp = kDscpNotSet;
   grpc_core::RefCountedPtr<grpc_core::ResourceQuota> resource_quota;
   struct grpc_socket_mutator* socket_mutator = nullptr;
@@ -133,10 +140,15 @@ struct PosixTcpOptions {
     tcp_tx_zerocopy_max_simultaneous_sends =
         other.tcp_tx_zerocopy_max_simultaneous_sends;
     tcp_tx_zero_copy_enabled = other.tcp_tx_zero_copy_enabled;
+    tcp_rx_zerocopy_recv_bytes_threshold =
+        other.tcp_rx_zerocopy_recv_bytes_threshold;
+    tcp_rx_zero_copy_enabled = other.tcp_rx_zero_copy_enabled;
     keep_alive_time_ms = other.keep_alive_time_ms;
     keep_alive_timeout_ms = other.keep_alive_timeout_ms;
     expand_wildcard_addrs = other.expand_wildcard_addrs;
     allow_reuse_port = other.allow_reuse_port;
+    reuse_port_listeners = other.reuse_port_listeners;
+    reuse_port_cpu_steering = other.reuse_port_cpu_steering;
     dscp = other.dscp;
   }
 };
@@ -185,6 +197,11 @@ class PosixSocketWrapper {
   // Set SO_REUSEPORT
   absl::Status SetSocketReusePort(int reuse);
 
+  // Attach a BPF program to the SO_REUSEPORT group of this socket, which must
+  // be bound, so that connections received on CPU n are handed to the
+  // (n % num_sockets)-th socket of the group.
+  absl::Status SetSocketReusePortCpuSteering(int num_sockets);
+
   // Set Differentiated Services Code Point (DSCP)
   absl::Status SetSocketDscp(int dscp);
 
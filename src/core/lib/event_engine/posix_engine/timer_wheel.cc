@@ -0,0 +1,279 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "absl/numeric/bits.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+constexpr int64_t kNoEvent = std::numeric_limits<int64_t>::max();
+
+void ListJoin(Timer* head, Timer* timer) {
+  timer->next = head;
+  timer->prev = head->prev;
+  timer->next->prev = timer->prev->next = timer;
+}
+
+void ListRemove(Timer* timer) {
+  timer->next->prev = timer->prev;
+  timer->prev->next = timer->next;
+}
+
+bool ListEmpty(const Timer* head) { return head->next == head; }
+
+}  // namespace
+
+TimerWheel::Shard::Shard() {
+  for (Timer& head : buckets) {
+    head.next = head.prev = &head;
+  }
+}
+
+size_t TimerWheel::Shard::BucketFor(const Timer* timer) const {
+  // Timers that are already due go in the bucket for the current tick.
+  const int64_t deadline = std::max(timer->deadline, current_tick);
+  // The timer belongs to the level of the most significant group of bits in
+  // which its deadline differs from the current tick.
+  const uint64_t diff = static_cast<uint64_t>(deadline ^ current_tick);
+  const int level =
+      diff == 0 ? 0 : (63 - absl::countl_zero(diff)) / kBitsPerLevel;
+  if (level >= kLevels) return kOverflowBucket;
+  return level * kSlotsPerLevel +
+         ((deadline >> (level * kBitsPerLevel)) & (kSlotsPerLevel - 1));
+}
+
+void TimerWheel::Shard::Add(Timer* timer) {
+  const size_t bucket = BucketFor(timer);
+  ListJoin(&buckets[bucket], timer);
+  if (bucket == kOverflowBucket) {
+    ++overflow_count;
+  } else {
+    occupied[bucket / kSlotsPerLevel] |= uint64_t{1}
+                                         << (bucket % kSlotsPerLevel);
+  }
+}
+
+void TimerWheel::Shard::Remove(Timer* timer) {
+  const size_t bucket = BucketFor(timer);
+  ListRemove(timer);
+  if (bucket == kOverflowBucket) {
+    --overflow_count;
+  } else if (ListEmpty(&buckets[bucket])) {
+    occupied[bucket / kSlotsPerLevel] &=
+        ~(uint64_t{1} << (bucket % kSlotsPerLevel));
+  }
+}
+
+void TimerWheel::Shard::Cascade(size_t bucket) {
+  Timer* head = &buckets[bucket];
+  if (ListEmpty(head)) return;
+  // Detach the list, then re-add each timer. The last timer still points
+  // back at head, which ends the walk even if some timers are re-added to
+  // this same bucket.
+  Timer* timer = head->next;
+  head->next = head->prev = head;
+  if (bucket == kOverflowBucket) {
+    overflow_count = 0;
+  } else {
+    occupied[bucket / kSlotsPerLevel] &=
+        ~(uint64_t{1} << (bucket % kSlotsPerLevel));
+  }
+  while (timer != head) {
+    Timer* next = timer->next;
+    Add(timer);
+    timer = next;
+  }
+}
+
+int64_t TimerWheel::Shard::NextEventTick() const {
+  // Occupied buckets at level L all lie after the current tick's bucket at
+  // that level (or, at level 0, at it), and every bucket at level L + 1 starts
+  // after the current level L rotation, so the first occupied level holds
+  // the next event.
+  for (int level = 0; level < kLevels; ++level) {
+    if (occupied[level] == 0) continue;
+    const int shift = level * kBitsPerLevel;
+    const int64_t rotation_start =
+        current_tick >> (shift + kBitsPerLevel) << (shift + kBitsPerLevel);
+    return rotation_start +
+           (static_cast<int64_t>(absl::countr_zero(occupied[level])) << shift);
+  }
+  if (overflow_count > 0) {
+    // The overflow list is rescanned when the top level wraps around.
+    const int shift = kLevels * kBitsPerLevel;
+    return ((current_tick >> shift) + 1) << shift;
+  }
+  return kNoEvent;
+}
+
+void TimerWheel::Shard::AdvanceTo(int64_t tick) {
+  current_tick = tick;
+  // Cascade from the top down: timers from a higher level never land in the
+  // bucket of a lower level that starts at tick, except at level 0.
+  for (int level = kLevels; level >= 1; --level) {
+    const int shift = level * kBitsPerLevel;
+    if ((tick & ((int64_t{1} << shift) - 1)) != 0) continue;
+    if (level == kLevels) {
+      Cascade(kOverflowBucket);
+    } else {
+      Cascade(level * kSlotsPerLevel +
+              ((tick >> shift) & (kSlotsPerLevel - 1)));
+    }
+  }
+}
+
+int64_t TimerWheel::Shard::PopTimers(
+    int64_t now, std::vector<experimental::EventEngine::Closure*>* out) {
+  grpc_core::MutexLock lock(&mu);
+  const int64_t end = std::min(now, kNoEvent - 1) + 1;
+  if (current_tick >= end) {
+    // Time has not moved on since the last check, but timers added since then
+    // with a deadline that had already passed were filed at current_tick.
+    const size_t slot = current_tick & (kSlotsPerLevel - 1);
+    Timer* head = &buckets[slot];
+    for (Timer* timer = head->next; timer != head;) {
+      Timer* next = timer->next;
+      if (timer->deadline < end) {
+        timer->pending = false;
+        out->push_back(timer->closure);
+        ListRemove(timer);
+      }
+      timer = next;
+    }
+    if (ListEmpty(head)) occupied[0] &= ~(uint64_t{1} << slot);
+    published_tick = NextEventTick();
+    return published_tick;
+  }
+  for (;;) {
+    const int64_t tick = NextEventTick();
+    if (tick >= end) break;
+    if (tick > current_tick) AdvanceTo(tick);
+    // Everything in the level 0 bucket for the current tick is due now.
+    const size_t slot = current_tick & (kSlotsPerLevel - 1);
+    Timer* head = &buckets[slot];
+    for (Timer* timer = head->next; timer != head; timer = timer->next) {
+      timer->pending = false;
+      out->push_back(timer->closure);
+    }
+    head->next = head->prev = head;
+    occupied[0] &= ~(uint64_t{1} << slot);
+    AdvanceTo(current_tick + 1);
+  }
+  // Nothing else is due before end, so no bucket can start in between.
+  if (current_tick < end) AdvanceTo(end);
+  published_tick = NextEventTick();
+  return published_tick;
+}
+
+TimerWheel::TimerWheel(TimerListHost* host)
+    : host_(host),
+      shards_(grpc_core::PerCpuOptions().SetCpusPerShard(1).SetMaxShards(32)),
+      min_timer_(host_->Now().milliseconds_after_process_epoch()) {
+  size_t index = 0;
+  for (Shard& shard : shards_) {
+    grpc_core::MutexLock lock(&shard.mu);
+    shard.index = index++;
+    shard.current_tick = min_timer_.load(std::memory_order_relaxed);
+    shard.published_tick = shard.current_tick;
+  }
+}
+
+TimerWheel::Shard& TimerWheel::ShardForTimer(const Timer* timer) {
+  return shards_.begin()[timer->heap_index];
+}
+
+void TimerWheel::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                           experimental::EventEngine::Closure* closure) {
+  Shard& shard = shards_.this_cpu();
+  const int64_t deadline_ms = deadline.milliseconds_after_process_epoch();
+  timer->closure = closure;
+  timer->deadline = deadline_ms;
+  timer->heap_index = shard.index;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  bool is_first_in_shard = false;
+  {
+    grpc_core::MutexLock lock(&shard.mu);
+    timer->pending = true;
+    shard.Add(timer);
+    if (deadline_ms < shard.published_tick) {
+      shard.published_tick = deadline_ms;
+      is_first_in_shard = true;
+    }
+  }
+
+  // min_timer_ is never above any shard's published_tick once a TimerCheck
+  // has finished storing it. If this timer is not the shard's new earliest
+  // event, the timer manager will wake in time for it. Otherwise a TimerCheck
+  // that has already scanned this shard may be about to store a min_timer_
+  // that ignores the timer; it holds mu_ until it has, so compare against
+  // min_timer_ only under mu_.
+  if (is_first_in_shard) {
+    grpc_core::MutexLock lock(&mu_);
+    if (deadline_ms < min_timer_.load(std::memory_order_relaxed)) {
+      min_timer_.store(deadline_ms, std::memory_order_relaxed);
+      host_->Kick();
+    }
+  }
+}
+
+bool TimerWheel::TimerCancel(Timer* timer) {
+  Shard& shard = ShardForTimer(timer);
+  grpc_core::MutexLock lock(&shard.mu);
+  if (!timer->pending) return false;
+  timer->pending = false;
+  shard.Remove(timer);
+  return true;
+}
+
+absl::optional<std::vector<experimental::EventEngine::Closure*>>
+TimerWheel::TimerCheck(grpc_core::Timestamp* next) {
+  const int64_t now = host_->Now().milliseconds_after_process_epoch();
+  int64_t min_timer = min_timer_.load(std::memory_order_relaxed);
+  std::vector<experimental::EventEngine::Closure*> done;
+  if (now >= min_timer) {
+    if (!checker_mu_.TryLock()) return absl::nullopt;
+    {
+      grpc_core::MutexLock lock(&mu_);
+      min_timer = kNoEvent;
+      for (Shard& shard : shards_) {
+        min_timer = std::min(min_timer, shard.PopTimers(now, &done));
+      }
+      min_timer_.store(min_timer, std::memory_order_relaxed);
+    }
+    checker_mu_.Unlock();
+  }
+  if (next != nullptr) {
+    *next = std::min(
+        *next, grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                   min_timer));
+  }
+  return done;
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
@@ -0,0 +1,129 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+#define GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A TimerListInterface built from per-CPU hierarchical timing wheels.
+//
+// Each shard keeps kLevels wheels of kSlotsPerLevel buckets with a resolution
+// of one millisecond: a bucket at level L spans 64^L milliseconds. A timer is
+// filed at the lowest level whose bucket span covers the distance to its
+// deadline, so TimerInit and TimerCancel are O(1) list operations. As time
+// advances, buckets at higher levels are redistributed ("cascaded") into
+// lower ones, and each timer is moved at most kLevels times over its life.
+// Timers further out than the wheels reach (about 4.6 hours) wait on an
+// overflow list that is rescanned whenever the top level wraps around.
+//
+// Timers are added to the shard of the CPU that creates them, so concurrent
+// TimerInit calls from different CPUs rarely contend.
+class TimerWheel final : public TimerListInterface {
+ public:
+  explicit TimerWheel(TimerListHost* host);
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                 experimental::EventEngine::Closure* closure) override;
+  GRPC_MUST_USE_RESULT bool TimerCancel(Timer* timer) override;
+  absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
+      grpc_core::Timestamp* next) override;
+
+ private:
+  static constexpr int kBitsPerLevel = 6;
+  static constexpr size_t kSlotsPerLevel = 1 << kBitsPerLevel;
+  static constexpr int kLevels = 4;
+  // Buckets are numbered level * kSlotsPerLevel + slot; the overflow list
+  // comes last.
+  static constexpr size_t kOverflowBucket = kLevels * kSlotsPerLevel;
+  static constexpr size_t kBucketsPerShard = kOverflowBucket + 1;
+
+  struct Shard {
+    Shard();
+
+    // Returns the bucket holding (or about to hold) timer. A timer's bucket
+    // only changes when it is cascaded, so it need not be stored.
+    size_t BucketFor(const Timer* timer) const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    void Add(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    void Remove(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Re-files every timer in bucket relative to current_tick.
+    void Cascade(size_t bucket) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Returns the earliest tick at which a timer may expire or a bucket needs
+    // to be cascaded. This is a lower bound on the next deadline.
+    int64_t NextEventTick() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Moves current_tick to tick, cascading the buckets that start there.
+    // Must not skip over any tick returned by NextEventTick().
+    void AdvanceTo(int64_t tick) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Pops every timer due at or before now, and returns NextEventTick(),
+    // which it also records in published_tick.
+    int64_t PopTimers(int64_t now,
+                      std::vector<experimental::EventEngine::Closure*>* out)
+        ABSL_LOCKS_EXCLUDED(mu);
+
+    grpc_core::Mutex mu;
+    // Index of this shard, recorded in the timers it holds.
+    size_t index = 0;
+    // Every timer due before this tick has been popped.
+    int64_t current_tick ABSL_GUARDED_BY(mu) = 0;
+    // Bit i of occupied[L] is set iff bucket i of level L is non-empty.
+    uint64_t occupied[kLevels] ABSL_GUARDED_BY(mu) = {};
+    // The earliest event in this shard that the timer manager has been told
+    // about: the tick returned by the last PopTimers(), lowered by TimerInit
+    // when it adds an earlier timer.
+    int64_t published_tick ABSL_GUARDED_BY(mu) = 0;
+    // Number of timers on the overflow list.
+    size_t overflow_count ABSL_GUARDED_BY(mu) = 0;
+    // Circular list heads, indexed by bucket number.
+    Timer buckets[kBucketsPerShard] ABSL_GUARDED_BY(mu);
+  };
+
+  Shard& ShardForTimer(const Timer* timer);
+
+  TimerListHost* const host_;
+  grpc_core::PerCpu<Shard> shards_;
+  grpc_core::Mutex mu_;
+  // A lower bound on the deadline of the next timer due across all shards.
+  std::atomic<int64_t> min_timer_;
+  // Allow only one TimerCheck at once (used as a TryLock, protects no fields
+  // but ensures limits on concurrency)
+  grpc_core::Mutex checker_mu_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_SRC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_WHEEL_H
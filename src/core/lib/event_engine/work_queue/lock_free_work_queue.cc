@@ -0,0 +1,113 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/work_queue/lock_free_work_queue.h"
+
+#include <utility>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/common_closures.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+size_t RoundUpToPowerOfTwo(size_t n) {
+  size_t capacity = 1;
+  while (capacity < n) capacity <<= 1;
+  return capacity;
+}
+}  // namespace
+
+LockFreeWorkQueue::LockFreeWorkQueue(WorkQueue* overflow, size_t capacity)
+    : overflow_(overflow),
+      mask_(RoundUpToPowerOfTwo(capacity) - 1),
+      buffer_(new std::atomic<EventEngine::Closure*>[mask_ + 1]) {
+  GPR_ASSERT(overflow_ != nullptr);
+  for (int64_t i = 0; i <= mask_; ++i) {
+    buffer_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+bool LockFreeWorkQueue::Empty() const { return Size() == 0; }
+
+size_t LockFreeWorkQueue::Size() const {
+  int64_t b = bottom_.value.load(std::memory_order_acquire);
+  int64_t t = top_.value.load(std::memory_order_acquire);
+  // While the owner is popping, bottom_ may transiently be below top_.
+  return b > t ? static_cast<size_t>(b - t) : 0;
+}
+
+EventEngine::Closure* LockFreeWorkQueue::PopMostRecent() {
+  int64_t b = bottom_.value.load(std::memory_order_relaxed) - 1;
+  // The reservation of slot b must be visible to thieves before top_ is read.
+  // Both accesses are sequentially consistent, as are the matching ones in
+  // PopOldest, which rules out store-load reordering between them.
+  bottom_.value.store(b, std::memory_order_seq_cst);
+  int64_t t = top_.value.load(std::memory_order_seq_cst);
+  if (t > b) {
+    // Empty.
+    bottom_.value.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  EventEngine::Closure* closure =
+      buffer_[b & mask_].load(std::memory_order_relaxed);
+  if (t == b) {
+    // Last element: race against thieves for it.
+    if (!top_.value.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed)) {
+      closure = nullptr;
+    }
+    bottom_.value.store(b + 1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+EventEngine::Closure* LockFreeWorkQueue::PopOldest() {
+  int64_t t = top_.value.load(std::memory_order_seq_cst);
+  int64_t b = bottom_.value.load(std::memory_order_seq_cst);
+  if (t >= b) return nullptr;
+  // The slot cannot be overwritten before top_ moves past t, since Add never
+  // lets bottom_ get more than the capacity ahead of top_.
+  EventEngine::Closure* closure =
+      buffer_[t & mask_].load(std::memory_order_relaxed);
+  if (!top_.value.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+    // Lost the race to another thief, or to the owner.
+    return nullptr;
+  }
+  return closure;
+}
+
+void LockFreeWorkQueue::Add(EventEngine::Closure* closure) {
+  int64_t b = bottom_.value.load(std::memory_order_relaxed);
+  int64_t t = top_.value.load(std::memory_order_acquire);
+  if (b - t > mask_) {
+    overflow_->Add(closure);
+    return;
+  }
+  buffer_[b & mask_].store(closure, std::memory_order_relaxed);
+  // Make the closure visible to thieves before they can observe the new
+  // bottom_.
+  bottom_.value.store(b + 1, std::memory_order_release);
+}
+
+void LockFreeWorkQueue::Add(absl::AnyInvocable<void()> invocable) {
+  Add(SelfDeletingClosure::Create(std::move(invocable)));
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
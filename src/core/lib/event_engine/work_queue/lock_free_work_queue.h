@@ -0,0 +1,92 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_LOCK_FREE_WORK_QUEUE_H
+#define GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_LOCK_FREE_WORK_QUEUE_H
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/functional/any_invocable.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/work_queue/work_queue.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A bounded, lock-free work-stealing deque (Chase & Lev, with the memory
+// orderings from Lê et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models").
+//
+// Unlike other WorkQueue implementations, this queue has a single owner: Add
+// and PopMostRecent may only be called from the thread that owns the queue.
+// PopOldest, Empty and Size may be called from any thread, which is how other
+// threads steal work. Adding and popping on the owner side never allocates
+// and only contends with thieves when a single element remains.
+//
+// The deque has a fixed capacity. Closures added while it is full are passed
+// on to the overflow queue, which must be safe to use from any thread.
+class LockFreeWorkQueue : public WorkQueue {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  // capacity is rounded up to a power of two.
+  explicit LockFreeWorkQueue(WorkQueue* overflow,
+                             size_t capacity = kDefaultCapacity);
+  // Returns whether the queue is empty. This is a snapshot that may already
+  // be stale when another thread is modifying the queue.
+  bool Empty() const override;
+  // Returns the size of the queue. This is a snapshot that may already be
+  // stale when another thread is modifying the queue.
+  size_t Size() const override;
+  // Returns the most recent element from the queue, or nullptr if it is empty
+  // or the last element was stolen concurrently. Owner thread only.
+  EventEngine::Closure* PopMostRecent() override;
+  // Steals the oldest element from the queue. Returns nullptr if the queue is
+  // empty, or if another thread popped the same element first.
+  //
+  // This method may return nullptr even if the queue is not empty.
+  EventEngine::Closure* PopOldest() override;
+  // Adds a closure to the queue, or to the overflow queue if this queue is
+  // full. Owner thread only.
+  void Add(EventEngine::Closure* closure) override;
+  // Wraps an AnyInvocable and adds it to the the queue. Owner thread only.
+  void Add(absl::AnyInvocable<void()> invocable) override;
+
+ private:
+  WorkQueue* const overflow_;
+  const int64_t mask_;
+  const std::unique_ptr<std::atomic<EventEngine::Closure*>[]> buffer_;
+  // An index padded to a cache line, so that thieves updating top_ do not
+  // keep invalidating the owner's copy of bottom_.
+  struct PaddedIndex {
+    std::atomic<int64_t> value{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<int64_t>)];
+  };
+  // Index of the oldest element. Only ever incremented, by whichever thread
+  // wins the CAS for that element.
+  PaddedIndex top_;
+  // One past the index of the most recent element. Only written by the owner.
+  PaddedIndex bottom_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_LOCK_FREE_WORK_QUEUE_H
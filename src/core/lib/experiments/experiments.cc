@@ -53,6 +53,8 @@ const char* const description_event_engine_dns = "If set, use EventEngine DNSRes
 const char* const additional_constraints_event_engine_dns = "{}";
 const char* const description_work_stealing = "If set, use a work stealing thread pool implementation in EventEngine";
 const char* const additional_constraints_work_stealing = "{}";
+const char* const description_event_engine_timer_wheel = "If set, the posix EventEngine keeps timers in per-CPU hierarchical timing wheels instead of sharded heaps.";
+const char* const additional_constraints_event_engine_timer_wheel = "{}";
 const char* const description_client_privacy = "If set, client privacy";
 const char* const additional_constraints_client_privacy = "{}";
 const char* const description_canary_client_privacy = "If set, canary client privacy";
@@ -65,6 +67,8 @@ const char* const description_keepalive_fix = "Allows overriding keepalive_permi
 const char* const additional_constraints_keepalive_fix = "{}";
 const char* const description_keepalive_server_fix = "Allows overriding keepalive_permit_without_calls for servers. Refer https://github.com/grpc/grpc/pull/33917 for more information.";
 const char* const additional_constraints_keepalive_server_fix = "{}";
+const char* const description_call_arena_pool = "If set, each channel keeps a small per-CPU cache of call arena storage that is reused by later calls instead of being freed.";
+const char* const additional_constraints_call_arena_pool = "{}";
 }
 
 namespace grpc_core {
@@ -86,12 +90,14 @@ const ExperimentMetadata g_experiment_metadata[] = {
   {"trace_record_callops", description_trace_record_callops, additional_constraints_trace_record_callops, false, true},
   {"event_engine_dns", description_event_engine_dns, additional_constraints_event_engine_dns, false, false},
   {"work_stealing", description_work_stealing, additional_constraints_work_stealing, false, false},
+  {"event_engine_timer_wheel", description_event_engine_timer_wheel, additional_constraints_event_engine_timer_wheel, false, false},
   {"client_privacy", description_client_privacy, additional_constraints_client_privacy, false, false},
   {"canary_client_privacy", description_canary_client_privacy, additional_constraints_canary_client_privacy, false, false},
   {"server_privacy", description_server_privacy, additional_constraints_server_privacy, false, false},
   {"unique_metadata_strings", description_unique_metadata_strings, additional_constraints_unique_metadata_strings, true, true},
   {"keepalive_fix", description_keepalive_fix, additional_constraints_keepalive_fix, false, false},
   {"keepalive_server_fix", description_keepalive_server_fix, additional_constraints_keepalive_server_fix, false, false},
+  {"call_arena_pool", description_call_arena_pool, additional_constraints_call_arena_pool, false, true},
 };
 
 }  // namespace grpc_core
@@ -130,6 +136,8 @@ const char* const description_event_engine_dns = "If set, use EventEngine DNSRes
 const char* const additional_constraints_event_engine_dns = "{}";
 const char* const description_work_stealing = "If set, use a work stealing thread pool implementation in EventEngine";
 const char* const additional_constraints_work_stealing = "{}";
+const char* const description_event_engine_timer_wheel = "If set, the posix EventEngine keeps timers in per-CPU hierarchical timing wheels instead of sharded heaps.";
+const char* const additional_constraints_event_engine_timer_wheel = "{}";
 const char* const description_client_privacy = "If set, client privacy";
 const char* const additional_constraints_client_privacy = "{}";
 const char* const description_canary_client_privacy = "If set, canary client privacy";
@@ -142,6 +150,8 @@ const char* const description_keepalive_fix = "Allows overriding keepalive_permi
 const char* const additional_constraints_keepalive_fix = "{}";
 const char* const description_keepalive_server_fix = "Allows overriding keepalive_permit_without_calls for servers. Refer https://github.com/grpc/grpc/pull/33917 for more information.";
 const char* const additional_constraints_keepalive_server_fix = "{}";
+const char* const description_call_arena_pool = "If set, each channel keeps a small per-CPU cache of call arena storage that is reused by later calls instead of being freed.";
+const char* const additional_constraints_call_arena_pool = "{}";
 }
 
 namespace grpc_core {
@@ -163,12 +173,14 @@ const ExperimentMetadata g_experiment_metadata[] = {
   {"trace_record_callops", description_trace_record_callops, additional_constraints_trace_record_callops, false, true},
   {"event_engine_dns", description_event_engine_dns, additional_constraints_event_engine_dns, false, false},
   {"work_stealing", description_work_stealing, additional_constraints_work_stealing, false, false},
+  {"event_engine_timer_wheel", description_event_engine_timer_wheel, additional_constraints_event_engine_timer_wheel, false, false},
   {"client_privacy", description_client_privacy, additional_constraints_client_privacy, false, false},
   {"canary_client_privacy", description_canary_client_privacy, additional_constraints_canary_client_privacy, false, false},
   {"server_privacy", description_server_privacy, additional_constraints_server_privacy, false, false},
   {"unique_metadata_strings", description_unique_metadata_strings, additional_constraints_unique_metadata_strings, true, true},
   {"keepalive_fix", description_keepalive_fix, additional_constraints_keepalive_fix, false, false},
   {"keepalive_server_fix", description_keepalive_server_fix, additional_constraints_keepalive_server_fix, false, false},
+  {"call_arena_pool", description_call_arena_pool, additional_constraints_call_arena_pool, false, true},
 };
 
 }  // namespace grpc_core
@@ -207,6 +219,8 @@ const char* const description_event_engine_dns = "If set, use EventEngine DNSRes
 const char* const additional_constraints_event_engine_dns = "{}";
 const char* const description_work_stealing = "If set, use a work stealing thread pool implementation in EventEngine";
 const char* const additional_constraints_work_stealing = "{}";
+const char* const description_event_engine_timer_wheel = "If set, the posix EventEngine keeps timers in per-CPU hierarchical timing wheels instead of sharded heaps.";
+const char* const additional_constraints_event_engine_timer_wheel = "{}";
 const char* const description_client_privacy = "If set, client privacy";
 const char* const additional_constraints_client_privacy = "{}";
 const char* const description_canary_client_privacy = "If set, canary client privacy";
@@ -219,6 +233,8 @@ const char* const description_keepalive_fix = "Allows overriding keepalive_permi
 const char* const additional_constraints_keepalive_fix = "{}";
 const char* const description_keepalive_server_fix = "Allows overriding keepalive_permit_without_calls for servers. Refer https://github.com/grpc/grpc/pull/33917 for more information.";
 const char* const additional_constraints_keepalive_server_fix = "{}";
+const char* const description_call_arena_pool = "If set, each channel keeps a small per-CPU cache of call arena storage that is reused by later calls instead of being freed.";
+const char* const additional_constraints_call_arena_pool = "{}";
 }
 
 namespace grpc_core {
@@ -240,12 +256,14 @@ const ExperimentMetadata g_experiment_metadata[] = {
   {"trace_record_callops", description_trace_record_callops, additional_constraints_trace_record_callops, false, true},
   {"event_engine_dns", description_event_engine_dns, additional_constraints_event_engine_dns, false, false},
   {"work_stealing", description_work_stealing, additional_constraints_work_stealing, false, false},
+  {"event_engine_timer_wheel", description_event_engine_timer_wheel, additional_constraints_event_engine_timer_wheel, false, false},
   {"client_privacy", description_client_privacy, additional_constraints_client_privacy, false, false},
   {"canary_client_privacy", description_canary_client_privacy, additional_constraints_canary_client_privacy, false, false},
   {"server_privacy", description_server_privacy, additional_constraints_server_privacy, false, false},
   {"unique_metadata_strings", description_unique_metadata_strings, additional_constraints_unique_metadata_strings, true, true},
   {"keepalive_fix", description_keepalive_fix, additional_constraints_keepalive_fix, false, false},
   {"keepalive_server_fix", description_keepalive_server_fix, additional_constraints_keepalive_server_fix, false, false},
+  {"call_arena_pool", description_call_arena_pool, additional_constraints_call_arena_pool, false, true},
 };
 
 }  // namespace grpc_core
@@ -22,6 +22,8 @@
 #include <limits>
 #include <memory>
 
+#include <grpc/support/cpu.h>
+
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -58,7 +60,14 @@ class PerCpu {
   // options specify.
   explicit PerCpu(PerCpuOptions options) : cpus_(options.Shards()) {}
 
-  T& this_cpu() { return data_[ExecCtx::Get()->starting_cpu() % cpus_]; }
+  // Uses the starting cpu of the current ExecCtx if there is one, so that
+  // all work done under one ExecCtx lands on the same shard.
+  T& this_cpu() {
+    ExecCtx* exec_ctx = ExecCtx::Get();
+    const unsigned cpu = exec_ctx != nullptr ? exec_ctx->starting_cpu()
+                                             : gpr_cpu_current_cpu();
+    return data_[cpu % cpus_];
+  }
 
   T* begin() { return data_.get(); }
   T* end() { return data_.get() + cpus_; }
@@ -28,18 +28,22 @@ namespace grpc_core {
 
 void ValidationErrors::PushField(absl::string_view ext) {
   // Skip leading '.' for top-level field names.
-  if (fields_.empty()) absl::ConsumePrefix(&ext, ".");
-  fields_.emplace_back(std::string(ext));
+  if (field_path_lengths_.empty()) absl::ConsumePrefix(&ext, ".");
+  field_path_lengths_.push_back(field_path_.size());
+  field_path_.append(ext.data(), ext.size());
 }
 
-void ValidationErrors::PopField() { fields_.pop_back(); }
+void ValidationErrors::PopField() {
+  field_path_.resize(field_path_lengths_.back());
+  field_path_lengths_.pop_back();
+}
 
 void ValidationErrors::AddError(absl::string_view error) {
-  field_errors_[absl::StrJoin(fields_, "")].emplace_back(error);
+  field_errors_[field_path_].emplace_back(error);
 }
 
 bool ValidationErrors::FieldHasErrors() const {
-  return field_errors_.find(absl::StrJoin(fields_, "")) != field_errors_.end();
+  return field_errors_.find(field_path_) != field_errors_.end();
 }
 
 absl::Status ValidationErrors::status(absl::StatusCode code,
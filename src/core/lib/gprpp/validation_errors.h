@@ -124,9 +124,11 @@ class ValidationErrors {
   // TODO(roth): If we don't actually have any fields for which we
   // report more than one error, simplify this data structure.
   std::map<std::string /*field_name*/, std::vector<std::string>> field_errors_;
-  // Stack of field names indicating the field that we are currently
-  // validating.
-  std::vector<std::string> fields_;
+  // The field that we are currently validating: the concatenation of the
+  // stack of field names.
+  std::string field_path_;
+  // The length of field_path_ before each field on the stack was pushed.
+  std::vector<size_t> field_path_lengths_;
 };
 
 }  // namespace grpc_core
@@ -60,6 +60,20 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif  // LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
+// SO_ATTACH_REUSEPORT_CBPF needs 4.5 kernel headers.
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 5, 0)
+#define GRPC_LINUX_REUSEPORT_CBPF 1
+#endif  // LINUX_VERSION_CODE >= KERNEL_VERSION(4, 5, 0)
+// TCP_ZEROCOPY_RECEIVE needs 4.18 kernel headers. Support by the running
+// kernel is checked at runtime.
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0)
+#define GRPC_LINUX_TCP_ZEROCOPY_RECEIVE 1
+#endif  // LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0)
+// Multishot poll requests and IORING_ENTER_EXT_ARG need 5.13 kernel headers.
+// Support by the running kernel is checked at runtime.
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+#define GRPC_LINUX_IO_URING 1
+#endif  // LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
 #endif  // LINUX_VERSION_CODE
 #if defined(LINUX_VERSION_CODE) && defined(__GLIBC_PREREQ)
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 9, 0) && __GLIBC_PREREQ(2, 18)
@@ -238,6 +252,13 @@
 #define GRPC_POSIX_SOCKET_UTILS_COMMON 1
 #endif
 
+// Shared memory transport: memfd segments, eventfd wakeups, and a unix
+// socket to hand both to the peer.
+#if defined(GPR_LINUX) && defined(GRPC_LINUX_EVENTFD) && \
+    defined(GRPC_POSIX_SOCKET_EV) && defined(GRPC_HAVE_UNIX_SOCKET)
+#define GRPC_HAVE_SHM_TRANSPORT 1
+#endif
+
 #if defined(GRPC_POSIX_HOST_NAME_MAX) && defined(GRPC_POSIX_SYSCONF)
 #error "Cannot define both GRPC_POSIX_HOST_NAME_MAX and GRPC_POSIX_SYSCONF"
 #endif
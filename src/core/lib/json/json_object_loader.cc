@@ -16,6 +16,7 @@
 
 #include "src/core/lib/json/json_object_loader.h"
 
+#include <string>
 #include <utility>
 
 #include "absl/strings/ascii.h"
@@ -182,14 +183,19 @@ bool LoadObject(const Json& json, const JsonArgs& args, const Element* elements,
     errors->AddError("is not an object");
     return false;
   }
+  // Reused across elements, so that looking up each one doesn't allocate.
+  std::string field_name = ".";
+  std::string key;
   for (size_t i = 0; i < num_elements; ++i) {
     const Element& element = elements[i];
     if (element.enable_key != nullptr && !args.IsEnabled(element.enable_key)) {
       continue;
     }
-    ValidationErrors::ScopedField field(errors,
-                                        absl::StrCat(".", element.name));
-    const auto& it = json.object().find(element.name);
+    field_name.resize(1);
+    field_name.append(element.name);
+    ValidationErrors::ScopedField field(errors, field_name);
+    key.assign(element.name);
+    const auto& it = json.object().find(key);
     if (it == json.object().end() || it->second.type() == Json::Type::kNull) {
       if (element.optional) continue;
       errors->AddError("field not present");
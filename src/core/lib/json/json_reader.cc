@@ -16,6 +16,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/json/json_reader.h"
+
 #include <inttypes.h>
 #include <stdlib.h>
 
@@ -50,7 +52,8 @@ namespace {
 
 class JsonReader {
  public:
-  static absl::StatusOr<Json> Parse(absl::string_view input);
+  static absl::Status Parse(absl::string_view input,
+                            JsonReaderHandler* handler);
 
  private:
   enum class Status {
@@ -96,32 +99,11 @@ class JsonReader {
   //
   static constexpr uint32_t GRPC_JSON_READ_CHAR_EOF = 0x7ffffff0;
 
-  struct Scope {
-    std::string parent_object_key;
-    absl::variant<Json::Object, Json::Array> data;
-
-    Json::Type type() const {
-      return Match(
-          data, [](const Json::Object&) { return Json::Type::kObject; },
-          [](const Json::Array&) { return Json::Type::kArray; });
-    }
-
-    Json TakeAsJson() {
-      return MatchMutable(
-          &data,
-          [&](Json::Object* object) {
-            return Json::FromObject(std::move(*object));
-          },
-          [&](Json::Array* array) {
-            return Json::FromArray(std::move(*array));
-          });
-    }
-  };
-
-  explicit JsonReader(absl::string_view input)
+  JsonReader(absl::string_view input, JsonReaderHandler* handler)
       : original_input_(reinterpret_cast<const uint8_t*>(input.data())),
         input_(original_input_),
-        remaining_input_(input.size()) {}
+        remaining_input_(input.size()),
+        handler_(handler) {}
 
   Status Run();
   uint32_t ReadChar();
@@ -132,7 +114,6 @@ class JsonReader {
   GRPC_MUST_USE_RESULT bool StringAddChar(uint32_t c);
   GRPC_MUST_USE_RESULT bool StringAddUtf32(uint32_t c);
 
-  Json* CreateAndLinkValue();
   bool StartContainer(Json::Type type);
   void EndContainer();
   void SetKey();
@@ -145,6 +126,7 @@ class JsonReader {
   const uint8_t* original_input_;
   const uint8_t* input_;
   size_t remaining_input_;
+  JsonReaderHandler* handler_;
 
   State state_ = State::GRPC_JSON_STATE_VALUE_BEGIN;
   bool escaped_string_was_key_ = false;
@@ -156,10 +138,9 @@ class JsonReader {
   uint8_t utf8_bytes_remaining_ = 0;
   uint8_t utf8_first_byte_ = 0;
 
-  Json root_value_;
-  std::vector<Scope> stack_;
+  // Types of the containers we're in (kObject or kArray).
+  std::vector<Json::Type> stack_;
 
-  std::string key_;
   std::string string_;
 };
 
@@ -253,17 +234,6 @@ uint32_t JsonReader::ReadChar() {
   return r;
 }
 
-Json* JsonReader::CreateAndLinkValue() {
-  if (stack_.empty()) return &root_value_;
-  return MatchMutable(
-      &stack_.back().data,
-      [&](Json::Object* object) { return &(*object)[std::move(key_)]; },
-      [&](Json::Array* array) {
-        array->emplace_back();
-        return &array->back();
-      });
-}
-
 bool JsonReader::StartContainer(Json::Type type) {
   if (stack_.size() == GRPC_JSON_MAX_DEPTH) {
     if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
@@ -275,68 +245,62 @@ bool JsonReader::StartContainer(Json::Type type) {
     }
     return false;
   }
-  stack_.emplace_back();
-  Scope& scope = stack_.back();
-  scope.parent_object_key = std::move(key_);
+  stack_.push_back(type);
   if (type == Json::Type::kObject) {
-    scope.data = Json::Object();
+    handler_->StartObject();
   } else {
     GPR_ASSERT(type == Json::Type::kArray);
-    scope.data = Json::Array();
+    handler_->StartArray();
   }
   return true;
 }
 
 void JsonReader::EndContainer() {
   GPR_ASSERT(!stack_.empty());
-  Scope scope = std::move(stack_.back());
+  const Json::Type type = stack_.back();
   stack_.pop_back();
-  key_ = std::move(scope.parent_object_key);
-  Json* value = CreateAndLinkValue();
-  *value = scope.TakeAsJson();
+  if (type == Json::Type::kObject) {
+    handler_->EndObject();
+  } else {
+    handler_->EndArray();
+  }
 }
 
 void JsonReader::SetKey() {
-  key_ = std::move(string_);
-  string_.clear();
-  const Json::Object& object = absl::get<Json::Object>(stack_.back().data);
-  if (object.find(key_) != object.end()) {
+  if (!handler_->Key(string_)) {
     if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
       truncated_errors_ = true;
     } else {
       errors_.push_back(
-          absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, key_,
-                          CurrentIndex() - key_.size() - 2));
+          absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, string_,
+                          CurrentIndex() - string_.size() - 2));
     }
   }
+  string_.clear();
 }
 
 void JsonReader::SetString() {
-  Json* value = CreateAndLinkValue();
-  *value = Json::FromString(std::move(string_));
+  handler_->String(string_);
   string_.clear();
 }
 
 bool JsonReader::SetNumber() {
-  Json* value = CreateAndLinkValue();
-  *value = Json::FromNumber(std::move(string_));
+  handler_->Number(string_);
   string_.clear();
   return true;
 }
 
 void JsonReader::SetTrue() {
-  Json* value = CreateAndLinkValue();
-  *value = Json::FromBool(true);
+  handler_->Bool(true);
   string_.clear();
 }
 
 void JsonReader::SetFalse() {
-  Json* value = CreateAndLinkValue();
-  *value = Json::FromBool(false);
+  handler_->Bool(false);
   string_.clear();
 }
 
-void JsonReader::SetNull() { CreateAndLinkValue(); }
+void JsonReader::SetNull() { handler_->Null(); }
 
 bool JsonReader::IsComplete() {
   return (stack_.empty() && (state_ == State::GRPC_JSON_STATE_END ||
@@ -431,9 +395,9 @@ JsonReader::Status JsonReader::Run() {
             if (stack_.empty()) {
               return Status::GRPC_JSON_PARSE_ERROR;
             } else if (c == '}' &&
-                       stack_.back().type() != Json::Type::kObject) {
+                       stack_.back() != Json::Type::kObject) {
               return Status::GRPC_JSON_PARSE_ERROR;
-            } else if (c == ']' && stack_.back().type() != Json::Type::kArray) {
+            } else if (c == ']' && stack_.back() != Json::Type::kArray) {
               return Status::GRPC_JSON_PARSE_ERROR;
             }
             if (!SetNumber()) return Status::GRPC_JSON_PARSE_ERROR;
@@ -448,10 +412,10 @@ JsonReader::Status JsonReader::Run() {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (!stack_.empty() &&
-                  stack_.back().type() == Json::Type::kObject) {
+                  stack_.back() == Json::Type::kObject) {
                 state_ = State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN;
               } else if (!stack_.empty() &&
-                         stack_.back().type() == Json::Type::kArray) {
+                         stack_.back() == Json::Type::kArray) {
                 state_ = State::GRPC_JSON_STATE_VALUE_BEGIN;
               } else {
                 return Status::GRPC_JSON_PARSE_ERROR;
@@ -460,7 +424,7 @@ JsonReader::Status JsonReader::Run() {
               if (stack_.empty()) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
-              if (c == '}' && stack_.back().type() != Json::Type::kObject) {
+              if (c == '}' && stack_.back() != Json::Type::kObject) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (c == '}' &&
@@ -468,7 +432,7 @@ JsonReader::Status JsonReader::Run() {
                   !container_just_begun_) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
-              if (c == ']' && stack_.back().type() != Json::Type::kArray) {
+              if (c == ']' && stack_.back() != Json::Type::kArray) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (c == ']' && state_ == State::GRPC_JSON_STATE_VALUE_BEGIN &&
@@ -926,8 +890,9 @@ JsonReader::Status JsonReader::Run() {
   GPR_UNREACHABLE_CODE(return Status::GRPC_JSON_INTERNAL_ERROR);
 }
 
-absl::StatusOr<Json> JsonReader::Parse(absl::string_view input) {
-  JsonReader reader(input);
+absl::Status JsonReader::Parse(absl::string_view input,
+                               JsonReaderHandler* handler) {
+  JsonReader reader(input, handler);
   Status status = reader.Run();
   if (reader.truncated_errors_) {
     reader.errors_.push_back(
@@ -945,13 +910,100 @@ absl::StatusOr<Json> JsonReader::Parse(absl::string_view input) {
     return absl::InvalidArgumentError(absl::StrCat(
         "JSON parsing failed: [", absl::StrJoin(reader.errors_, "; "), "]"));
   }
-  return std::move(reader.root_value_);
+  return absl::OkStatus();
 }
 
+// Builds a Json tree from what the reader finds.
+class JsonTreeBuilder : public JsonReaderHandler {
+ public:
+  // Slots point into the containers of enclosing scopes, so stack_ must never
+  // reallocate: the reader stops at GRPC_JSON_MAX_DEPTH.
+  JsonTreeBuilder() { stack_.reserve(GRPC_JSON_MAX_DEPTH); }
+
+  Json TakeRoot() { return std::move(root_); }
+
+  void StartObject() override {
+    Json* slot = NextSlot();
+    stack_.push_back(Scope{Json::Object(), slot});
+  }
+
+  void EndObject() override {
+    Scope& scope = stack_.back();
+    *scope.slot =
+        Json::FromObject(std::move(absl::get<Json::Object>(scope.data)));
+    stack_.pop_back();
+  }
+
+  void StartArray() override {
+    Json* slot = NextSlot();
+    stack_.push_back(Scope{Json::Array(), slot});
+  }
+
+  void EndArray() override {
+    Scope& scope = stack_.back();
+    *scope.slot =
+        Json::FromArray(std::move(absl::get<Json::Array>(scope.data)));
+    stack_.pop_back();
+  }
+
+  bool Key(absl::string_view key) override {
+    // A single lookup both checks for a duplicate and finds where the value
+    // goes. For duplicate keys, the last value wins.
+    auto p = absl::get<Json::Object>(stack_.back().data)
+                 .emplace(std::string(key), Json());
+    key_slot_ = &p.first->second;
+    return p.second;
+  }
+
+  void String(absl::string_view value) override {
+    *NextSlot() = Json::FromString(std::string(value));
+  }
+
+  void Number(absl::string_view value) override {
+    *NextSlot() = Json::FromNumber(std::string(value));
+  }
+
+  void Bool(bool value) override { *NextSlot() = Json::FromBool(value); }
+
+  void Null() override { *NextSlot() = Json(); }
+
+ private:
+  struct Scope {
+    absl::variant<Json::Object, Json::Array> data;
+    // Where the container goes once it's complete. Map nodes don't move, an
+    // array gets no new elements while one of its elements is open, and
+    // stack_ never reallocates, so this stays valid.
+    Json* slot;
+  };
+
+  // Returns where the next value goes.
+  Json* NextSlot() {
+    if (stack_.empty()) return &root_;
+    return MatchMutable(
+        &stack_.back().data, [this](Json::Object*) { return key_slot_; },
+        [](Json::Array* array) {
+          array->emplace_back();
+          return &array->back();
+        });
+  }
+
+  Json root_;
+  std::vector<Scope> stack_;
+  Json* key_slot_ = nullptr;
+};
+
 }  // namespace
 
+absl::Status JsonParse(absl::string_view json_str,
+                       JsonReaderHandler* handler) {
+  return JsonReader::Parse(json_str, handler);
+}
+
 absl::StatusOr<Json> JsonParse(absl::string_view json_str) {
-  return JsonReader::Parse(json_str);
+  JsonTreeBuilder builder;
+  absl::Status status = JsonReader::Parse(json_str, &builder);
+  if (!status.ok()) return status;
+  return builder.TakeRoot();
 }
 
 }  // namespace grpc_core
@@ -19,6 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 
@@ -26,9 +27,36 @@
 
 namespace grpc_core {
 
+// Receives the contents of a JSON document, in document order, as
+// JsonParse() reads it. This allows consuming a document without building a
+// Json tree for it.
+// The string_views passed in are only valid for the duration of the call.
+class JsonReaderHandler {
+ public:
+  virtual ~JsonReaderHandler() = default;
+
+  virtual void StartObject() = 0;
+  virtual void EndObject() = 0;
+  virtual void StartArray() = 0;
+  virtual void EndArray() = 0;
+  // Called for each key in an object, before its value.
+  // Returns false if the object already has this key, which the reader
+  // reports as an error (but keeps reading).
+  virtual bool Key(absl::string_view key) = 0;
+  virtual void String(absl::string_view value) = 0;
+  // The number as written in the document.
+  virtual void Number(absl::string_view value) = 0;
+  virtual void Bool(bool value) = 0;
+  virtual void Null() = 0;
+};
+
 // Parses JSON string from json_str.
 absl::StatusOr<Json> JsonParse(absl::string_view json_str);
 
+// Parses JSON string from json_str, passing its contents to handler.
+// If parsing fails, handler has seen some prefix of the document.
+absl::Status JsonParse(absl::string_view json_str, JsonReaderHandler* handler);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_SRC_CORE_LIB_JSON_JSON_READER_H
@@ -91,10 +91,30 @@ class Center : public RefCounted<Center<T>> {
     return Pending{};
   }
 
+  // Send one item, ignoring the queue limit.
+  // Returns true if the item was sent.
+  // Returns false if the receiver has been closed.
+  bool ImmediateSend(T t) {
+    ReleasableMutexLock lock(&mu_);
+    if (receiver_closed_) return false;
+    queue_.push_back(std::move(t));
+    auto receive_waker = std::move(receive_waker_);
+    lock.Release();
+    receive_waker.Wakeup();
+    return true;
+  }
+
   // Mark that the receiver is closed.
+  // Items still queued can never be received, so they are dropped, and
+  // pending senders are woken to see the closure.
   void ReceiverClosed() {
-    MutexLock lock(&mu_);
+    ReleasableMutexLock lock(&mu_);
     receiver_closed_ = true;
+    std::vector<T> dropped;
+    dropped.swap(queue_);
+    auto wakeups = send_wakers_.TakeWakeupSet();
+    lock.Release();
+    wakeups.Wakeup();
   }
 
  private:
@@ -127,6 +147,13 @@ class MpscSender {
     return [this, t = std::move(t)]() mutable { return center_->PollSend(t); };
   }
 
+  // Send one item now, even if that exceeds the receiver's buffer hint.
+  // For senders that cannot wait, such as code running outside an activity.
+  // Returns true if sent, false if the receiver was closed.
+  bool UnbufferedImmediateSend(T t) {
+    return center_->ImmediateSend(std::move(t));
+  }
+
  private:
   friend class MpscReceiver<T>;
   explicit MpscSender(RefCountedPtr<mpscpipe_detail::Center<T>> center)
@@ -167,6 +194,12 @@ class MpscReceiver {
   // Construct a new sender for this receiver.
   MpscSender<T> MakeSender() { return MpscSender<T>(center_); }
 
+  // Close the receiver early: sends fail from now on, as they would once
+  // the receiver is destroyed.
+  void MarkClosed() {
+    if (center_ != nullptr) center_->ReceiverClosed();
+  }
+
   // Return a promise that will resolve to the next item (and remove said item).
   auto Next() {
     return [this]() -> Poll<T> {
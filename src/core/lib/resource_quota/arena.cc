@@ -23,17 +23,23 @@
 #include <atomic>
 #include <new>
 
+#include "absl/types/optional.h"
+
 #include <grpc/support/alloc.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/debug_location.h"
 
 namespace {
 
+constexpr size_t kArenaBaseSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
+
 void* ArenaStorage(size_t initial_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
   initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
+  size_t alloc_size = kArenaBaseSize + initial_size;
   static constexpr size_t alignment =
       (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
@@ -66,11 +72,9 @@ Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
   auto* new_arena = new (ArenaStorage(initial_size))
       Arena(initial_size, alloc_size, memory_allocator);
-  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kArenaBaseSize;
   return std::make_pair(new_arena, first_alloc);
 }
 
@@ -90,8 +94,14 @@ void Arena::DestroyManagedNewObjects() {
 void Arena::Destroy() {
   DestroyManagedNewObjects();
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
+  ArenaPool* pool = pool_;
+  const size_t zone_size = initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(this);
+  if (pool != nullptr) {
+    pool->Recycle(this, zone_size);
+  } else {
+    gpr_free_aligned(this);
+  }
 }
 
 void* Arena::AllocZone(size_t size) {
@@ -180,4 +190,132 @@ void Arena::FreePooled(void* p, std::atomic<FreePoolNode*>* head) {
 }
 #endif
 
+ArenaPool::ArenaPool(MemoryOwner memory_owner)
+    : memory_owner_(std::move(memory_owner)),
+      shards_(PerCpuOptions().SetCpusPerShard(4).SetMaxShards(16)) {}
+
+void ArenaPool::Orphan() {
+  {
+    MutexLock lock(&drain_mu_);
+    orphaned_ = true;
+    DrainAllLocked();
+  }
+  // Destroying the owner cancels any posted reclaimer, which drops its ref.
+  memory_owner_.Reset();
+  Unref();
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(
+    size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
+  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+  absl::optional<Block> block;
+  size_t stale_bytes = 0;
+  {
+    Shard& shard = shards_.this_cpu();
+    MutexLock lock(&shard.mu);
+    while (!shard.blocks.empty()) {
+      Block b = shard.blocks.back();
+      shard.blocks.pop_back();
+      if (b.zone_size >= initial_size) {
+        block = b;
+        break;
+      }
+      // The call size estimate has grown past this block: drop it.
+      stale_bytes += kArenaBaseSize + b.zone_size;
+      gpr_free_aligned(b.storage);
+    }
+  }
+  void* storage;
+  if (block.has_value()) {
+    global_stats().IncrementCallArenaPoolHits();
+    memory_owner_.Release(stale_bytes + kArenaBaseSize + block->zone_size);
+    storage = block->storage;
+    initial_size = block->zone_size;
+  } else {
+    global_stats().IncrementCallArenaPoolMisses();
+    if (stale_bytes != 0) memory_owner_.Release(stale_bytes);
+    storage = ArenaStorage(initial_size);
+  }
+  // Released by Recycle(), so that the pool outlives every arena using it.
+  Ref().release();
+  auto* new_arena =
+      new (storage) Arena(initial_size, alloc_size, memory_allocator, this);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kArenaBaseSize;
+  return std::make_pair(new_arena, first_alloc);
+}
+
+void ArenaPool::Recycle(void* storage, size_t zone_size) {
+  bool cached = false;
+  {
+    Shard& shard = shards_.this_cpu();
+    MutexLock lock(&shard.mu);
+    // Once the pool is orphaned its memory owner is gone, so arenas that
+    // outlive it just free their storage. Orphan() marks each shard under its
+    // lock before dropping the owner, so the owner is valid here otherwise.
+    if (!shard.orphaned && shard.blocks.size() < kMaxCachedPerShard) {
+      // Charge the block to the quota before it becomes visible to the
+      // reclaimer.
+      memory_owner_.Reserve(kArenaBaseSize + zone_size);
+      shard.blocks.push_back(Block{storage, zone_size});
+      cached = true;
+    }
+  }
+  if (cached) {
+    MaybePostReclaimer();
+  } else {
+    gpr_free_aligned(storage);
+  }
+  Unref();
+}
+
+void ArenaPool::MaybePostReclaimer() {
+  if (reclaimer_posted_.load(std::memory_order_relaxed)) return;
+  // Orphan() marks the pool orphaned under drain_mu_ before it resets the
+  // owner, so the owner stays valid while the lock is held and orphaned_ is
+  // false.
+  MutexLock lock(&drain_mu_);
+  if (orphaned_ ||
+      reclaimer_posted_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kBenign,
+      [self = Ref(DEBUG_LOCATION, "ArenaPoolReclaimer")](
+          absl::optional<ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        MutexLock lock(&self->drain_mu_);
+        if (self->orphaned_) return;
+        self->reclaimer_posted_.store(false, std::memory_order_relaxed);
+        self->DrainAllLocked();
+      });
+}
+
+void ArenaPool::DrainAllLocked() {
+  size_t freed_bytes = 0;
+  for (Shard& shard : shards_) {
+    std::vector<Block> blocks;
+    {
+      MutexLock lock(&shard.mu);
+      blocks.swap(shard.blocks);
+      if (orphaned_) shard.orphaned = true;
+    }
+    for (const Block& block : blocks) {
+      freed_bytes += kArenaBaseSize + block.zone_size;
+      gpr_free_aligned(block.storage);
+    }
+  }
+  if (freed_bytes != 0) memory_owner_.Release(freed_bytes);
+}
+
+size_t ArenaPool::TestOnlyCachedBytes() {
+  size_t bytes = 0;
+  for (Shard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (const Block& block : shard.blocks) {
+      bytes += kArenaBaseSize + block.zone_size;
+    }
+  }
+  return bytes;
+}
+
 }  // namespace grpc_core
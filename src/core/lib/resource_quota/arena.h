@@ -33,11 +33,17 @@
 #include <iosfwd>
 #include <memory>
 #include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
 
 #include <grpc/event_engine/memory_allocator.h>
 
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gprpp/construct_destruct.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/context.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 
@@ -46,6 +52,8 @@
 
 namespace grpc_core {
 
+class ArenaPool;
+
 namespace arena_detail {
 
 #ifndef GRPC_ARENA_POOLED_ALLOCATIONS_USE_MALLOC
@@ -152,7 +160,8 @@ class Arena {
   // TODO(ctiller): eliminate ManagedNew.
   void DestroyManagedNewObjects();
 
-  // Destroy an arena.
+  // Destroy an arena. Arenas created by an ArenaPool return their storage
+  // to it.
   void Destroy();
 
   // Return the total amount of memory allocated by this arena.
@@ -365,6 +374,8 @@ class Arena {
 #endif
 
  private:
+  friend class ArenaPool;
+
   struct Zone {
     Zone* prev;
   };
@@ -394,11 +405,14 @@ class Arena {
   //   quick optimization (avoiding an atomic fetch-add) for the common case
   //   where we wish to create an arena and then perform an immediate
   //   allocation.
+  //
+  //   pool: The pool that owns the arena's storage, if any.
   explicit Arena(size_t initial_size, size_t initial_alloc,
-                 MemoryAllocator* memory_allocator)
+                 MemoryAllocator* memory_allocator, ArenaPool* pool = nullptr)
       : total_used_(GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_alloc)),
         initial_zone_size_(initial_size),
-        memory_allocator_(memory_allocator) {}
+        memory_allocator_(memory_allocator),
+        pool_(pool) {}
 
   ~Arena();
 
@@ -441,6 +455,67 @@ class Arena {
 #endif
   // The backing memory quota
   MemoryAllocator* const memory_allocator_;
+  // Where to return the arena's storage on Destroy(), or nullptr to free it.
+  ArenaPool* const pool_;
+};
+
+// A bounded cache of arena storage, shared by the calls on a channel, so that
+// creating and destroying calls in steady state does not go to the allocator.
+// The storage of a destroyed arena is kept, sharded by CPU, and handed to the
+// next arena created with an initial size that fits in it. Cached storage is
+// charged to the memory quota, and freed when the quota comes under pressure.
+//
+// Arenas created by the pool hold a ref to it, so they may outlive the
+// pool's orphaning: their storage is then freed instead of cached.
+class ArenaPool final : public InternallyRefCounted<ArenaPool> {
+ public:
+  // Maximum number of storage blocks cached per shard.
+  static constexpr size_t kMaxCachedPerShard = 4;
+
+  explicit ArenaPool(MemoryOwner memory_owner);
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Frees all cached storage and drops the pool's reclaimer.
+  void Orphan() override;
+
+  // As Arena::CreateWithAlloc, but reusing cached storage when it can.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t initial_size,
+                                           size_t alloc_size,
+                                           MemoryAllocator* memory_allocator);
+
+  // Total bytes of storage currently cached.
+  size_t TestOnlyCachedBytes();
+
+ private:
+  friend class Arena;
+
+  struct Block {
+    void* storage;
+    // Size of the initial zone the storage can hold.
+    size_t zone_size;
+  };
+
+  struct Shard {
+    Mutex mu;
+    std::vector<Block> blocks ABSL_GUARDED_BY(mu);
+    // Set by Orphan(); storage is no longer cached once it is.
+    bool orphaned ABSL_GUARDED_BY(mu) = false;
+  };
+
+  // Takes back the storage of a destroyed arena, and the ref it held.
+  void Recycle(void* storage, size_t zone_size);
+  void MaybePostReclaimer() ABSL_LOCKS_EXCLUDED(drain_mu_);
+  // Frees all cached storage, and marks the shards orphaned if the pool is.
+  void DrainAllLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(drain_mu_);
+
+  MemoryOwner memory_owner_;
+  PerCpu<Shard> shards_;
+  std::atomic<bool> reclaimer_posted_{false};
+  // Serializes posting and running the reclaimer against Orphan().
+  Mutex drain_mu_;
+  bool orphaned_ ABSL_GUARDED_BY(drain_mu_) = false;
 };
 
 // Smart pointer for arenas when the final size is not required.
@@ -46,6 +46,7 @@
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -77,6 +78,12 @@ Channel::Channel(bool is_client, bool is_promising, std::string target,
       allocator_(channel_args.GetObject<ResourceQuota>()
                      ->memory_quota()
                      ->CreateMemoryOwner(target)),
+      arena_pool_(IsCallArenaPoolEnabled()
+                      ? MakeOrphanable<ArenaPool>(
+                            channel_args.GetObject<ResourceQuota>()
+                                ->memory_quota()
+                                ->CreateMemoryOwner(target + " arena pool"))
+                      : nullptr),
       target_(std::move(target)),
       channel_stack_(std::move(channel_stack)) {
   // We need to make sure that grpc_shutdown() does not shut things down
@@ -231,6 +238,14 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
   return CreateWithBuilder(&builder);
 }
 
+std::pair<Arena*, void*> Channel::CreateCallArena(size_t initial_size,
+                                                  size_t alloc_size) {
+  if (arena_pool_ != nullptr) {
+    return arena_pool_->CreateWithAlloc(initial_size, alloc_size, &allocator_);
+  }
+  return Arena::CreateWithAlloc(initial_size, alloc_size, &allocator_);
+}
+
 void Channel::UpdateCallSizeEstimate(size_t size) {
   size_t cur = call_size_estimate_.load(std::memory_order_relaxed);
   if (cur < size) {
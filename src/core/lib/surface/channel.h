@@ -47,11 +47,13 @@
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel_stack_type.h"
@@ -139,6 +141,11 @@ class Channel : public RefCounted<Channel>,
   }
 
   void UpdateCallSizeEstimate(size_t size);
+  // Creates the arena for a call on this channel, as Arena::CreateWithAlloc.
+  // With the call_arena_pool experiment, the arena's storage comes from (and
+  // returns to) a per-channel cache.
+  std::pair<Arena*, void*> CreateCallArena(size_t initial_size,
+                                           size_t alloc_size);
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
   bool is_client() const { return is_client_; }
@@ -172,6 +179,8 @@ class Channel : public RefCounted<Channel>,
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
   MemoryAllocator allocator_;
+  // Recycled call arena storage, or nullptr if the pool is disabled.
+  OrphanablePtr<ArenaPool> arena_pool_;
   std::string target_;
   const RefCountedPtr<grpc_channel_stack> channel_stack_;
 };
@@ -243,6 +243,10 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  // Pops up to max_items completions into out, taking the consumer lock only
+  // once. Returns the number popped, which may be 0 even if the queue is not
+  // empty (see Pop()).
+  size_t PopBatch(grpc_cq_completion** out, size_t max_items);
 
  private:
   // Spinlock to serialize consumers i.e pop() operations
@@ -511,6 +515,27 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+size_t CqEventQueue::PopBatch(grpc_cq_completion** out, size_t max_items) {
+  size_t n = 0;
+
+  if (max_items > 0 && gpr_spinlock_trylock(&queue_lock_)) {
+    while (n < max_items) {
+      bool is_empty = false;
+      grpc_cq_completion* c =
+          reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) break;
+      out[n++] = c;
+    }
+    gpr_spinlock_unlock(&queue_lock_);
+  }
+
+  if (n > 0) {
+    num_queue_items_.fetch_sub(n, std::memory_order_relaxed);
+  }
+
+  return n;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
@@ -956,22 +981,42 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
+// Fills events with completions that are already queued, without polling.
+// Returns the number of events filled.
+static size_t cq_pop_ready_events(cq_next_data* cqd, grpc_event* events,
+                                  size_t max_events) {
+  constexpr size_t kChunkSize = 16;
+  grpc_cq_completion* chunk[kChunkSize];
+  size_t num_events = 0;
+  while (num_events < max_events) {
+    const size_t n = cqd->queue.PopBatch(
+        chunk, std::min(kChunkSize, max_events - num_events));
+    // The done callbacks may do arbitrary work, so run them outside of the
+    // queue lock.
+    for (size_t i = 0; i < n; i++) {
+      grpc_cq_completion* c = chunk[i];
+      grpc_event& ev = events[num_events++];
+      ev.type = GRPC_OP_COMPLETE;
+      ev.success = c->next & 1u;
+      ev.tag = c->tag;
+      c->done(c->done_arg, c);
+    }
+    if (n < kChunkSize) break;
+  }
+  return num_events;
+}
+
+// Shared implementation of grpc_completion_queue_next and
+// grpc_completion_queue_next_batch. Blocks until at least one event is
+// available (or shutdown/timeout), then also takes up to max_events - 1
+// completions that are already queued. Returns the number of events filled in,
+// which is always at least 1.
+static size_t cq_next_internal(grpc_completion_queue* cq, grpc_event* events,
+                               size_t max_events, gpr_timespec deadline) {
   grpc_event ret;
+  size_t num_events = 1;
   cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
-
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
@@ -996,6 +1041,7 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       ret.success = c->next & 1u;
       ret.tag = c->tag;
       c->done(c->done_arg, c);
+      num_events += cq_pop_ready_events(cqd, events + 1, max_events - 1);
       break;
     }
 
@@ -1006,6 +1052,7 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       ret.success = c->next & 1u;
       ret.tag = c->tag;
       c->done(c->done_arg, c);
+      num_events += cq_pop_ready_events(cqd, events + 1, max_events - 1);
       break;
     } else {
       // If c == NULL it means either the queue is empty OR in an transient
@@ -1073,11 +1120,32 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  events[0] = ret;
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_internal(cq, &ret, 1, deadline);
   return ret;
 }
 
@@ -1128,6 +1196,25 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                        grpc_event* events, size_t max_events,
+                                        gpr_timespec deadline, void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%" PRIuPTR
+      ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(max_events > 0);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+  return cq_next_internal(cq, events, max_events, deadline);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
@@ -31,7 +31,11 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
@@ -175,6 +179,11 @@ class Server : public InternallyRefCounted<Server>,
       grpc_server_register_method_payload_handling payload_handling,
       uint32_t flags);
 
+  // Find the registered method for an incoming call, or nullptr if the
+  // call is for an unregistered method.
+  RegisteredMethod* GetRegisteredMethod(absl::string_view host,
+                                        absl::string_view path);
+
   grpc_call_error RequestCall(grpc_call** call, grpc_call_details* details,
                               grpc_metadata_array* request_metadata,
                               grpc_completion_queue* cq_bound_to_call,
@@ -197,17 +206,13 @@ class Server : public InternallyRefCounted<Server>,
 
   void SendGoaways() ABSL_LOCKS_EXCLUDED(mu_global_, mu_call_);
 
+  // Replaces gpr_cpu_current_cpu() as the source of the current CPU for
+  // GRPC_ARG_SERVER_CPU_AFFINE_CQS, or restores it if fn is nullptr.
+  static void TestOnlySetCurrentCpuFn(unsigned (*fn)());
+
  private:
   struct RequestedCall;
 
-  struct ChannelRegisteredMethod {
-    RegisteredMethod* server_registered_method = nullptr;
-    uint32_t flags;
-    bool has_host;
-    Slice method;
-    Slice host;
-  };
-
   class RequestMatcherInterface;
   class RealRequestMatcher;
   class AllocatingRequestMatcherBase;
@@ -227,9 +232,9 @@ class Server : public InternallyRefCounted<Server>,
     RefCountedPtr<Server> server() const { return server_; }
     Channel* channel() const { return channel_.get(); }
     size_t cq_idx() const { return cq_idx_; }
-
-    ChannelRegisteredMethod* GetRegisteredMethod(const grpc_slice& host,
-                                                 const grpc_slice& path);
+    // The index into Server::cqs_ at which to start matching a new incoming
+    // call against requested calls.
+    size_t start_request_queue_index() const;
 
     // Filter vtable functions.
     static grpc_error_handle InitChannelElement(
@@ -254,12 +259,6 @@ class Server : public InternallyRefCounted<Server>,
     // where to publish new incoming calls.
     size_t cq_idx_;
     absl::optional<std::list<ChannelData*>::iterator> list_position_;
-    // A hash-table of the methods and hosts of the registered methods.
-    // TODO(vjpai): Convert this to an STL map type as opposed to a direct
-    // bucket implementation. (Consider performance impact, hash function to
-    // use, etc.)
-    std::unique_ptr<std::vector<ChannelRegisteredMethod>> registered_methods_;
-    uint32_t registered_method_max_probes_;
     grpc_closure finish_destroy_channel_closure_;
     intptr_t channelz_socket_uuid_;
   };
@@ -429,7 +428,13 @@ class Server : public InternallyRefCounted<Server>,
     return shutdown_refs_.load(std::memory_order_acquire) == 0;
   }
 
+  // Index of the CQ serving the CPU the caller is running on, for
+  // GRPC_ARG_SERVER_CPU_AFFINE_CQS.
+  size_t CqIndexForCurrentCpu() const;
+
   ChannelArgs const channel_args_;
+  // Whether GRPC_ARG_SERVER_CPU_AFFINE_CQS is set.
+  const bool cpu_affine_cqs_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
@@ -452,7 +457,26 @@ class Server : public InternallyRefCounted<Server>,
   bool starting_ ABSL_GUARDED_BY(mu_global_) = false;
   CondVar starting_cv_;
 
-  std::vector<std::unique_ptr<RegisteredMethod>> registered_methods_;
+  // Hash and equality for (host, method) keys, allowing lookup by
+  // string_view pairs without copying the strings.
+  struct StringViewStringViewPairHash
+      : absl::flat_hash_set<
+            std::pair<absl::string_view, absl::string_view>>::hasher {
+    using is_transparent = void;
+  };
+  struct StringViewStringViewPairEq
+      : std::equal_to<std::pair<absl::string_view, absl::string_view>> {
+    using is_transparent = void;
+  };
+
+  // Registered methods keyed by (host, method); host is empty for methods
+  // that match any host. Only mutated before Start(), so lookups need no lock.
+  absl::flat_hash_map<std::pair<std::string, std::string>,
+                      std::unique_ptr<RegisteredMethod>,
+                      StringViewStringViewPairHash, StringViewStringViewPairEq>
+      registered_methods_;
+  // True if any method was registered for a specific host.
+  bool has_host_specific_methods_ = false;
 
   // Request matcher for unregistered methods.
   std::unique_ptr<RequestMatcherInterface> unregistered_request_matcher_;
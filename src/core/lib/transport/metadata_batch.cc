@@ -34,32 +34,110 @@ void DebugStringBuilder::Add(absl::string_view key, absl::string_view value) {
   absl::StrAppend(&out_, absl::CEscape(key), ": ", absl::CEscape(value));
 }
 
+template <typename F>
+void UnknownMap::ForEachIndexedMatch(absl::string_view key, F f) const {
+  const size_t hash = HashUnknownKey(key);
+  const size_t mask = index_capacity_ - 1;
+  for (size_t i = hash & mask; index_[i].entry != nullptr;
+       i = (i + 1) & mask) {
+    if (index_[i].hash == hash &&
+        index_[i].entry->first.as_string_view() == key) {
+      f(*index_[i].entry);
+    }
+  }
+}
+
 void UnknownMap::Append(absl::string_view key, Slice value) {
-  unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+  const auto* entry = AppendEntry(key, std::move(value));
+  if (entry != nullptr) IndexInsert(HashUnknownKey(key), entry);
+}
+
+void UnknownMap::Append(absl::string_view key, Slice value,
+                        size_t key_hash) {
+  const auto* entry = AppendEntry(key, std::move(value));
+  if (entry != nullptr) IndexInsert(key_hash, entry);
+}
+
+const std::pair<Slice, Slice>* UnknownMap::AppendEntry(absl::string_view key,
+                                                       Slice value) {
+  const auto* entry =
+      unknown_.EmplaceBack(Slice::FromCopiedString(key), std::move(value));
+  ++count_;
+  if (index_ != nullptr && 2 * count_ <= index_capacity_) return entry;
+  if (count_ > kIndexThreshold) RebuildIndex();
+  return nullptr;
 }
 
 void UnknownMap::Remove(absl::string_view key) {
+  if (index_ != nullptr) {
+    bool found = false;
+    ForEachIndexedMatch(key, [&found](const std::pair<Slice, Slice>&) {
+      found = true;
+    });
+    if (!found) return;
+  }
   unknown_.SetEnd(std::remove_if(unknown_.begin(), unknown_.end(),
                                  [key](const std::pair<Slice, Slice>& p) {
                                    return p.first.as_string_view() == key;
                                  }));
+  count_ = unknown_.size();
+  // remove_if moved entries around: the index no longer points at the right
+  // ones.
+  if (index_ != nullptr) RebuildIndex();
 }
 
 absl::optional<absl::string_view> UnknownMap::GetStringValue(
     absl::string_view key, std::string* backing) const {
   absl::optional<absl::string_view> out;
-  for (const auto& p : unknown_) {
-    if (p.first.as_string_view() == key) {
-      if (!out.has_value()) {
-        out = p.second.as_string_view();
-      } else {
-        out = *backing = absl::StrCat(*out, ",", p.second.as_string_view());
-      }
+  auto add = [&out, backing](const std::pair<Slice, Slice>& p) {
+    if (!out.has_value()) {
+      out = p.second.as_string_view();
+    } else {
+      out = *backing = absl::StrCat(*out, ",", p.second.as_string_view());
     }
+  };
+  if (index_ != nullptr) {
+    ForEachIndexedMatch(key, add);
+    return out;
+  }
+  for (const auto& p : unknown_) {
+    if (p.first.as_string_view() == key) add(p);
   }
   return out;
 }
 
+void UnknownMap::Clear() {
+  unknown_.Clear();
+  count_ = 0;
+  // Index memory belongs to the arena; just forget about it.
+  index_ = nullptr;
+  index_capacity_ = 0;
+}
+
+void UnknownMap::RebuildIndex() {
+  if (2 * count_ > index_capacity_) {
+    size_t capacity = 4 * kIndexThreshold;
+    while (capacity < 4 * count_) capacity *= 2;
+    index_ = static_cast<IndexSlot*>(
+        unknown_.arena()->Alloc(capacity * sizeof(IndexSlot)));
+    index_capacity_ = capacity;
+  }
+  for (size_t i = 0; i < index_capacity_; i++) {
+    index_[i] = IndexSlot{0, nullptr};
+  }
+  for (const auto& p : unknown_) {
+    IndexInsert(HashUnknownKey(p.first.as_string_view()), &p);
+  }
+}
+
+void UnknownMap::IndexInsert(size_t hash,
+                             const std::pair<Slice, Slice>* entry) {
+  const size_t mask = index_capacity_ - 1;
+  size_t i = hash & mask;
+  while (index_[i].entry != nullptr) i = (i + 1) & mask;
+  index_[i] = IndexSlot{hash, entry};
+}
+
 }  // namespace metadata_detail
 
 ContentTypeMetadata::MementoType ContentTypeMetadata::ParseMemento(
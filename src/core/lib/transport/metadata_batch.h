@@ -250,10 +250,10 @@ struct GrpcAcceptEncodingMetadata {
   }
   static ValueType MementoToValue(MementoType x) { return x; }
   static Slice Encode(ValueType x) { return x.ToSlice(); }
-  static absl::string_view DisplayValue(ValueType x) { return x.ToString(); }
-  static absl::string_view DisplayMemento(MementoType x) {
-    return DisplayValue(x);
+  static std::string DisplayValue(ValueType x) {
+    return std::string(x.ToSlice().as_string_view());
   }
+  static std::string DisplayMemento(MementoType x) { return DisplayValue(x); }
 };
 
 // user-agent metadata trait.
@@ -1014,13 +1014,37 @@ class TransportSizeEncoder {
 };
 
 // Handle unknown (non-trait-based) fields in the metadata map.
+// Entries are kept in arrival order. Once more than kIndexThreshold entries
+// are present we additionally maintain an open addressed (linear probing) hash
+// index over them, allocated from the arena, so that lookups do not need to
+// string compare against every entry.
 class UnknownMap {
  public:
   explicit UnknownMap(Arena* arena) : unknown_(arena) {}
+  UnknownMap(const UnknownMap&) = delete;
+  UnknownMap& operator=(const UnknownMap&) = delete;
+  UnknownMap(UnknownMap&& other) noexcept
+      : unknown_(std::move(other.unknown_)),
+        count_(std::exchange(other.count_, 0)),
+        index_(std::exchange(other.index_, nullptr)),
+        index_capacity_(std::exchange(other.index_capacity_, 0)) {}
+  UnknownMap& operator=(UnknownMap&& other) noexcept {
+    unknown_ = std::move(other.unknown_);
+    std::swap(count_, other.count_);
+    std::swap(index_, other.index_);
+    std::swap(index_capacity_, other.index_capacity_);
+    return *this;
+  }
 
   using BackingType = ChunkedVector<std::pair<Slice, Slice>, 10>;
 
+  // Number of entries beyond which lookups go through the hash index.
+  static constexpr size_t kIndexThreshold = 8;
+
+  // The key is only hashed once the index exists.
   void Append(absl::string_view key, Slice value);
+  // As above, but with key_hash == HashUnknownKey(key) precomputed.
+  void Append(absl::string_view key, Slice value, size_t key_hash);
   void Remove(absl::string_view key);
   absl::optional<absl::string_view> GetStringValue(absl::string_view key,
                                                    std::string* backing) const;
@@ -1028,14 +1052,40 @@ class UnknownMap {
   BackingType::ConstForwardIterator begin() const { return unknown_.cbegin(); }
   BackingType::ConstForwardIterator end() const { return unknown_.cend(); }
 
-  bool empty() const { return unknown_.empty(); }
-  size_t size() const { return unknown_.size(); }
-  void Clear() { unknown_.Clear(); }
+  bool empty() const { return count_ == 0; }
+  size_t size() const { return count_; }
+  void Clear();
   Arena* arena() const { return unknown_.arena(); }
 
  private:
+  struct IndexSlot {
+    size_t hash;
+    // nullptr for an empty slot.
+    const std::pair<Slice, Slice>* entry;
+  };
+
+  // Add an entry, rebuilding the index if it has to grow.  Returns the entry
+  // if the caller still has to insert it in the index, nullptr otherwise.
+  const std::pair<Slice, Slice>* AppendEntry(absl::string_view key,
+                                             Slice value);
+  // (Re)build the index from scratch over all entries, growing it if needed.
+  void RebuildIndex();
+  void IndexInsert(size_t hash, const std::pair<Slice, Slice>* entry);
+  // Call f for each entry with this key, in arrival order.
+  // Requires index_ != nullptr.
+  template <typename F>
+  void ForEachIndexedMatch(absl::string_view key, F f) const;
+
   // Backing store for added metadata.
-  ChunkedVector<std::pair<Slice, Slice>, 10> unknown_;
+  BackingType unknown_;
+  // Number of entries in unknown_.
+  size_t count_ = 0;
+  // Hash index over unknown_, or nullptr if count_ has not yet passed
+  // kIndexThreshold. index_capacity_ is a power of two, kept at least twice
+  // count_. Slots are never deleted individually, so entries sharing a key
+  // appear along their probe sequence in arrival order.
+  IndexSlot* index_ = nullptr;
+  size_t index_capacity_ = 0;
 };
 
 // Given a factory template Factory, construct a type that derives from
@@ -25,6 +25,7 @@
 #include <utility>
 
 #include "absl/functional/function_ref.h"
+#include "absl/hash/hash.h"
 #include "absl/meta/type_traits.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
@@ -109,6 +110,24 @@ void SetSliceValue(Slice* set, const Buffer& value) {
   *set = MementoToValue(SliceFromBuffer(value));
 }
 
+// Hash of an unknown metadata key, as used by the unknown metadata index in
+// MetadataMap.
+inline size_t HashUnknownKey(absl::string_view key) {
+  return absl::Hash<absl::string_view>()(key);
+}
+
+// Storage for a key/value pair that does not correspond to any trait.
+// The key hash is computed once at parse time so that every batch this
+// metadata is set on (eg. each use of an HPACK dynamic table entry) can skip
+// rehashing the key.
+struct UnknownKeyValue {
+  UnknownKeyValue(Slice key, Slice value, size_t key_hash)
+      : key(std::move(key)), value(std::move(value)), key_hash(key_hash) {}
+  Slice key;
+  Slice value;
+  size_t key_hash;
+};
+
 }  // namespace metadata_detail
 
 // A parsed metadata value.
@@ -161,8 +180,10 @@ class ParsedMetadata {
   ParsedMetadata(FromSlicePair, Slice key, Slice value, uint32_t transport_size)
       : vtable_(ParsedMetadata::KeyValueVTable(key.as_string_view())),
         transport_size_(transport_size) {
-    value_.pointer =
-        new std::pair<Slice, Slice>(std::move(key), std::move(value));
+    const size_t key_hash =
+        metadata_detail::HashUnknownKey(key.as_string_view());
+    value_.pointer = new metadata_detail::UnknownKeyValue(
+        std::move(key), std::move(value), key_hash);
   }
   ParsedMetadata() : vtable_(EmptyVTable()), transport_size_(0) {}
   ~ParsedMetadata() { vtable_->destroy(value_); }
@@ -390,37 +411,39 @@ ParsedMetadata<MetadataContainer>::SliceTraitVTable() {
 template <typename MetadataContainer>
 const typename ParsedMetadata<MetadataContainer>::VTable*
 ParsedMetadata<MetadataContainer>::KeyValueVTable(absl::string_view key) {
-  using KV = std::pair<Slice, Slice>;
+  using KV = metadata_detail::UnknownKeyValue;
   static const auto destroy = [](const Buffer& value) {
     delete static_cast<KV*>(value.pointer);
   };
   static const auto set = [](const Buffer& value, MetadataContainer* map) {
     auto* p = static_cast<KV*>(value.pointer);
-    map->unknown_.Append(p->first.as_string_view(), p->second.Ref());
+    map->unknown_.Append(p->key.as_string_view(), p->value.Ref(),
+                         p->key_hash);
   };
   static const auto with_new_value =
       [](Slice* value, bool will_keep_past_request_lifetime,
          MetadataParseErrorFn, ParsedMetadata* result) {
-        auto* p = new KV{
-            static_cast<KV*>(result->value_.pointer)->first.Ref(),
+        auto* old = static_cast<KV*>(result->value_.pointer);
+        auto* p = new KV(
+            old->key.Ref(),
             will_keep_past_request_lifetime && IsUniqueMetadataStringsEnabled()
                 ? value->TakeUniquelyOwned()
                 : std::move(*value),
-        };
+            old->key_hash);
         result->value_.pointer = p;
       };
   static const auto debug_string = [](const Buffer& value) {
     auto* p = static_cast<KV*>(value.pointer);
-    return absl::StrCat(p->first.as_string_view(), ": ",
-                        p->second.as_string_view());
+    return absl::StrCat(p->key.as_string_view(), ": ",
+                        p->value.as_string_view());
   };
   static const auto binary_debug_string = [](const Buffer& value) {
     auto* p = static_cast<KV*>(value.pointer);
-    return absl::StrCat(p->first.as_string_view(), ": \"",
-                        absl::CEscape(p->second.as_string_view()), "\"");
+    return absl::StrCat(p->key.as_string_view(), ": \"",
+                        absl::CEscape(p->value.as_string_view()), "\"");
   };
   static const auto key_fn = [](const Buffer& value) {
-    return static_cast<KV*>(value.pointer)->first.as_string_view();
+    return static_cast<KV*>(value.pointer)->key.as_string_view();
   };
   static const VTable vtable[2] = {
       {false, destroy, set, with_new_value, debug_string, "", key_fn},
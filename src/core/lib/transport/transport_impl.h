@@ -53,17 +53,22 @@ typedef struct grpc_transport_vtable {
                      grpc_stream_refcount* refcount, const void* server_data,
                      grpc_core::Arena* arena);
 
-  // Create a promise to execute one client call.
+  // Create a promise to execute one call.
   // If this is non-null, it may be used in preference to
   // perform_stream_op.
   // If this is used in preference to perform_stream_op, the
   // following can be omitted also:
   //   - calling init_stream, destroy_stream, set_pollset, set_pollset_set
   //   - allocation of memory for call data (sizeof_stream may be ignored)
+  // On clients, call_args carries the call and next is unused.  On servers
+  // the transport sits at the bottom of the stack: call_args is empty, and
+  // the transport fills it in from the stream (identified by the server
+  // stream data it passed to accept_stream) and calls next with it.
   // There is an on-going migration to move all filters to providing this, and
   // then to drop perform_stream_op.
   grpc_core::ArenaPromise<grpc_core::ServerMetadataHandle> (*make_call_promise)(
-      grpc_transport* self, grpc_core::CallArgs call_args);
+      grpc_transport* self, grpc_core::CallArgs call_args,
+      grpc_core::NextPromiseFactory next);
 
   // implementation of grpc_transport_set_pollset
   void (*set_pollset)(grpc_transport* self, grpc_stream* stream,
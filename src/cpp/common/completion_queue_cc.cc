@@ -15,6 +15,7 @@
 //
 //
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -162,6 +163,51 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+CompletionQueue::NextStatus CompletionQueue::AsyncNextBatchInternal(
+    Event* events, size_t max_events, size_t* num_events,
+    gpr_timespec deadline) {
+  // Events are read from the core in chunks of this many; a full chunk is
+  // followed by non-blocking reads until max_events is reached or the queue
+  // has nothing more ready.
+  constexpr size_t kMaxCoreEvents = 64;
+  grpc_event core_events[kMaxCoreEvents];
+  size_t out = 0;
+  for (;;) {
+    const size_t chunk = std::min(max_events - out, kMaxCoreEvents);
+    size_t n = grpc_completion_queue_next_batch(
+        cq_, core_events, chunk,
+        out == 0 ? deadline : gpr_inf_past(GPR_CLOCK_MONOTONIC), nullptr);
+    switch (core_events[0].type) {
+      case GRPC_QUEUE_TIMEOUT:
+      case GRPC_QUEUE_SHUTDOWN:
+        if (out > 0) {
+          *num_events = out;
+          return GOT_EVENT;
+        }
+        return core_events[0].type == GRPC_QUEUE_TIMEOUT ? TIMEOUT : SHUTDOWN;
+      case GRPC_OP_COMPLETE:
+        break;
+    }
+    // Tags whose FinalizeResult returns false are internal and are not
+    // surfaced to the application.
+    for (size_t i = 0; i < n; i++) {
+      auto core_cq_tag =
+          static_cast<grpc::internal::CompletionQueueTag*>(core_events[i].tag);
+      void* tag = core_cq_tag;
+      bool ok = core_events[i].success != 0;
+      if (core_cq_tag->FinalizeResult(&tag, &ok)) {
+        events[out].tag = tag;
+        events[out].ok = ok;
+        ++out;
+      }
+    }
+    if (out > 0 && (n < chunk || out == max_events)) {
+      *num_events = out;
+      return GOT_EVENT;
+    }
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
@@ -165,6 +165,10 @@ void ServerBuilder::experimental_type::EnableCallMetricRecording(
   builder_->server_metric_recorder_ = server_metric_recorder;
 }
 
+void ServerBuilder::experimental_type::EnableCpuAffineCompletionQueues() {
+  builder_->AddChannelArgument(GRPC_ARG_SERVER_CPU_AFFINE_CQS, 1);
+}
+
 ServerBuilder& ServerBuilder::SetOption(
     std::unique_ptr<ServerBuilderOption> option) {
   options_.push_back(std::move(option));
@@ -21,11 +21,17 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include "absl/status/statusor.h"
 #include "gtest/gtest.h"
 
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_reader.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_core {
@@ -128,6 +134,85 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ConcurrentRegistration) {
+  const int kThreads = 8;
+  const int kNodesPerThread = 1000;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<RefCountedPtr<BaseNode>>> kept(kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&kept, t]() {
+      for (int i = 0; i < kNodesPerThread; ++i) {
+        RefCountedPtr<BaseNode> node = CreateTestNode();
+        EXPECT_EQ(ChannelzRegistry::Get(node->uuid()), node);
+        // Keep every other node registered, and let the rest unregister.
+        if (i % 2 == 0) kept[t].push_back(std::move(node));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::vector<intptr_t> uuids;
+  for (const auto& nodes : kept) {
+    for (const auto& node : nodes) {
+      EXPECT_EQ(ChannelzRegistry::Get(node->uuid()), node);
+      uuids.push_back(node->uuid());
+    }
+  }
+  std::sort(uuids.begin(), uuids.end());
+  EXPECT_EQ(std::unique(uuids.begin(), uuids.end()), uuids.end())
+      << "Uuids must be unique";
+}
+
+// Nodes registered before the first page is read are each returned once, in
+// uuid order, however many nodes register and unregister meanwhile.
+TEST_F(ChannelzRegistryTest, PaginationWithConcurrentRegistration) {
+  const int kServers = 250;
+  std::vector<RefCountedPtr<BaseNode>> servers;
+  std::vector<intptr_t> expected;
+  for (int i = 0; i < kServers; ++i) {
+    servers.push_back(MakeRefCounted<ServerNode>(0));
+    expected.push_back(servers.back()->uuid());
+    // Nodes coming and going between them.
+    MakeRefCounted<ServerNode>(0);
+  }
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&done]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        RefCountedPtr<BaseNode> node = MakeRefCounted<ServerNode>(0);
+      }
+    });
+  }
+  std::vector<intptr_t> seen;
+  intptr_t start_id = 0;
+  bool end = false;
+  while (!end) {
+    auto json = JsonParse(ChannelzRegistry::GetServers(start_id));
+    if (!json.ok()) {
+      ADD_FAILURE() << json.status();
+      break;
+    }
+    const Json::Object& object = json->object();
+    end = object.find("end") != object.end();
+    auto it = object.find("server");
+    if (it == object.end()) continue;
+    for (const Json& server : it->second.array()) {
+      const Json& ref = server.object().at("ref");
+      intptr_t uuid =
+          strtol(ref.object().at("serverId").string().c_str(), nullptr, 0);
+      EXPECT_GE(uuid, start_id);
+      seen.push_back(uuid);
+      start_id = uuid + 1;
+    }
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) thread.join();
+  for (intptr_t uuid : expected) {
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), uuid), 1)
+        << "server " << uuid;
+  }
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
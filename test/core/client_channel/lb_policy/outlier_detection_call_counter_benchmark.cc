@@ -0,0 +1,174 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/call_counter.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/sharded_weight.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace {
+
+const size_t kNumAddresses = 16;
+
+// The layout outlier detection used before the counts were sharded: one
+// pair of atomics per interval, shared by every cpu.
+class SharedCallCounter {
+ public:
+  void AddSuccess() {
+    active_.load(std::memory_order_relaxed)
+        ->successes.fetch_add(1, std::memory_order_relaxed);
+  }
+
+ private:
+  struct Bucket {
+    std::atomic<uint64_t> successes{0};
+    std::atomic<uint64_t> failures{0};
+  };
+
+  Bucket current_;
+  std::atomic<Bucket*> active_{&current_};
+};
+
+// Picks an address the way WRR does and records a successful call to it.
+// Every thread shares the scheduler and the counters, as calls on one
+// channel do.
+template <typename Counter>
+void BM_PickAndRecord(benchmark::State& state) {
+  static NoDestruct<std::vector<Counter>> counters(kNumAddresses);
+  static NoDestruct<std::atomic<uint32_t>> sequence;
+  static const NoDestruct<StaticStrideScheduler> scheduler([] {
+    absl::optional<StaticStrideScheduler> scheduler =
+        StaticStrideScheduler::Make(
+            std::vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                               15, 16},
+            [] {
+              return sequence->fetch_add(1, std::memory_order_relaxed);
+            });
+    GPR_ASSERT(scheduler.has_value());
+    return std::move(*scheduler);
+  }());
+  ExecCtx exec_ctx;
+  for (auto s : state) {
+    (*counters)[scheduler->Pick()].AddSuccess();
+  }
+}
+BENCHMARK_TEMPLATE(BM_PickAndRecord, SharedCallCounter)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PickAndRecord, OutlierDetectionCallCounter)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// The layout WRR used before the weights were sharded: one mutex per
+// address, taken by every call that reports the address's weight.
+class SharedWeight {
+ public:
+  void Update(float weight, Timestamp now) {
+    MutexLock lock(&mu_);
+    if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+    weight_ = weight;
+    last_update_time_ = now;
+  }
+
+ private:
+  Mutex mu_;
+  float weight_ ABSL_GUARDED_BY(&mu_) = 0;
+  Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
+  Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+};
+
+// Picks an address the way WRR does and reports its weight, as WRR's call
+// tracker does for every call that carries backend metrics.
+template <typename Weight>
+void BM_PickAndReportWeight(benchmark::State& state) {
+  static NoDestruct<std::vector<Weight>> weights(kNumAddresses);
+  static NoDestruct<std::atomic<uint32_t>> sequence;
+  static const NoDestruct<StaticStrideScheduler> scheduler([] {
+    absl::optional<StaticStrideScheduler> scheduler =
+        StaticStrideScheduler::Make(
+            std::vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                               15, 16},
+            [] {
+              return sequence->fetch_add(1, std::memory_order_relaxed);
+            });
+    GPR_ASSERT(scheduler.has_value());
+    return std::move(*scheduler);
+  }());
+  ExecCtx exec_ctx;
+  for (auto s : state) {
+    (*weights)[scheduler->Pick()].Update(100, Timestamp::Now());
+  }
+}
+BENCHMARK_TEMPLATE(BM_PickAndReportWeight, SharedWeight)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PickAndReportWeight, ShardedWeight)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Cost of summing the shards when the ejection timer runs.
+void BM_RotateAndAggregate(benchmark::State& state) {
+  OutlierDetectionCallCounter counter;
+  for (auto s : state) {
+    counter.Rotate();
+    benchmark::DoNotOptimize(counter.GetLastIntervalCounts());
+  }
+}
+BENCHMARK(BM_RotateAndAggregate);
+
+// Cost of combining the shards when WRR's weight update timer runs.
+void BM_CombineWeight(benchmark::State& state) {
+  ShardedWeight weight;
+  ExecCtx exec_ctx;
+  weight.Update(100, Timestamp::Now());
+  for (auto s : state) {
+    benchmark::DoNotOptimize(weight.Get());
+  }
+}
+BENCHMARK(BM_CombineWeight);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
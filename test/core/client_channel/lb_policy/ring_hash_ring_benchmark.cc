@@ -0,0 +1,114 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/random/random.h"
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_core {
+namespace {
+
+// Ring size bounds used by the benchmarks: the ring_hash defaults, with the
+// max raised so that large endpoint counts still get several points each.
+const size_t kMinRingSize = 1024;
+const size_t kMaxRingSize = 65536;
+
+std::vector<RingHashRing::Endpoint> MakeEndpoints(size_t begin, size_t end) {
+  std::vector<RingHashRing::Endpoint> endpoints;
+  endpoints.reserve(end - begin);
+  for (size_t i = begin; i < end; ++i) {
+    RingHashRing::Endpoint endpoint;
+    endpoint.address = absl::StrCat("10.", i / 65536, ".", i / 256 % 256, ".",
+                                    i % 256, ":443");
+    endpoints.push_back(std::move(endpoint));
+  }
+  return endpoints;
+}
+
+// Builds a ring from scratch.
+void BM_RingHashRingBuild(benchmark::State& state) {
+  const auto endpoints = MakeEndpoints(0, state.range(0));
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        RingHashRing::Build(endpoints, kMinRingSize, kMaxRingSize, nullptr));
+  }
+}
+BENCHMARK(BM_RingHashRingBuild)->Arg(10)->Arg(1000)->Arg(10000);
+
+// Rebuilds a ring after one endpoint was replaced, reusing the hashes of
+// the previous ring.
+void BM_RingHashRingBuildIncremental(benchmark::State& state) {
+  const size_t n = state.range(0);
+  const auto previous = RingHashRing::Build(MakeEndpoints(0, n), kMinRingSize,
+                                            kMaxRingSize, nullptr);
+  const auto endpoints = MakeEndpoints(1, n + 1);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(RingHashRing::Build(
+        endpoints, kMinRingSize, kMaxRingSize, previous.get()));
+  }
+}
+BENCHMARK(BM_RingHashRingBuildIncremental)->Arg(10)->Arg(1000)->Arg(10000);
+
+// Gets a ring that another channel already holds.
+void BM_RingHashRingGetShared(benchmark::State& state) {
+  const auto endpoints = MakeEndpoints(0, state.range(0));
+  const auto held =
+      RingHashRing::Get(endpoints, kMinRingSize, kMaxRingSize, nullptr);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        RingHashRing::Get(endpoints, kMinRingSize, kMaxRingSize, nullptr));
+  }
+}
+BENCHMARK(BM_RingHashRingGetShared)->Arg(10)->Arg(1000)->Arg(10000);
+
+void BM_RingHashRingPick(benchmark::State& state) {
+  const auto ring = RingHashRing::Build(MakeEndpoints(0, state.range(0)),
+                                        kMinRingSize, kMaxRingSize, nullptr);
+  absl::BitGen bit_gen;
+  std::vector<uint64_t> hashes(1024);
+  for (uint64_t& hash : hashes) hash = absl::Uniform<uint64_t>(bit_gen);
+  size_t i = 0;
+  for (auto s : state) {
+    const size_t index = ring->FindIndex(hashes[i++ % hashes.size()]);
+    benchmark::DoNotOptimize(ring->ring()[index].endpoint_index);
+  }
+}
+BENCHMARK(BM_RingHashRingPick)->Arg(10)->Arg(1000)->Arg(10000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
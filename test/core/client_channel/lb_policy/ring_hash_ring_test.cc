@@ -0,0 +1,133 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash_ring.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_core {
+namespace {
+
+std::vector<RingHashRing::Endpoint> MakeEndpoints(size_t begin, size_t end) {
+  std::vector<RingHashRing::Endpoint> endpoints;
+  for (size_t i = begin; i < end; ++i) {
+    RingHashRing::Endpoint endpoint;
+    endpoint.address = absl::StrCat("10.0.", i / 256, ".", i % 256, ":443");
+    endpoint.weight = 1 + i % 3;
+    endpoints.push_back(std::move(endpoint));
+  }
+  return endpoints;
+}
+
+// Returns the ring as (hash, address, replica) triples, which do not
+// depend on endpoint order.
+std::vector<std::tuple<uint64_t, std::string, uint32_t>> Contents(
+    const RingHashRing& ring) {
+  std::vector<std::tuple<uint64_t, std::string, uint32_t>> contents;
+  for (const auto& entry : ring.ring()) {
+    contents.emplace_back(entry.hash,
+                          ring.endpoints()[entry.endpoint_index].address,
+                          entry.replica);
+  }
+  std::sort(contents.begin(), contents.end());
+  return contents;
+}
+
+TEST(RingHashRingTest, RingIsSorted) {
+  auto ring = RingHashRing::Build(MakeEndpoints(0, 10), 1024, 4096, nullptr);
+  ASSERT_GE(ring->ring().size(), 1024u);
+  EXPECT_TRUE(std::is_sorted(
+      ring->ring().begin(), ring->ring().end(),
+      [](const RingHashRing::Entry& a, const RingHashRing::Entry& b) {
+        return a.hash < b.hash;
+      }));
+}
+
+TEST(RingHashRingTest, FindIndex) {
+  auto ring = RingHashRing::Build(MakeEndpoints(0, 10), 64, 64, nullptr);
+  const auto& entries = ring->ring();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EXPECT_EQ(ring->FindIndex(entries[i].hash), i);
+    if (i > 0 && entries[i].hash != entries[i - 1].hash + 1) {
+      EXPECT_EQ(ring->FindIndex(entries[i].hash - 1), i);
+    }
+  }
+  // Hashes past the last entry wrap around to the first one.
+  if (entries.back().hash != UINT64_MAX) {
+    EXPECT_EQ(ring->FindIndex(entries.back().hash + 1), 0u);
+  }
+  EXPECT_EQ(ring->FindIndex(0), 0u);
+}
+
+TEST(RingHashRingTest, IncrementalBuildMatchesFullBuild) {
+  auto previous =
+      RingHashRing::Build(MakeEndpoints(0, 100), 1024, 4096, nullptr);
+  // Remove some endpoints, add others and reorder them.
+  auto endpoints = MakeEndpoints(20, 130);
+  std::reverse(endpoints.begin(), endpoints.end());
+  auto incremental =
+      RingHashRing::Build(endpoints, 1024, 4096, previous.get());
+  auto full = RingHashRing::Build(endpoints, 1024, 4096, nullptr);
+  EXPECT_EQ(Contents(*incremental), Contents(*full));
+}
+
+TEST(RingHashRingTest, IncrementalBuildWithDuplicateAddresses) {
+  auto previous =
+      RingHashRing::Build(MakeEndpoints(0, 10), 1024, 4096, nullptr);
+  auto endpoints = MakeEndpoints(0, 10);
+  endpoints.push_back(endpoints.front());
+  auto incremental =
+      RingHashRing::Build(endpoints, 1024, 4096, previous.get());
+  auto full = RingHashRing::Build(endpoints, 1024, 4096, nullptr);
+  EXPECT_EQ(Contents(*incremental), Contents(*full));
+}
+
+TEST(RingHashRingTest, GetSharesIdenticalRings) {
+  auto ring1 = RingHashRing::Get(MakeEndpoints(0, 10), 1024, 4096, nullptr);
+  auto ring2 = RingHashRing::Get(MakeEndpoints(0, 10), 1024, 4096, nullptr);
+  EXPECT_EQ(ring1.get(), ring2.get());
+  auto ring3 = RingHashRing::Get(MakeEndpoints(0, 10), 1024, 2048, nullptr);
+  EXPECT_NE(ring1.get(), ring3.get());
+  auto ring4 = RingHashRing::Get(MakeEndpoints(0, 11), 1024, 4096, nullptr);
+  EXPECT_NE(ring1.get(), ring4.get());
+}
+
+TEST(RingHashRingTest, GetBuildsNewRingAfterLastRefIsDropped) {
+  auto ring = RingHashRing::Get(MakeEndpoints(0, 10), 16, 16, nullptr);
+  const auto contents = Contents(*ring);
+  ring.reset();
+  ring = RingHashRing::Get(MakeEndpoints(0, 10), 16, 16, nullptr);
+  EXPECT_EQ(Contents(*ring), contents);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
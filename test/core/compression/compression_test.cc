@@ -25,6 +25,7 @@
 #include <grpc/slice.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gpr/useful.h"
 #include "test/core/util/test_config.h"
 
@@ -240,6 +241,23 @@ TEST(CompressionTest, CompressionEnableDisableAlgorithm) {
   }
 }
 
+TEST(CompressionTest, AcceptEncodingWithDeflateDictionary) {
+  grpc_core::CompressionAlgorithmSet set{GRPC_COMPRESS_NONE,
+                                         GRPC_COMPRESS_DEFLATE};
+  set.SetDeflateDictionaryId(0x00abcdef);
+  ASSERT_EQ(set.ToSlice().as_string_view(),
+            "identity,deflate,deflate-dict-00abcdef");
+  auto parsed = grpc_core::CompressionAlgorithmSet::FromString(
+      set.ToSlice().as_string_view());
+  ASSERT_EQ(parsed, set);
+  ASSERT_EQ(parsed.deflate_dictionary_id(), 0x00abcdefu);
+  // Malformed dictionary tokens are ignored like unknown algorithms.
+  parsed = grpc_core::CompressionAlgorithmSet::FromString(
+      "deflate, deflate-dict-abc, deflate-dict-xyzxyzxy");
+  ASSERT_EQ(parsed, grpc_core::CompressionAlgorithmSet(
+                        {GRPC_COMPRESS_NONE, GRPC_COMPRESS_DEFLATE}));
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
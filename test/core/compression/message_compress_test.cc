@@ -22,14 +22,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <string>
+
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 #include <grpc/compression.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
@@ -301,6 +307,104 @@ TEST(MessageCompressTest, BadDecompressionAlgorithm) {
   grpc_slice_buffer_destroy(&output);
 }
 
+TEST(MessageCompressTest, ParallelCompressRoundTrip) {
+  auto event_engine = grpc_event_engine::experimental::GetDefaultEventEngine();
+  // Somewhat compressible, and spread over slices that don't line up with the
+  // compression chunks.
+  std::string data;
+  for (int i = 0; data.size() < 100000; i++) {
+    data += absl::StrCat("field", i % 37, "=", i * 7919, ";");
+  }
+  for (int level : {1, -1, 9}) {
+    for (grpc_compression_algorithm algorithm :
+         {GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_GZIP}) {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_core::MessageCompressionOptions options;
+      options.zlib_level = level;
+      options.parallel_chunk_size = 16384;
+      options.event_engine = event_engine.get();
+      grpc_core::SliceBuffer input;
+      for (size_t offset = 0; offset < data.size(); offset += 777) {
+        input.Append(grpc_core::Slice::FromCopiedString(
+            data.substr(offset, 777)));
+      }
+      grpc_core::SliceBuffer compressed;
+      ASSERT_EQ(1, grpc_msg_compress(algorithm, input.c_slice_buffer(),
+                                     compressed.c_slice_buffer(), options));
+      EXPECT_LT(compressed.Length(), data.size());
+      grpc_core::SliceBuffer output;
+      ASSERT_EQ(1, grpc_msg_decompress(algorithm, compressed.c_slice_buffer(),
+                                       output.c_slice_buffer()));
+      EXPECT_EQ(output.JoinIntoString(), data)
+          << "level=" << level << " algorithm=" << algorithm;
+    }
+  }
+}
+
+TEST(MessageCompressTest, DeflateDictionary) {
+  const std::string message =
+      "{\"user_id\": 1234, \"locale\": \"en-US\", \"status\": \"active\"}";
+  const std::string dictionary =
+      "{\"user_id\": , \"locale\": \"en-US\", \"status\": \"active\"}";
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::SliceBuffer input;
+  input.Append(grpc_core::Slice::FromCopiedString(message));
+  // Too small to compress on its own...
+  grpc_core::SliceBuffer plain;
+  ASSERT_EQ(0, grpc_msg_compress(GRPC_COMPRESS_DEFLATE, input.c_slice_buffer(),
+                                 plain.c_slice_buffer()));
+  // ...but not with a dictionary.
+  grpc_core::MessageCompressionOptions options;
+  options.deflate_dictionary = dictionary;
+  grpc_core::SliceBuffer compressed;
+  ASSERT_EQ(1, grpc_msg_compress(GRPC_COMPRESS_DEFLATE, input.c_slice_buffer(),
+                                 compressed.c_slice_buffer(), options));
+  EXPECT_LT(compressed.Length(), message.size());
+  // Decompression needs the same dictionary.
+  grpc_core::SliceBuffer output;
+  EXPECT_EQ(0, grpc_msg_decompress(GRPC_COMPRESS_DEFLATE,
+                                   compressed.c_slice_buffer(),
+                                   output.c_slice_buffer()));
+  grpc_core::MessageDecompressionOptions decompress_options;
+  decompress_options.deflate_dictionary = "some other dictionary";
+  EXPECT_EQ(0, grpc_msg_decompress(
+                   GRPC_COMPRESS_DEFLATE, compressed.c_slice_buffer(),
+                   output.c_slice_buffer(), decompress_options));
+  EXPECT_EQ(output.Length(), 0u);
+  decompress_options.deflate_dictionary = dictionary;
+  ASSERT_EQ(1, grpc_msg_decompress(
+                   GRPC_COMPRESS_DEFLATE, compressed.c_slice_buffer(),
+                   output.c_slice_buffer(), decompress_options));
+  EXPECT_EQ(output.JoinIntoString(), message);
+}
+
+// The first output block is sized from the gzip trailer, which the peer
+// controls; it must stay proportionate to the input and to the largest
+// message the caller accepts.
+TEST(MessageCompressTest, GzipPresizingIsBounded) {
+  const std::string data(1024 * 1024, 'a');
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::SliceBuffer input;
+  input.Append(grpc_core::Slice::FromCopiedString(data));
+  grpc_core::SliceBuffer compressed;
+  ASSERT_EQ(1, grpc_msg_compress(GRPC_COMPRESS_GZIP, input.c_slice_buffer(),
+                                 compressed.c_slice_buffer()));
+  ASSERT_LT(compressed.Length() * 8, data.size());
+  grpc_core::SliceBuffer output;
+  ASSERT_EQ(1, grpc_msg_decompress(GRPC_COMPRESS_GZIP,
+                                   compressed.c_slice_buffer(),
+                                   output.c_slice_buffer()));
+  EXPECT_LE(output[0].length(), compressed.Length() * 8 + 1);
+  EXPECT_EQ(output.JoinIntoString(), data);
+  grpc_core::MessageDecompressionOptions options;
+  options.max_output_size = 2000;
+  grpc_core::SliceBuffer limited_output;
+  ASSERT_EQ(1, grpc_msg_decompress(
+                   GRPC_COMPRESS_GZIP, compressed.c_slice_buffer(),
+                   limited_output.c_slice_buffer(), options));
+  EXPECT_LE(limited_output[0].length(), 2001u);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
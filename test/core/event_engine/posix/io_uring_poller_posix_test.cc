@@ -0,0 +1,211 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/iomgr/port.h"
+
+// IWYU pragma: no_include <ratio>
+
+#ifdef GRPC_LINUX_IO_URING
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "src/core/lib/event_engine/posix_engine/ev_io_uring_linux.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "test/core/event_engine/posix/posix_engine_test_utils.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+namespace {
+
+using namespace std::chrono_literals;
+
+void MakeNonBlockingSocketPair(int sv[2]) {
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+  for (int i = 0; i < 2; ++i) {
+    int flags = fcntl(sv[i], F_GETFL, 0);
+    ASSERT_EQ(fcntl(sv[i], F_SETFL, flags | O_NONBLOCK), 0);
+  }
+}
+
+class IoUringPollerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!IoUringPoller::IsSupported()) {
+      GTEST_SKIP() << "io_uring multishot poll is not supported";
+    }
+    // Closures run inline on the thread calling Work().
+    poller_ = MakeIoUringPoller(&scheduler_);
+    ASSERT_NE(poller_, nullptr);
+    EXPECT_EQ(poller_->Name(), "io_uring");
+  }
+
+  void TearDown() override {
+    if (poller_ != nullptr) {
+      poller_->Shutdown();
+    }
+  }
+
+  // Calls Work() until *done is set or Work() times out.
+  void WorkUntil(const bool* done) {
+    while (!*done) {
+      ASSERT_NE(poller_->Work(24h, []() {}),
+                Poller::WorkResult::kDeadlineExceeded);
+    }
+  }
+
+  TestScheduler scheduler_;
+  IoUringPoller* poller_ = nullptr;
+};
+
+TEST_F(IoUringPollerTest, NotifiesReadAndWrite) {
+  int sv[2];
+  MakeNonBlockingSocketPair(sv);
+  EventHandle* handle = poller_->CreateHandle(sv[0], "test", false);
+  bool writable = false;
+  bool readable = false;
+  // The socket is initially writable.
+  handle->NotifyOnWrite(PosixEngineClosure::TestOnlyToClosure(
+      [&writable](absl::Status status) {
+        EXPECT_TRUE(status.ok());
+        writable = true;
+      }));
+  WorkUntil(&writable);
+  handle->NotifyOnRead(PosixEngineClosure::TestOnlyToClosure(
+      [&readable](absl::Status status) {
+        EXPECT_TRUE(status.ok());
+        readable = true;
+      }));
+  char data = 'a';
+  ASSERT_EQ(write(sv[1], &data, 1), 1);
+  WorkUntil(&readable);
+  // The multishot request stays armed: a second edge needs no re-arming.
+  ASSERT_EQ(read(sv[0], &data, 1), 1);
+  readable = false;
+  handle->NotifyOnRead(PosixEngineClosure::TestOnlyToClosure(
+      [&readable](absl::Status status) {
+        EXPECT_TRUE(status.ok());
+        readable = true;
+      }));
+  ASSERT_EQ(write(sv[1], &data, 1), 1);
+  WorkUntil(&readable);
+  handle->OrphanHandle(nullptr, nullptr, "done");
+  close(sv[1]);
+}
+
+TEST_F(IoUringPollerTest, ShutdownRunsPendingClosures) {
+  int sv[2];
+  MakeNonBlockingSocketPair(sv);
+  EventHandle* handle = poller_->CreateHandle(sv[0], "test", false);
+  absl::Status read_status;
+  bool read_done = false;
+  handle->NotifyOnRead(PosixEngineClosure::TestOnlyToClosure(
+      [&](absl::Status status) {
+        read_status = status;
+        read_done = true;
+      }));
+  handle->ShutdownHandle(absl::UnavailableError("shutdown"));
+  EXPECT_TRUE(read_done);
+  EXPECT_FALSE(read_status.ok());
+  EXPECT_TRUE(handle->IsHandleShutdown());
+  int released_fd = -1;
+  handle->OrphanHandle(nullptr, &released_fd, "done");
+  EXPECT_EQ(released_fd, sv[0]);
+  close(sv[0]);
+  close(sv[1]);
+}
+
+// Completions posted for an orphaned handle must not be delivered to the
+// handle that reuses its slot.
+TEST_F(IoUringPollerTest, DropsCompletionsOfOrphanedHandles) {
+  int first[2];
+  int second[2];
+  MakeNonBlockingSocketPair(first);
+  MakeNonBlockingSocketPair(second);
+  EventHandle* handle = poller_->CreateHandle(first[0], "first", false);
+  char data = 'a';
+  ASSERT_EQ(write(first[1], &data, 1), 1);
+  // Let the poll request for the first handle complete.
+  bool writable = false;
+  handle->NotifyOnWrite(PosixEngineClosure::TestOnlyToClosure(
+      [&writable](absl::Status /*status*/) { writable = true; }));
+  WorkUntil(&writable);
+  int released_fd = -1;
+  handle->OrphanHandle(nullptr, &released_fd, "first");
+  EXPECT_EQ(released_fd, first[0]);
+  // More activity on the orphaned fd.
+  ASSERT_EQ(write(first[1], &data, 1), 1);
+  EventHandle* reused = poller_->CreateHandle(second[0], "second", false);
+  EXPECT_EQ(reused, handle);
+  bool readable = false;
+  reused->NotifyOnRead(PosixEngineClosure::TestOnlyToClosure(
+      [&readable](absl::Status status) {
+        EXPECT_TRUE(status.ok());
+        readable = true;
+      }));
+  // Only stale completions and the initial writability of the second socket
+  // are pending.
+  for (int i = 0; i < 10 && !readable; ++i) {
+    if (poller_->Work(20ms, []() {}) ==
+        Poller::WorkResult::kDeadlineExceeded) {
+      break;
+    }
+  }
+  EXPECT_FALSE(readable);
+  ASSERT_EQ(write(second[1], &data, 1), 1);
+  WorkUntil(&readable);
+  reused->OrphanHandle(nullptr, nullptr, "second");
+  close(first[0]);
+  close(first[1]);
+  close(second[1]);
+}
+
+TEST_F(IoUringPollerTest, Kick) {
+  std::thread kicker([this]() {
+    std::this_thread::sleep_for(10ms);
+    poller_->Kick();
+  });
+  EXPECT_EQ(poller_->Work(24h, []() {}), Poller::WorkResult::kKicked);
+  kicker.join();
+}
+
+TEST_F(IoUringPollerTest, TimesOut) {
+  EXPECT_EQ(poller_->Work(10ms, []() {}),
+            Poller::WorkResult::kDeadlineExceeded);
+}
+
+}  // namespace
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_IO_URING
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -44,6 +44,7 @@
 #include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
 #include "src/core/lib/event_engine/posix_engine/tcp_socket_utils.h"
 #include "src/core/lib/event_engine/tcp_socket_utils.h"
+#include "src/core/lib/experiments/config.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/notification.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -192,6 +193,7 @@ class Worker : public grpc_core::DualRefCounted<Worker> {
 };
 
 class PosixEndpointTest : public ::testing::TestWithParam<bool> {
+ protected:
   void SetUp() override {
     oracle_ee_ = std::make_shared<PosixOracleEventEngine>();
     scheduler_ =
@@ -265,6 +267,83 @@ TEST_P(PosixEndpointTest, ConnectExchangeBidiDataTransferTest) {
   worker->Wait();
 }
 
+// Read hints are only honoured with frame size tuning, which these tests
+// enable for themselves alone.
+class PosixEndpointReadHintTest : public PosixEndpointTest {
+ protected:
+  void SetUp() override {
+    grpc_core::ConfigVars::Overrides overrides;
+    overrides.experiments = absl::StrCat(
+        grpc_core::ConfigVars::Get().Experiments(), ",tcp_frame_size_tuning");
+    grpc_core::ConfigVars::SetOverrides(overrides);
+    grpc_core::TestOnlyReloadExperimentsFromConfigVariables();
+    PosixEndpointTest::SetUp();
+  }
+
+  void TearDown() override {
+    PosixEndpointTest::TearDown();
+    grpc_core::ConfigVars::SetOverrides(grpc_core::ConfigVars::Overrides());
+    grpc_core::TestOnlyReloadExperimentsFromConfigVariables();
+  }
+};
+
+// Reads with a size hint should complete once the hinted number of bytes
+// has arrived, in a single buffer sized to the hint, so that upper layers do
+// not need to reassemble the payload. However the kernel splits the data up,
+// the slices read must all be views of that one buffer.
+TEST_P(PosixEndpointReadHintTest, HintedReadIsContiguousTest) {
+  if (PosixPoller() == nullptr) {
+    return;
+  }
+  constexpr int kHintedReadSize = 96 * 1024;
+  Worker* worker = new Worker(GetPosixEE(), PosixPoller());
+  worker->Start();
+  {
+    auto connections = CreateConnectedEndpoints(*PosixPoller(), GetParam(), 1,
+                                                GetPosixEE(), GetOracleEE());
+    auto it = connections.begin();
+    auto client_endpoint = std::move((*it).client_endpoint);
+    auto server_endpoint = std::move((*it).server_endpoint);
+    connections.erase(it);
+
+    std::string data(kHintedReadSize, '\0');
+    for (int i = 0; i < kHintedReadSize; i++) {
+      data[i] = static_cast<char>(i % 251);
+    }
+    SliceBuffer write_buf;
+    AppendStringToSliceBuffer(&write_buf, data);
+    grpc_core::Notification write_signal;
+    if (server_endpoint->Write(
+            [&write_signal](absl::Status status) {
+              ASSERT_TRUE(status.ok());
+              write_signal.Notify();
+            },
+            &write_buf, nullptr)) {
+      write_signal.Notify();
+    }
+
+    EventEngine::Endpoint::ReadArgs args = {kHintedReadSize};
+    SliceBuffer read_buf;
+    grpc_core::Notification read_signal;
+    if (client_endpoint->Read(
+            [&read_signal](absl::Status status) {
+              ASSERT_TRUE(status.ok());
+              read_signal.Notify();
+            },
+            &read_buf, &args)) {
+      read_signal.Notify();
+    }
+    read_signal.WaitForNotification();
+    write_signal.WaitForNotification();
+    ASSERT_EQ(read_buf.Length(), data.size());
+    for (size_t i = 1; i < read_buf.Count(); i++) {
+      EXPECT_EQ(read_buf[i - 1].end(), read_buf[i].begin());
+    }
+    EXPECT_EQ(data, ExtractSliceBufferIntoString(&read_buf));
+  }
+  worker->Wait();
+}
+
 // Create  N connections and exchange and verify random number of messages over
 // each connection in parallel.
 TEST_P(PosixEndpointTest, MultipleIPv6ConnectionsToOneOracleListenerTest) {
@@ -327,6 +406,8 @@ TEST_P(PosixEndpointTest, MultipleIPv6ConnectionsToOneOracleListenerTest) {
 // Test with zero copy enabled and disabled.
 INSTANTIATE_TEST_SUITE_P(PosixEndpoint, PosixEndpointTest,
                          ::testing::ValuesIn({false, true}), &TestScenarioName);
+INSTANTIATE_TEST_SUITE_P(PosixEndpoint, PosixEndpointReadHintTest,
+                         ::testing::ValuesIn({false, true}), &TestScenarioName);
 
 }  // namespace experimental
 }  // namespace grpc_event_engine
@@ -18,6 +18,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -25,16 +26,19 @@
 #include "gtest/gtest.h"
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/impl/channel_arg_names.h>
 
 #include "src/core/lib/iomgr/port.h"
 
 // This test won't work except with posix sockets enabled
 #ifdef GRPC_POSIX_SOCKET_UTILS_COMMON
 
+#include <errno.h>
 #include <ifaddrs.h>
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/event_engine/channel_args_endpoint_config.h"
 #include "src/core/lib/event_engine/posix_engine/posix_engine_listener_utils.h"
 #include "src/core/lib/event_engine/posix_engine/tcp_socket_utils.h"
@@ -144,6 +148,57 @@ TEST(PosixEngineListenerUtils, ListenerContainerAddAllLocalAddressesTest) {
 }
 #endif  // GRPC_HAVE_IFADDRS
 
+TEST(PosixEngineListenerUtils, ListenerContainerAddReusePortSiblingsTest) {
+  constexpr int kNumListeners = 4;
+  constexpr int kNumConnections = 32;
+  ChannelArgsEndpointConfig config(
+      grpc_core::ChannelArgs()
+          .Set(GRPC_ARG_REUSEPORT_LISTENERS, kNumListeners)
+          .Set(GRPC_ARG_REUSEPORT_CPU_STEERING, 1));
+  PosixTcpOptions options = TcpOptionsFromEndpointConfig(config);
+  if (!options.allow_reuse_port) {
+    gpr_log(GPR_INFO,
+            "Skipping ListenerContainerAddReusePortSiblingsTest because "
+            "SO_REUSEPORT is not supported.");
+    return;
+  }
+  TestListenerSocketsContainer listener_sockets;
+  auto addr = URIToResolvedAddress("ipv4:127.0.0.1:0");
+  ASSERT_TRUE(addr.ok());
+  auto socket = CreateAndPrepareListenerSocket(options, *addr);
+  ASSERT_TRUE(socket.ok()) << socket.status();
+  listener_sockets.Append(*socket);
+  ASSERT_TRUE(
+      ListenerContainerAddReusePortSiblings(listener_sockets, options, *socket)
+          .ok());
+  ASSERT_EQ(listener_sockets.Size(), kNumListeners);
+  for (const auto& sibling : listener_sockets) {
+    EXPECT_EQ(sibling.port, socket->port);
+  }
+  // Every connection must be queued on one of the sockets in the group.
+  EventEngine::ResolvedAddress connect_addr = *addr;
+  ResolvedAddressSetPort(connect_addr, socket->port);
+  std::vector<int> client_fds;
+  for (int i = 0; i < kNumConnections; ++i) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(connect(fd, connect_addr.address(), connect_addr.size()), 0);
+    client_fds.push_back(fd);
+  }
+  int accepted = 0;
+  for (const auto& sibling : listener_sockets) {
+    int fd;
+    while ((fd = accept(sibling.sock.Fd(), nullptr, nullptr)) >= 0) {
+      ++accepted;
+      close(fd);
+    }
+    EXPECT_EQ(errno, EAGAIN);
+    close(sibling.sock.Fd());
+  }
+  EXPECT_EQ(accepted, kNumConnections);
+  for (int fd : client_fds) close(fd);
+}
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
 
@@ -0,0 +1,122 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+namespace {
+
+// Timers scheduled and then cancelled by each thread per iteration.
+constexpr size_t kBatchSize = 1000;
+
+class FixedTimeHost : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(1);
+  }
+  void Kick() override {}
+};
+
+class NoopClosure : public EventEngine::Closure {
+ public:
+  void Run() override {}
+};
+
+FixedTimeHost g_host;
+NoopClosure g_closure;
+
+// Deadlines spread over the next ten seconds, like typical RPC deadlines and
+// keepalive timers.
+grpc_core::Timestamp DeadlineFor(size_t i) {
+  return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+      2 + (i * 7919) % 10000);
+}
+
+// Schedules and cancels batches of timers from state.threads() threads, on
+// top of state.range(0) timers that stay pending throughout. The nearly all
+// cancelled pattern is what RPC deadlines look like to the timer list.
+template <typename TimerListT>
+void BM_ScheduleAndCancel(benchmark::State& state) {
+  static TimerListT* list;
+  static std::vector<Timer>* background;
+  if (state.thread_index() == 0) {
+    list = new TimerListT(&g_host);
+    background = new std::vector<Timer>(state.range(0));
+    for (size_t i = 0; i < background->size(); i++) {
+      list->TimerInit(&(*background)[i], DeadlineFor(i), &g_closure);
+    }
+  }
+  std::vector<Timer> timers(kBatchSize);
+  size_t n = state.thread_index();
+  for (auto _ : state) {
+    for (Timer& timer : timers) {
+      list->TimerInit(&timer, DeadlineFor(n++), &g_closure);
+    }
+    for (Timer& timer : timers) {
+      GPR_ASSERT(list->TimerCancel(&timer));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+  if (state.thread_index() == 0) {
+    for (Timer& timer : *background) {
+      GPR_ASSERT(list->TimerCancel(&timer));
+    }
+    delete background;
+    delete list;
+  }
+}
+// Up to ten million pending timers, the scale of a busy server holding a
+// deadline and a keepalive per call. The largest case needs about 1GB for the
+// background timers alone.
+void PendingTimerArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t pending : {0, 100000, 1000000, 10000000}) b->Arg(pending);
+  b->ThreadRange(1, 16)->UseRealTime();
+}
+BENCHMARK_TEMPLATE(BM_ScheduleAndCancel, TimerList)->Apply(PendingTimerArgs);
+BENCHMARK_TEMPLATE(BM_ScheduleAndCancel, TimerWheel)->Apply(PendingTimerArgs);
+
+}  // namespace
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  benchmark::Initialize(&argc, argv);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,285 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/event_engine/posix_engine/timer_wheel.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+class FakeHost : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override { return now_; }
+  void Kick() override { ++kicks_; }
+
+  void Set(int64_t millis) {
+    now_ = grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+  }
+  int kicks() const { return kicks_; }
+
+ private:
+  grpc_core::Timestamp now_ =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(0);
+  int kicks_ = 0;
+};
+
+// A host that can be used from several threads at once.
+class ConcurrentHost : public TimerListHost {
+ public:
+  grpc_core::Timestamp Now() override {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+        now_.load(std::memory_order_relaxed));
+  }
+  void Kick() override { kicks_.fetch_add(1, std::memory_order_relaxed); }
+
+  void Set(int64_t millis) { now_.store(millis, std::memory_order_relaxed); }
+  int kicks() const { return kicks_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> now_{0};
+  std::atomic<int> kicks_{0};
+};
+
+class RecordingClosure : public experimental::EventEngine::Closure {
+ public:
+  void Run() override { ++runs; }
+  int runs = 0;
+};
+
+grpc_core::Timestamp Millis(int64_t millis) {
+  return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+}
+
+size_t RunAll(
+    absl::optional<std::vector<experimental::EventEngine::Closure*>> result) {
+  EXPECT_TRUE(result.has_value());
+  for (auto* closure : *result) closure->Run();
+  return result->size();
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, FiresAtDeadline) {
+  FakeHost host;
+  host.Set(100);
+  TimerWheel wheel(&host);
+  Timer timers[20];
+  RecordingClosure closures[20];
+  for (int i = 0; i < 10; i++) {
+    wheel.TimerInit(&timers[i], Millis(110), &closures[i]);
+  }
+  for (int i = 10; i < 20; i++) {
+    wheel.TimerInit(&timers[i], Millis(1110), &closures[i]);
+  }
+  host.Set(109);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 0u);
+  host.Set(110);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 10u);
+  host.Set(1109);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 0u);
+  host.Set(1500);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 10u);
+  for (auto& closure : closures) EXPECT_EQ(closure.runs, 1);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 0u);
+}
+
+TEST(TimerWheelTest, PastDeadlineFiresOnNextCheck) {
+  FakeHost host;
+  host.Set(1000);
+  TimerWheel wheel(&host);
+  Timer timer;
+  RecordingClosure closure;
+  wheel.TimerInit(&timer, Millis(10), &closure);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 1u);
+  EXPECT_FALSE(wheel.TimerCancel(&timer));
+}
+
+TEST(TimerWheelTest, Cancel) {
+  FakeHost host;
+  TimerWheel wheel(&host);
+  Timer timers[4];
+  RecordingClosure closures[4];
+  wheel.TimerInit(&timers[0], Millis(3), &closures[0]);
+  wheel.TimerInit(&timers[1], Millis(100), &closures[1]);
+  wheel.TimerInit(&timers[2], Millis(100000), &closures[2]);
+  wheel.TimerInit(&timers[3], Millis(1), &closures[3]);
+  EXPECT_TRUE(wheel.TimerCancel(&timers[0]));
+  EXPECT_TRUE(wheel.TimerCancel(&timers[2]));
+  host.Set(200000);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 2u);
+  EXPECT_EQ(closures[0].runs, 0);
+  EXPECT_EQ(closures[1].runs, 1);
+  EXPECT_EQ(closures[2].runs, 0);
+  EXPECT_EQ(closures[3].runs, 1);
+  EXPECT_FALSE(wheel.TimerCancel(&timers[1]));
+  EXPECT_FALSE(wheel.TimerCancel(&timers[0]));
+}
+
+// Deadlines beyond the reach of the wheels, as with long running services.
+TEST(TimerWheelTest, FarFutureDeadlines) {
+  const int64_t k25Days = grpc_core::Duration::Hours(25 * 24).millis();
+  FakeHost host;
+  host.Set(k25Days);
+  TimerWheel wheel(&host);
+  Timer timers[3];
+  RecordingClosure closures[3];
+  wheel.TimerInit(&timers[0], Millis(2 * k25Days), &closures[0]);
+  wheel.TimerInit(&timers[1], Millis(k25Days + 3), &closures[1]);
+  wheel.TimerInit(&timers[2],
+                  Millis(std::numeric_limits<int64_t>::max() - 1),
+                  &closures[2]);
+  host.Set(k25Days + 4);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 1u);
+  EXPECT_EQ(closures[1].runs, 1);
+  host.Set(2 * k25Days - 1);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 0u);
+  host.Set(2 * k25Days);
+  EXPECT_EQ(RunAll(wheel.TimerCheck(nullptr)), 1u);
+  EXPECT_EQ(closures[0].runs, 1);
+  EXPECT_TRUE(wheel.TimerCancel(&timers[2]));
+}
+
+TEST(TimerWheelTest, ReportsNextDeadlineAndKicks) {
+  FakeHost host;
+  TimerWheel wheel(&host);
+  Timer timers[2];
+  RecordingClosure closures[2];
+  wheel.TimerInit(&timers[0], Millis(5000), &closures[0]);
+  grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+  EXPECT_EQ(RunAll(wheel.TimerCheck(&next)), 0u);
+  EXPECT_LE(next, Millis(5000));
+  // An earlier timer must wake the timer manager up...
+  const int kicks = host.kicks();
+  wheel.TimerInit(&timers[1], Millis(20), &closures[1]);
+  EXPECT_EQ(host.kicks(), kicks + 1);
+  next = grpc_core::Timestamp::InfFuture();
+  EXPECT_EQ(RunAll(wheel.TimerCheck(&next)), 0u);
+  EXPECT_LE(next, Millis(20));
+  // ... and the reported deadline never moves past a pending timer.
+  while (closures[0].runs == 0) {
+    host.Set(next.milliseconds_after_process_epoch());
+    next = grpc_core::Timestamp::InfFuture();
+    RunAll(wheel.TimerCheck(&next));
+    EXPECT_LE(host.Now(), Millis(5000));
+  }
+  EXPECT_EQ(closures[1].runs, 1);
+}
+
+// A timer added while TimerCheck is scanning the shards must either be
+// included in the deadline TimerCheck reports, or kick the timer manager so
+// that it checks again. Otherwise the manager sleeps past the deadline.
+TEST(TimerWheelTest, TimerInitRacingTimerCheckIsNotLost) {
+  constexpr int kRounds = 2000;
+  ConcurrentHost host;
+  TimerWheel wheel(&host);
+  std::vector<Timer> due(kRounds);
+  std::vector<Timer> racing(kRounds);
+  std::vector<RecordingClosure> due_closures(kRounds);
+  std::vector<RecordingClosure> racing_closures(kRounds);
+  for (int round = 0; round < kRounds; round++) {
+    const int64_t now = 10 * (round + 1);
+    host.Set(now);
+    // Makes the next TimerCheck scan every shard.
+    wheel.TimerInit(&due[round], Millis(now), &due_closures[round]);
+    const int kicks = host.kicks();
+    std::thread adder([&]() {
+      wheel.TimerInit(&racing[round], Millis(now + 1),
+                      &racing_closures[round]);
+    });
+    grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+    RunAll(wheel.TimerCheck(&next));
+    adder.join();
+    ASSERT_TRUE(host.kicks() > kicks || next <= Millis(now + 1)) << round;
+    host.Set(now + 1);
+    RunAll(wheel.TimerCheck(nullptr));
+    ASSERT_EQ(due_closures[round].runs, 1);
+    ASSERT_EQ(racing_closures[round].runs, 1);
+  }
+}
+
+// Compares the wheel against the deadlines of many random timers, spread over
+// every level of the wheels, while time advances in uneven steps.
+TEST(TimerWheelTest, RandomizedDeadlines) {
+  constexpr int kNumTimers = 20000;
+  std::mt19937_64 rng(42);
+  FakeHost host;
+  int64_t now = 12345;
+  host.Set(now);
+  TimerWheel wheel(&host);
+  std::vector<Timer> timers(kNumTimers);
+  std::vector<RecordingClosure> closures(kNumTimers);
+  std::vector<int64_t> deadlines(kNumTimers);
+  std::vector<bool> cancelled(kNumTimers);
+  int64_t max_deadline = now;
+  int added = 0;
+  auto advance = [&]() {
+    now += rng() % (uint64_t{1} << (rng() % 22));
+    host.Set(now);
+    RunAll(wheel.TimerCheck(nullptr));
+    for (int i = 0; i < added; i++) {
+      if (cancelled[i] && closures[i].runs == 0) continue;
+      ASSERT_LE(closures[i].runs, 1);
+      // A timer runs on the first check at or after its deadline.
+      ASSERT_EQ(closures[i].runs == 1, deadlines[i] <= now) << i;
+    }
+  };
+  while (added < kNumTimers) {
+    for (int i = 0; i < 100; i++, added++) {
+      deadlines[added] = now + rng() % (uint64_t{1} << (rng() % 30));
+      max_deadline = std::max(max_deadline, deadlines[added]);
+      wheel.TimerInit(&timers[added], Millis(deadlines[added]),
+                      &closures[added]);
+      if (rng() % 8 == 0) {
+        const int victim = rng() % (added + 1);
+        const bool pending = closures[victim].runs == 0 && !cancelled[victim];
+        EXPECT_EQ(wheel.TimerCancel(&timers[victim]), pending);
+        cancelled[victim] = true;
+      }
+    }
+    advance();
+  }
+  while (now < max_deadline) advance();
+  for (int i = 0; i < kNumTimers; i++) {
+    if (!cancelled[i]) {
+      EXPECT_EQ(closures[i].runs, 1);
+    }
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
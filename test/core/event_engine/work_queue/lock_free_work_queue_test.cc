@@ -0,0 +1,176 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/work_queue/lock_free_work_queue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/common_closures.h"
+#include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+using ::grpc_event_engine::experimental::AnyInvocableClosure;
+using ::grpc_event_engine::experimental::BasicWorkQueue;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::LockFreeWorkQueue;
+
+TEST(LockFreeWorkQueueTest, StartsEmpty) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow);
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(queue.PopMostRecent(), nullptr);
+  ASSERT_EQ(queue.PopOldest(), nullptr);
+}
+
+TEST(LockFreeWorkQueueTest, TakesClosures) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow);
+  bool ran = false;
+  AnyInvocableClosure closure([&ran] { ran = true; });
+  queue.Add(&closure);
+  ASSERT_FALSE(queue.Empty());
+  EventEngine::Closure* popped = queue.PopMostRecent();
+  ASSERT_NE(popped, nullptr);
+  popped->Run();
+  ASSERT_TRUE(ran);
+  ASSERT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeWorkQueueTest, TakesAnyInvocables) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow);
+  bool ran = false;
+  queue.Add([&ran] { ran = true; });
+  ASSERT_FALSE(queue.Empty());
+  EventEngine::Closure* popped = queue.PopMostRecent();
+  ASSERT_NE(popped, nullptr);
+  popped->Run();
+  ASSERT_TRUE(ran);
+  ASSERT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeWorkQueueTest, PopMostRecentIsLIFO) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow);
+  int flag = 0;
+  queue.Add([&flag] { flag |= 1; });
+  queue.Add([&flag] { flag |= 2; });
+  queue.PopMostRecent()->Run();
+  EXPECT_FALSE(flag & 1);
+  EXPECT_TRUE(flag & 2);
+  queue.PopMostRecent()->Run();
+  EXPECT_TRUE(flag & 1);
+  EXPECT_TRUE(flag & 2);
+  ASSERT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeWorkQueueTest, PopOldestIsFIFO) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow);
+  int flag = 0;
+  queue.Add([&flag] { flag |= 1; });
+  queue.Add([&flag] { flag |= 2; });
+  queue.PopOldest()->Run();
+  EXPECT_TRUE(flag & 1);
+  EXPECT_FALSE(flag & 2);
+  queue.PopOldest()->Run();
+  EXPECT_TRUE(flag & 1);
+  EXPECT_TRUE(flag & 2);
+  ASSERT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeWorkQueueTest, OverflowsWhenFull) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow, /*capacity=*/3);
+  AnyInvocableClosure closure([] {});
+  // The capacity is rounded up to 4.
+  for (int i = 0; i < 6; i++) queue.Add(&closure);
+  EXPECT_EQ(queue.Size(), 4);
+  EXPECT_EQ(overflow.Size(), 2);
+  // Slots are reused once elements are popped from either end.
+  ASSERT_NE(queue.PopOldest(), nullptr);
+  ASSERT_NE(queue.PopMostRecent(), nullptr);
+  queue.Add(&closure);
+  queue.Add(&closure);
+  EXPECT_EQ(queue.Size(), 4);
+  EXPECT_EQ(overflow.Size(), 2);
+  while (queue.PopMostRecent() != nullptr) {
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(LockFreeWorkQueueTest, ThreadedStealing) {
+  BasicWorkQueue overflow;
+  LockFreeWorkQueue queue(&overflow, /*capacity=*/256);
+  constexpr int thief_count = 8;
+  constexpr int element_count = 33333;
+  std::atomic<int> run_count{0};
+  std::atomic<bool> done{false};
+  class TestClosure : public EventEngine::Closure {
+   public:
+    explicit TestClosure(std::atomic<int>* run_count)
+        : run_count_(run_count) {}
+    void Run() override {
+      run_count_->fetch_add(1, std::memory_order_relaxed);
+      delete this;
+    }
+
+   private:
+    std::atomic<int>* run_count_;
+  };
+  std::vector<std::thread> thieves;
+  thieves.reserve(thief_count);
+  for (int i = 0; i < thief_count; i++) {
+    thieves.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire)) {
+        if (auto* c = queue.PopOldest()) c->Run();
+      }
+    });
+  }
+  // The owner interleaves pushes and pops while thieves steal from the other
+  // end of the queue.
+  for (int i = 0; i < element_count; i++) {
+    queue.Add(new TestClosure(&run_count));
+    if (i % 3 == 0) {
+      if (auto* c = queue.PopMostRecent()) c->Run();
+    }
+  }
+  while (!queue.Empty()) {
+    if (auto* c = queue.PopMostRecent()) c->Run();
+  }
+  while (auto* c = overflow.PopOldest()) c->Run();
+  done.store(true, std::memory_order_release);
+  for (auto& thd : thieves) thd.join();
+  // Every closure must have run exactly once.
+  EXPECT_EQ(run_count.load(), element_count);
+  EXPECT_TRUE(queue.Empty());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  auto result = RUN_ALL_TESTS();
+  return result;
+}
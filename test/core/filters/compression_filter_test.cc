@@ -0,0 +1,170 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/http/message_compress/compression_filter.h"
+
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <grpc/compression.h>
+#include <grpc/grpc.h>
+#include <grpc/impl/channel_arg_names.h>
+
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/filters/filter_test.h"
+
+using ::testing::_;
+using ::testing::AllOf;
+
+namespace grpc_core {
+namespace {
+
+using ServerCompressionFilterTest = FilterTest<ServerCompressionFilter>;
+
+// A small message that plain deflate cannot shrink, and a dictionary of the
+// strings such messages share.
+constexpr absl::string_view kPayload =
+    "user_id=1234&session_token=abcdef&locale=en-US&timezone=UTC";
+constexpr absl::string_view kDictionary =
+    "user_id=&session_token=&locale=en-US&timezone=UTC";
+
+// gmock matcher to ensure that a message was deflated with kDictionary and
+// inflates back to kPayload.
+MATCHER(IsDeflatedWithDictionary, "") {
+  SliceBuffer input;
+  input.Append(Slice::FromCopiedString(arg.payload()->JoinIntoString()));
+  SliceBuffer output;
+  MessageDecompressionOptions options;
+  options.deflate_dictionary = kDictionary;
+  return grpc_msg_decompress(GRPC_COMPRESS_DEFLATE, input.c_slice_buffer(),
+                             output.c_slice_buffer(), options) == 1 &&
+         output.JoinIntoString() == kPayload;
+}
+
+ChannelArgs DictionaryChannelArgs(absl::string_view dictionary) {
+  return ChannelArgs()
+      .Set(GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM, GRPC_COMPRESS_DEFLATE)
+      .Set(GRPC_ARG_COMPRESSION_DEFLATE_DICTIONARY,
+           absl::Base64Escape(dictionary));
+}
+
+std::string AcceptEncodingWithDictionary(absl::string_view dictionary) {
+  return absl::StrCat("identity,deflate,deflate-dict-",
+                      absl::Hex(DeflateDictionaryId(dictionary),
+                                absl::kZeroPad8));
+}
+
+TEST_F(ServerCompressionFilterTest, MatchingDictionaryIsUsed) {
+  Call call(MakeChannel(DictionaryChannelArgs(kDictionary)).value());
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata(
+      {{"grpc-accept-encoding", AcceptEncodingWithDictionary(kDictionary)}}));
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  call.ForwardMessageServerToClient(call.NewMessage(kPayload));
+  EXPECT_EVENT(ForwardedServerInitialMetadata(
+      &call, HasMetadataKeyValue("grpc-encoding", "deflate")));
+  EXPECT_EVENT(ForwardedMessageServerToClient(
+      &call, AllOf(HasMessageFlags(GRPC_WRITE_INTERNAL_COMPRESS),
+                   IsDeflatedWithDictionary())));
+  Step();
+}
+
+TEST_F(ServerCompressionFilterTest, MismatchedDictionaryIsNotUsed) {
+  Call call(MakeChannel(DictionaryChannelArgs(kDictionary)).value());
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata(
+      {{"grpc-accept-encoding",
+        AcceptEncodingWithDictionary("some other dictionary")}}));
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  call.ForwardMessageServerToClient(call.NewMessage(kPayload));
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  EXPECT_EVENT(ForwardedMessageServerToClient(
+      &call, AllOf(HasMessageFlags(0u), HasMessagePayload(kPayload))));
+  Step();
+}
+
+TEST_F(ServerCompressionFilterTest, DictionaryIsNotUsedWithoutPeerId) {
+  Call call(MakeChannel(DictionaryChannelArgs(kDictionary)).value());
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(
+      call.NewClientMetadata({{"grpc-accept-encoding", "identity,deflate"}}));
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  call.ForwardMessageServerToClient(call.NewMessage(kPayload));
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  EXPECT_EVENT(ForwardedMessageServerToClient(
+      &call, AllOf(HasMessageFlags(0u), HasMessagePayload(kPayload))));
+  Step();
+}
+
+// With deflate disabled there is no local dictionary id to match, so a
+// peer that advertises none must not get dictionary-deflated messages when
+// the application asks for deflate anyway.
+TEST_F(ServerCompressionFilterTest, DictionaryIsNotUsedWithoutLocalId) {
+  Call call(
+      MakeChannel(
+          DictionaryChannelArgs(kDictionary)
+              .Set(GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM,
+                   GRPC_COMPRESS_NONE)
+              .Set(GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET,
+                   1 << GRPC_COMPRESS_NONE))
+          .value());
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata({{"grpc-accept-encoding", "identity"}}));
+  call.ForwardServerInitialMetadata(
+      call.NewServerMetadata({{"grpc-internal-encoding-request", "deflate"}}));
+  call.ForwardMessageServerToClient(call.NewMessage(kPayload));
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  EXPECT_EVENT(ForwardedMessageServerToClient(
+      &call, AllOf(HasMessageFlags(0u), HasMessagePayload(kPayload))));
+  Step();
+}
+
+TEST_F(ServerCompressionFilterTest, InvalidBase64DictionaryIsIgnored) {
+  Call call(
+      MakeChannel(ChannelArgs()
+                      .Set(GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM,
+                           GRPC_COMPRESS_DEFLATE)
+                      .Set(GRPC_ARG_COMPRESSION_DEFLATE_DICTIONARY, "not*b64"))
+          .value());
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata(
+      {{"grpc-accept-encoding", AcceptEncodingWithDictionary("")}}));
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  call.ForwardMessageServerToClient(call.NewMessage(kPayload));
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  EXPECT_EVENT(ForwardedMessageServerToClient(
+      &call, AllOf(HasMessageFlags(0u), HasMessagePayload(kPayload))));
+  Step();
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -157,6 +157,23 @@ TEST(Json, NestedEmptyContainers) {
                  "[[],{},[]]");
 }
 
+// Each open container's slot points into its parent's, so this walks the
+// builder's whole scope stack down to the reader's depth limit and back.
+TEST(Json, MaxDepthContainersWithSiblings) {
+  std::string input;
+  for (int i = 0; i < 255; ++i) {
+    absl::StrAppend(&input, i % 2 == 0 ? "[0," : "{\"a\":0,\"b\":");
+  }
+  input += "1";
+  for (int i = 254; i >= 0; --i) {
+    absl::StrAppend(&input, i % 2 == 0 ? ",2]" : ",\"c\":2}");
+  }
+  auto json = JsonParse(input);
+  ASSERT_TRUE(json.ok()) << json.status();
+  EXPECT_EQ(JsonDump(*json), input);
+  EXPECT_FALSE(JsonParse(absl::StrCat("[", input, "]")).ok());
+}
+
 TEST(Json, EscapesAndControlCharactersInKeyStrings) {
   RunSuccessTest(" { \"\\u007f\x7f\\n\\r\\\"\\f\\b\\\\a , b\": 1, \"\": 0 } ",
                  Json::FromObject({
@@ -328,6 +345,56 @@ TEST(Json, Equality) {
   EXPECT_NE(Json::FromNumber(1), Json());
 }
 
+// Records what the reader passes to the handler.
+class RecordingHandler : public JsonReaderHandler {
+ public:
+  std::string events() const { return events_; }
+
+  void StartObject() override { events_ += "{"; }
+  void EndObject() override { events_ += "}"; }
+  void StartArray() override { events_ += "["; }
+  void EndArray() override { events_ += "]"; }
+  bool Key(absl::string_view key) override {
+    absl::StrAppend(&events_, "key:", key, " ");
+    // Treat "dup" as already present.
+    return key != "dup";
+  }
+  void String(absl::string_view value) override {
+    absl::StrAppend(&events_, "string:", value, " ");
+  }
+  void Number(absl::string_view value) override {
+    absl::StrAppend(&events_, "number:", value, " ");
+  }
+  void Bool(bool value) override {
+    absl::StrAppend(&events_, "bool:", value, " ");
+  }
+  void Null() override { events_ += "null "; }
+
+ private:
+  std::string events_;
+};
+
+TEST(Json, Handler) {
+  RecordingHandler handler;
+  ASSERT_TRUE(
+      JsonParse("{\"a\": [1, \"x\\ny\", true, null, {}], \"b\": -2.5e3}",
+                &handler)
+          .ok());
+  EXPECT_EQ(
+      handler.events(),
+      "{key:a [number:1 string:x\ny bool:1 null {}]key:b number:-2.5e3 }");
+}
+
+TEST(Json, HandlerRejectsKey) {
+  RecordingHandler handler;
+  absl::Status status = JsonParse("{\"dup\": 1}", &handler);
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_TRUE(absl::StrContains(status.message(), "duplicate key \"dup\""))
+      << status;
+  // The reader keeps going after a rejected key.
+  EXPECT_EQ(handler.events(), "{key:dup number:1 }");
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -147,6 +147,75 @@ TEST(MpscTest, ClosureIsVisibleToSenders) {
   EXPECT_EQ(NowOrNever(sender.Send(MakePayload(1))), false);
 }
 
+TEST(MpscTest, ClosingReceiverWakesBlockedSender) {
+  StrictMock<MockActivity> activity;
+  auto receiver = std::make_unique<MpscReceiver<Payload>>(1);
+  MpscSender<Payload> sender = receiver->MakeSender();
+
+  activity.Activate();
+  EXPECT_EQ(NowOrNever(sender.Send(MakePayload(1))), true);
+  auto send2 = sender.Send(MakePayload(2));
+  EXPECT_EQ(send2(), Poll<bool>(Pending{}));
+  activity.Deactivate();
+
+  EXPECT_CALL(activity, WakeupRequested());
+  receiver.reset();
+  Mock::VerifyAndClearExpectations(&activity);
+
+  activity.Activate();
+  EXPECT_EQ(send2(), Poll<bool>(false));
+  activity.Deactivate();
+}
+
+TEST(MpscTest, MarkClosedDropsQueuedItems) {
+  MpscReceiver<std::shared_ptr<int>> receiver(10);
+  MpscSender<std::shared_ptr<int>> sender = receiver.MakeSender();
+  auto item = std::make_shared<int>(1);
+  EXPECT_EQ(NowOrNever(sender.Send(item)), true);
+  EXPECT_EQ(item.use_count(), 2);
+  receiver.MarkClosed();
+  EXPECT_EQ(item.use_count(), 1);
+  EXPECT_EQ(NowOrNever(sender.Send(item)), false);
+}
+
+TEST(MpscTest, ImmediateSendIgnoresBufferHint) {
+  MpscReceiver<Payload> receiver(1);
+  MpscSender<Payload> sender = receiver.MakeSender();
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(sender.UnbufferedImmediateSend(MakePayload(i)));
+  }
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(NowOrNever(receiver.Next()), MakePayload(i));
+  }
+}
+
+TEST(MpscTest, ImmediateSendWakesReceiver) {
+  StrictMock<MockActivity> activity;
+  MpscReceiver<Payload> receiver(1);
+  MpscSender<Payload> sender = receiver.MakeSender();
+
+  activity.Activate();
+  auto receive = receiver.Next();
+  EXPECT_EQ(receive(), Poll<Payload>(Pending{}));
+  activity.Deactivate();
+
+  EXPECT_CALL(activity, WakeupRequested());
+  EXPECT_TRUE(sender.UnbufferedImmediateSend(MakePayload(1)));
+  Mock::VerifyAndClearExpectations(&activity);
+
+  activity.Activate();
+  EXPECT_EQ(receive(), Poll<Payload>(MakePayload(1)));
+  activity.Deactivate();
+}
+
+TEST(MpscTest, ImmediateSendSeesClosure) {
+  auto receiver = std::make_unique<MpscReceiver<Payload>>(1);
+  MpscSender<Payload> sender = receiver->MakeSender();
+  receiver.reset();
+  EXPECT_FALSE(sender.UnbufferedImmediateSend(MakePayload(1)));
+}
+
 }  // namespace
 }  // namespace grpc_core
 
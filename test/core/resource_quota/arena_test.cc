@@ -29,14 +29,18 @@
 #include <vector>
 
 #include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "gtest/gtest.h"
 
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 #include "test/core/util/test_config.h"
 
@@ -313,6 +317,84 @@ TEST_F(ArenaTest, ConcurrentMakePooled) {
   args.arena->Destroy();
 }
 
+TEST(ArenaPoolTest, ReusesStorage) {
+  ExecCtx exec_ctx;
+  MemoryAllocator memory_allocator = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  auto pool = MakeOrphanable<ArenaPool>(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("test"));
+  auto first = pool->CreateWithAlloc(1024, 64, &memory_allocator);
+  // Objects with destructors and overflow zones are cleaned up as usual.
+  first.first->ManagedNew<std::unique_ptr<int>>(std::make_unique<int>(1));
+  first.first->Alloc(4096);
+  first.first->Destroy();
+  EXPECT_GT(pool->TestOnlyCachedBytes(), 1024u);
+  // Storage is handed back out to arenas that fit in it...
+  auto second = pool->CreateWithAlloc(512, 64, &memory_allocator);
+  EXPECT_EQ(second.first, first.first);
+  EXPECT_EQ(second.second, first.second);
+  EXPECT_EQ(pool->TestOnlyCachedBytes(), 0u);
+  memset(second.first->Alloc(1024 - 64), 1, 1024 - 64);
+  second.first->Destroy();
+  // ... but not to ones that need more.
+  auto third = pool->CreateWithAlloc(2048, 64, &memory_allocator);
+  EXPECT_EQ(pool->TestOnlyCachedBytes(), 0u);
+  memset(third.first->Alloc(2048 - 64), 1, 2048 - 64);
+  third.first->Destroy();
+  EXPECT_GT(pool->TestOnlyCachedBytes(), 2048u);
+}
+
+TEST(ArenaPoolTest, CacheIsBounded) {
+  ExecCtx exec_ctx;
+  MemoryAllocator memory_allocator = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  auto pool = MakeOrphanable<ArenaPool>(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("test"));
+  std::vector<Arena*> arenas;
+  for (size_t i = 0; i < 10 * ArenaPool::kMaxCachedPerShard; i++) {
+    arenas.push_back(pool->CreateWithAlloc(256, 0, &memory_allocator).first);
+  }
+  for (Arena* arena : arenas) arena->Destroy();
+  // All arenas were destroyed from this thread, and so into one shard.
+  EXPECT_GT(pool->TestOnlyCachedBytes(), 0u);
+  EXPECT_LE(pool->TestOnlyCachedBytes(),
+            ArenaPool::kMaxCachedPerShard * (256 + 1024));
+}
+
+TEST(ArenaPoolTest, ArenasMayOutlivePool) {
+  ExecCtx exec_ctx;
+  MemoryAllocator memory_allocator = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  auto pool = MakeOrphanable<ArenaPool>(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("test"));
+  Arena* arena = pool->CreateWithAlloc(1024, 64, &memory_allocator).first;
+  pool.reset();
+  // The arena's storage is freed rather than cached in the orphaned pool.
+  memset(arena->Alloc(512), 1, 512);
+  arena->Destroy();
+}
+
+TEST(ArenaPoolTest, ReleasesStorageUnderMemoryPressure) {
+  auto memory_quota = std::make_shared<MemoryQuota>("test");
+  MemoryAllocator memory_allocator =
+      MemoryAllocator(memory_quota->CreateMemoryAllocator("test"));
+  auto pool =
+      MakeOrphanable<ArenaPool>(memory_quota->CreateMemoryOwner("pool"));
+  {
+    ExecCtx exec_ctx;
+    pool->CreateWithAlloc(64 * 1024, 0, &memory_allocator).first->Destroy();
+    EXPECT_GT(pool->TestOnlyCachedBytes(), 0u);
+    // Shrinking the quota below what is in use runs the benign reclaimers.
+    memory_quota->SetSize(1);
+  }
+  for (int i = 0; i < 1000 && pool->TestOnlyCachedBytes() != 0; i++) {
+    absl::SleepFor(absl::Milliseconds(10));
+  }
+  EXPECT_EQ(pool->TestOnlyCachedBytes(), 0u);
+  ExecCtx exec_ctx;
+  pool.reset();
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char* argv[]) {
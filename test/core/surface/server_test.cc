@@ -17,6 +17,7 @@
 //
 
 #include <stddef.h>
+#include <string.h>
 
 #include <memory>
 #include <string>
@@ -36,6 +37,7 @@
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "src/core/lib/surface/server.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
@@ -55,6 +57,25 @@ void test_register_method_fail(void) {
   grpc_server_destroy(server);
 }
 
+void test_registered_method_lookup(void) {
+  grpc_server* server = grpc_server_create(nullptr, nullptr);
+  void* any_host = grpc_server_register_method(server, "/a", nullptr,
+                                               GRPC_SRM_PAYLOAD_NONE, 0);
+  ASSERT_NE(any_host, nullptr);
+  // An empty host is the same as no host.
+  ASSERT_EQ(
+      grpc_server_register_method(server, "/a", "", GRPC_SRM_PAYLOAD_NONE, 0),
+      nullptr);
+  void* with_host =
+      grpc_server_register_method(server, "/a", "h", GRPC_SRM_PAYLOAD_NONE, 0);
+  ASSERT_NE(with_host, nullptr);
+  grpc_core::Server* core_server = grpc_core::Server::FromC(server);
+  EXPECT_EQ(core_server->GetRegisteredMethod("h", "/a"), with_host);
+  EXPECT_EQ(core_server->GetRegisteredMethod("other", "/a"), any_host);
+  EXPECT_EQ(core_server->GetRegisteredMethod("h", "/b"), nullptr);
+  grpc_server_destroy(server);
+}
+
 void test_request_call_on_no_server_cq(void) {
   grpc_completion_queue* cc = grpc_completion_queue_create_for_next(nullptr);
   grpc_server* server = grpc_server_create(nullptr, nullptr);
@@ -132,6 +153,106 @@ void test_bind_server_to_addr(const char* host, bool secure) {
   grpc_completion_queue_destroy(cq);
 }
 
+unsigned g_fake_cpu;
+unsigned fake_current_cpu() { return g_fake_cpu; }
+
+// Issues a call to a server with CPU affine CQs while the server believes it
+// runs on the given CPU, and checks that the call is matched against the
+// request pending on cqs[cpu % 2].
+void test_cpu_affine_cqs(unsigned cpu) {
+  g_fake_cpu = cpu;
+  grpc_core::Server::TestOnlySetCurrentCpuFn(fake_current_cpu);
+  const size_t expected = cpu % 2;
+  grpc_arg a = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_SERVER_CPU_AFFINE_CQS), 1);
+  grpc_channel_args args = {1, &a};
+  grpc_server* server = grpc_server_create(&args, nullptr);
+  grpc_completion_queue* cqs[2];
+  for (grpc_completion_queue*& cq : cqs) {
+    cq = grpc_completion_queue_create_for_next(nullptr);
+    grpc_server_register_completion_queue(server, cq, nullptr);
+  }
+  std::string addr =
+      grpc_core::JoinHostPort("127.0.0.1", grpc_pick_unused_port_or_die());
+  grpc_server_credentials* server_creds =
+      grpc_insecure_server_credentials_create();
+  ASSERT_TRUE(grpc_server_add_http2_port(server, addr.c_str(), server_creds));
+  grpc_server_credentials_release(server_creds);
+  grpc_server_start(server);
+  grpc_call* server_calls[2] = {nullptr, nullptr};
+  grpc_call_details details[2];
+  grpc_metadata_array request_metadata[2];
+  for (size_t i = 0; i < 2; i++) {
+    grpc_call_details_init(&details[i]);
+    grpc_metadata_array_init(&request_metadata[i]);
+    ASSERT_EQ(GRPC_CALL_OK,
+              grpc_server_request_call(server, &server_calls[i], &details[i],
+                                       &request_metadata[i], cqs[i], cqs[i],
+                                       reinterpret_cast<void*>(i + 1)));
+  }
+  // Start a call from the client.
+  grpc_completion_queue* client_cq =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_channel_credentials* channel_creds =
+      grpc_insecure_credentials_create();
+  grpc_channel* channel =
+      grpc_channel_create(addr.c_str(), channel_creds, nullptr);
+  grpc_channel_credentials_release(channel_creds);
+  grpc_call* client_call = grpc_channel_create_call(
+      channel, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  grpc_op op;
+  memset(&op, 0, sizeof(op));
+  op.op = GRPC_OP_SEND_INITIAL_METADATA;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(client_call, &op, 1,
+                                                 reinterpret_cast<void*>(1),
+                                                 nullptr));
+  // Only the request on the expected CQ is matched.
+  size_t matched = 0;
+  const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(30);
+  while (matched == 0 &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    for (size_t i = 0; i < 2 && matched == 0; i++) {
+      grpc_event ev = grpc_completion_queue_next(
+          cqs[i], grpc_timeout_milliseconds_to_deadline(10), nullptr);
+      if (ev.type == GRPC_OP_COMPLETE) {
+        ASSERT_TRUE(ev.success);
+        ASSERT_EQ(ev.tag, reinterpret_cast<void*>(i + 1));
+        matched = i + 1;
+      }
+    }
+  }
+  grpc_core::Server::TestOnlySetCurrentCpuFn(nullptr);
+  ASSERT_EQ(matched, expected + 1);
+  ASSERT_NE(server_calls[expected], nullptr);
+  ASSERT_EQ(server_calls[1 - expected], nullptr);
+  // Tear everything down; the other request fails on shutdown.
+  grpc_call_cancel(client_call, nullptr);
+  grpc_call_unref(client_call);
+  grpc_call_unref(server_calls[matched - 1]);
+  grpc_server_shutdown_and_notify(server, cqs[0], server);
+  grpc_server_cancel_all_calls(server);
+  while (grpc_completion_queue_next(cqs[0], gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                    nullptr)
+             .tag != server) {
+  }
+  grpc_server_destroy(server);
+  grpc_channel_destroy(channel);
+  for (grpc_completion_queue* cq : {cqs[0], cqs[1], client_cq}) {
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+  for (size_t i = 0; i < 2; i++) {
+    grpc_call_details_destroy(&details[i]);
+    grpc_metadata_array_destroy(&request_metadata[i]);
+  }
+}
+
 static bool external_dns_works(const char* host) {
   return grpc_core::GetDNSResolver()->LookupHostnameBlocking(host, "80").ok();
 }
@@ -146,8 +267,11 @@ static void test_bind_server_to_addrs(const char** addrs, size_t n) {
 TEST(ServerTest, MainTest) {
   grpc_init();
   test_register_method_fail();
+  test_registered_method_lookup();
   test_request_call_on_no_server_cq();
   test_bind_server_twice();
+  test_cpu_affine_cqs(0);
+  test_cpu_affine_cqs(3);
 
   static const char* addrs[] = {
       "::1", "127.0.0.1", "::ffff:127.0.0.1", "localhost", "0.0.0.0", "::",
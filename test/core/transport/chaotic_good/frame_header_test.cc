@@ -37,7 +37,7 @@ absl::StatusOr<FrameHeader> Deserialize(std::vector<uint8_t> data) {
 }
 
 TEST(FrameHeaderTest, SimpleSerialize) {
-  EXPECT_EQ(Serialize(FrameHeader{FrameType::kCancel, BitSet<2>::FromInt(0),
+  EXPECT_EQ(Serialize(FrameHeader{FrameType::kCancel, BitSet<3>::FromInt(0),
                                   0x01020304, 0x05060708, 0x090a0b0c,
                                   0x00000034, 0x0d0e0f10}),
             std::vector<uint8_t>({
@@ -60,7 +60,7 @@ TEST(FrameHeaderTest, SimpleDeserialize) {
                 0x10, 0x0f, 0x0e, 0x0d   // trailer_length
             })),
             absl::StatusOr<FrameHeader>(FrameHeader{
-                FrameType::kCancel, BitSet<2>::FromInt(0), 0x01020304,
+                FrameType::kCancel, BitSet<3>::FromInt(0), 0x01020304,
                 0x05060708, 0x090a0b0c, 0x00000034, 0x0d0e0f10}));
   EXPECT_EQ(Deserialize(std::vector<uint8_t>({
                             0x81, 88,   88,   88,    // type, flags
@@ -76,19 +76,19 @@ TEST(FrameHeaderTest, SimpleDeserialize) {
 
 TEST(FrameHeaderTest, GetFrameLength) {
   EXPECT_EQ(
-      (FrameHeader{FrameType::kFragment, BitSet<2>::FromInt(3), 1, 0, 0, 0, 0})
+      (FrameHeader{FrameType::kFragment, BitSet<3>::FromInt(3), 1, 0, 0, 0, 0})
           .GetFrameLength(),
       0);
   EXPECT_EQ(
-      (FrameHeader{FrameType::kFragment, BitSet<2>::FromInt(3), 1, 14, 0, 0, 0})
+      (FrameHeader{FrameType::kFragment, BitSet<3>::FromInt(3), 1, 14, 0, 0, 0})
           .GetFrameLength(),
       14);
-  EXPECT_EQ((FrameHeader{FrameType::kFragment, BitSet<2>::FromInt(3), 1, 0, 14,
+  EXPECT_EQ((FrameHeader{FrameType::kFragment, BitSet<3>::FromInt(3), 1, 0, 14,
                          50, 0})
                 .GetFrameLength(),
             0);
   EXPECT_EQ(
-      (FrameHeader{FrameType::kFragment, BitSet<2>::FromInt(3), 1, 0, 0, 0, 14})
+      (FrameHeader{FrameType::kFragment, BitSet<3>::FromInt(3), 1, 0, 0, 0, 14})
           .GetFrameLength(),
       14);
 }
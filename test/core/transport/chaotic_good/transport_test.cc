@@ -0,0 +1,426 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+#include <grpc/event_engine/slice_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/ext/transport/chaotic_good/client_transport.h"
+#include "src/core/ext/transport/chaotic_good/server_transport.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/event_engine_wakeup_scheduler.h"
+#include "src/core/lib/promise/for_each.h"
+#include "src/core/lib/promise/if.h"
+#include "src/core/lib/promise/join.h"
+#include "src/core/lib/promise/loop.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/promise_endpoint.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace chaotic_good {
+namespace {
+
+using grpc_event_engine::experimental::EventEngine;
+
+// One direction of an in-memory connection.
+struct Wire {
+  Mutex mu;
+  SliceBuffer data ABSL_GUARDED_BY(mu);
+  grpc_event_engine::experimental::SliceBuffer* read_buffer
+      ABSL_GUARDED_BY(mu) = nullptr;
+  absl::AnyInvocable<void(absl::Status)> on_read ABSL_GUARDED_BY(mu);
+  bool closed ABSL_GUARDED_BY(mu) = false;
+};
+
+// Reads from one wire and writes to another.  Callbacks run on the event
+// engine, as they would for a real endpoint.
+class InMemoryEndpoint : public EventEngine::Endpoint {
+ public:
+  InMemoryEndpoint(std::shared_ptr<Wire> in, std::shared_ptr<Wire> out,
+                   std::shared_ptr<EventEngine> event_engine)
+      : in_(std::move(in)),
+        out_(std::move(out)),
+        event_engine_(std::move(event_engine)) {}
+
+  ~InMemoryEndpoint() override {
+    {
+      // The reader is going away with the endpoint; drop its callback.
+      MutexLock lock(&in_->mu);
+      in_->closed = true;
+      in_->on_read = nullptr;
+    }
+    absl::AnyInvocable<void(absl::Status)> on_read;
+    {
+      MutexLock lock(&out_->mu);
+      out_->closed = true;
+      on_read = std::move(out_->on_read);
+    }
+    if (on_read != nullptr) {
+      event_engine_->Run([on_read = std::move(on_read)]() mutable {
+        on_read(absl::UnavailableError("Peer closed"));
+      });
+    }
+  }
+
+  bool Read(absl::AnyInvocable<void(absl::Status)> on_read,
+            grpc_event_engine::experimental::SliceBuffer* buffer,
+            const ReadArgs*) override {
+    MutexLock lock(&in_->mu);
+    if (in_->data.Length() != 0) {
+      grpc_slice_buffer_move_into(in_->data.c_slice_buffer(),
+                                  buffer->c_slice_buffer());
+      return true;
+    }
+    if (in_->closed) {
+      event_engine_->Run([on_read = std::move(on_read)]() mutable {
+        on_read(absl::UnavailableError("Peer closed"));
+      });
+      return false;
+    }
+    in_->read_buffer = buffer;
+    in_->on_read = std::move(on_read);
+    return false;
+  }
+
+  bool Write(absl::AnyInvocable<void(absl::Status)> on_writable,
+             grpc_event_engine::experimental::SliceBuffer* data,
+             const WriteArgs*) override {
+    absl::AnyInvocable<void(absl::Status)> on_read;
+    {
+      MutexLock lock(&out_->mu);
+      if (out_->closed) {
+        event_engine_->Run([on_writable = std::move(on_writable)]() mutable {
+          on_writable(absl::UnavailableError("Peer closed"));
+        });
+        return false;
+      }
+      grpc_slice_buffer_move_into(data->c_slice_buffer(),
+                                  out_->data.c_slice_buffer());
+      if (out_->on_read != nullptr) {
+        grpc_slice_buffer_move_into(out_->data.c_slice_buffer(),
+                                    out_->read_buffer->c_slice_buffer());
+        on_read = std::move(out_->on_read);
+      }
+    }
+    if (on_read != nullptr) {
+      event_engine_->Run([on_read = std::move(on_read)]() mutable {
+        on_read(absl::OkStatus());
+      });
+    }
+    return true;
+  }
+
+  const EventEngine::ResolvedAddress& GetPeerAddress() const override {
+    return address_;
+  }
+  const EventEngine::ResolvedAddress& GetLocalAddress() const override {
+    return address_;
+  }
+
+ private:
+  std::shared_ptr<Wire> in_;
+  std::shared_ptr<Wire> out_;
+  std::shared_ptr<EventEngine> event_engine_;
+  EventEngine::ResolvedAddress address_;
+};
+
+// Echoes the client's messages back, then finishes with OK.
+ArenaPromise<ServerMetadataHandle> EchoHandler(CallArgs call_args) {
+  return Seq(
+      call_args.server_initial_metadata->Push(
+          GetContext<Arena>()->MakePooled<ServerMetadata>(GetContext<Arena>())),
+      [in = call_args.client_to_server_messages,
+       out = call_args.server_to_client_messages](bool) {
+        return ForEach(std::move(*in), [out](MessageHandle message) {
+          return Map(out->Push(std::move(message)), [](bool pushed) {
+            return pushed ? absl::OkStatus() : absl::CancelledError();
+          });
+        });
+      },
+      [](absl::Status status) { return ServerMetadataFromStatus(status); });
+}
+
+class TransportTest : public ::testing::Test {
+ protected:
+  struct CallResult {
+    grpc_status_code status;
+    std::vector<std::string> messages;
+  };
+
+  void MakeTransports(size_t num_data_connections,
+                      ServerTransport::CallHandler call_handler) {
+    std::unique_ptr<PromiseEndpoint> client_control;
+    std::unique_ptr<PromiseEndpoint> server_control;
+    MakeConnection(&client_control, &server_control);
+    std::vector<std::unique_ptr<PromiseEndpoint>> client_data;
+    std::vector<std::unique_ptr<PromiseEndpoint>> server_data;
+    for (size_t i = 0; i < num_data_connections; ++i) {
+      client_data.emplace_back();
+      server_data.emplace_back();
+      MakeConnection(&client_data.back(), &server_data.back());
+    }
+    server_ = std::make_unique<ServerTransport>(
+        std::move(server_control), std::move(server_data), event_engine_,
+        std::move(call_handler));
+    client_ = std::make_unique<ClientTransport>(
+        std::move(client_control), std::move(client_data), event_engine_,
+        [this](absl::Status status) {
+          client_closed_status_ = std::move(status);
+          client_closed_.Notify();
+        });
+  }
+
+  // Makes a call sending messages, and waits for it to finish.
+  CallResult Call(std::vector<std::string> messages) {
+    auto arena = MakeScopedArena(1024, &memory_allocator_);
+    Pipe<ServerMetadataHandle> server_initial_metadata(arena.get());
+    Pipe<MessageHandle> client_to_server_messages(arena.get());
+    Pipe<MessageHandle> server_to_client_messages(arena.get());
+    auto client_initial_metadata =
+        arena->MakePooled<ClientMetadata>(arena.get());
+    client_initial_metadata->Set(HttpPathMetadata(),
+                                 Slice::FromStaticString("/echo"));
+    CallArgs call_args{std::move(client_initial_metadata),
+                       ClientInitialMetadataOutstandingToken::New(arena.get()),
+                       nullptr,
+                       &server_initial_metadata.sender,
+                       &client_to_server_messages.receiver,
+                       &server_to_client_messages.sender};
+    CallResult result;
+    Notification done;
+    size_t next_message = 0;
+    auto send = [&]() {
+      return Loop([&]() {
+        return If(
+            next_message < messages.size(),
+            [&]() {
+              SliceBuffer payload;
+              payload.Append(
+                  Slice::FromCopiedString(messages[next_message++]));
+              return Map(client_to_server_messages.sender.Push(
+                             GetContext<Arena>()->MakePooled<Message>(
+                                 std::move(payload), 0)),
+                         [](bool) -> LoopCtl<absl::Status> {
+                           return Continue();
+                         });
+            },
+            [&]() {
+              client_to_server_messages.sender.Close();
+              return Immediate(LoopCtl<absl::Status>(absl::OkStatus()));
+            });
+      });
+    };
+    auto receive = [&]() {
+      return Seq(server_initial_metadata.receiver.Next(),
+                 [&](NextResult<ServerMetadataHandle>) {
+                   return ForEach(std::move(server_to_client_messages.receiver),
+                                  [&](MessageHandle message) {
+                                    result.messages.push_back(
+                                        message->payload()->JoinIntoString());
+                                    return absl::OkStatus();
+                                  });
+                 });
+    };
+    auto activity = MakeActivity(
+        [&]() {
+          return Map(
+              Join(
+                  // As a call would, stop using the pipes once the trailers
+                  // arrive, even if the transport never took them.
+                  Map(client_->MakeCallPromise(std::move(call_args)),
+                      [&](ServerMetadataHandle trailers) {
+                        client_to_server_messages.receiver.CloseWithError();
+                        server_initial_metadata.sender.Close();
+                        server_to_client_messages.sender.Close();
+                        return trailers;
+                      }),
+                  send(), receive()),
+              [&](std::tuple<ServerMetadataHandle, absl::Status, absl::Status>
+                      r) {
+                result.status = std::get<0>(r)
+                                    ->get(GrpcStatusMetadata())
+                                    .value_or(GRPC_STATUS_UNKNOWN);
+                return absl::OkStatus();
+              });
+        },
+        EventEngineWakeupScheduler(event_engine_),
+        [&](absl::Status) { done.Notify(); }, arena.get());
+    done.WaitForNotification();
+    return result;
+  }
+
+  void DestroyServer() { server_.reset(); }
+  void DisconnectClient(absl::Status status) {
+    client_->Disconnect(std::move(status));
+  }
+
+  // Waits for the client transport to close, and returns the error it
+  // reported.
+  absl::Status WaitForClientClosed() {
+    client_closed_.WaitForNotification();
+    return client_closed_status_;
+  }
+
+  void TearDown() override {
+    client_.reset();
+    server_.reset();
+  }
+
+ private:
+  void MakeConnection(std::unique_ptr<PromiseEndpoint>* client,
+                      std::unique_ptr<PromiseEndpoint>* server) {
+    auto to_server = std::make_shared<Wire>();
+    auto to_client = std::make_shared<Wire>();
+    *client = std::make_unique<PromiseEndpoint>(
+        std::make_unique<InMemoryEndpoint>(to_client, to_server,
+                                           event_engine_),
+        SliceBuffer());
+    *server = std::make_unique<PromiseEndpoint>(
+        std::make_unique<InMemoryEndpoint>(to_server, to_client,
+                                           event_engine_),
+        SliceBuffer());
+  }
+
+  std::shared_ptr<EventEngine> event_engine_ =
+      grpc_event_engine::experimental::GetDefaultEventEngine();
+  MemoryAllocator memory_allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test");
+  Notification client_closed_;
+  absl::Status client_closed_status_;
+  std::unique_ptr<ServerTransport> server_;
+  std::unique_ptr<ClientTransport> client_;
+};
+
+TEST_F(TransportTest, UnaryCall) {
+  MakeTransports(1, EchoHandler);
+  auto result = Call({"hello"});
+  EXPECT_EQ(result.status, GRPC_STATUS_OK);
+  EXPECT_EQ(result.messages, std::vector<std::string>{"hello"});
+}
+
+TEST_F(TransportTest, StreamingCallOverSeveralDataConnections) {
+  MakeTransports(3, EchoHandler);
+  // Lengths around the alignment, so that some payloads need no padding.
+  std::vector<std::string> messages;
+  for (size_t length : {0, 1, 63, 64, 65, 100000}) {
+    messages.push_back(std::string(length, 'a' + messages.size()));
+  }
+  for (int i = 0; i < 5; ++i) {
+    auto result = Call(messages);
+    EXPECT_EQ(result.status, GRPC_STATUS_OK);
+    EXPECT_EQ(result.messages, messages);
+  }
+}
+
+TEST_F(TransportTest, CallFailsAfterServerGoesAway) {
+  MakeTransports(2, EchoHandler);
+  EXPECT_EQ(Call({"hello"}).status, GRPC_STATUS_OK);
+  DestroyServer();
+  EXPECT_EQ(Call({"hello"}).status, GRPC_STATUS_UNAVAILABLE);
+  EXPECT_EQ(WaitForClientClosed().code(), absl::StatusCode::kUnavailable);
+}
+
+TEST_F(TransportTest, DisconnectFailsOpenCalls) {
+  Notification call_started;
+  MakeTransports(1, [&call_started](CallArgs) {
+    call_started.Notify();
+    return ArenaPromise<ServerMetadataHandle>(Never<ServerMetadataHandle>());
+  });
+  std::thread disconnect([&]() {
+    call_started.WaitForNotification();
+    DisconnectClient(absl::UnavailableError("Disconnected"));
+  });
+  EXPECT_EQ(Call({"hello"}).status, GRPC_STATUS_UNAVAILABLE);
+  disconnect.join();
+  EXPECT_EQ(WaitForClientClosed().message(), "Disconnected");
+  EXPECT_EQ(Call({"hello"}).status, GRPC_STATUS_UNAVAILABLE);
+}
+
+// A call that stops reading its messages is failed once too much is queued
+// for it, without holding up the other calls on its data connection.
+TEST_F(TransportTest, StalledCallFailsAlone) {
+  std::atomic<int> num_calls{0};
+  MakeTransports(1, [&num_calls](CallArgs call_args) {
+    if (num_calls.fetch_add(1) == 0) {
+      return ArenaPromise<ServerMetadataHandle>(Never<ServerMetadataHandle>());
+    }
+    return EchoHandler(std::move(call_args));
+  });
+  std::vector<std::string> messages(
+      5, std::string(ChaoticGoodTransport::kMaxQueuedBytesPerStream / 3, 'a'));
+  EXPECT_EQ(Call(messages).status, GRPC_STATUS_RESOURCE_EXHAUSTED);
+  auto result = Call({"hello"});
+  EXPECT_EQ(result.status, GRPC_STATUS_OK);
+  EXPECT_EQ(result.messages, std::vector<std::string>{"hello"});
+}
+
+// The server's calls are not owned by its transport, and finish on their
+// own once the transport cancels them.
+TEST_F(TransportTest, ServerCallOutlivesServerTransport) {
+  Notification call_started;
+  MakeTransports(1, [&call_started](CallArgs) {
+    call_started.Notify();
+    return ArenaPromise<ServerMetadataHandle>(Never<ServerMetadataHandle>());
+  });
+  std::thread destroy_server([&]() {
+    call_started.WaitForNotification();
+    DestroyServer();
+  });
+  EXPECT_EQ(Call({"hello"}).status, GRPC_STATUS_UNAVAILABLE);
+  destroy_server.join();
+}
+
+}  // namespace
+}  // namespace chaotic_good
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -20,12 +20,15 @@
 
 #include <string.h>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/decode_huff.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "test/core/util/test_config.h"
@@ -173,6 +176,32 @@ TEST(BinEncoderTest, MainTest) {
   expect_binary_header("-bin", 0);
 }
 
+TEST(BinEncoderTest, HuffmanRoundTripsLongInputs) {
+  // Long inputs mixing short and long codes exercise output that is written a
+  // word at a time, with codes straddling word boundaries.
+  for (size_t length : {1, 3, 4, 5, 7, 8, 9, 31, 32, 33, 255, 256, 1000}) {
+    for (int stride : {1, 7, 97}) {
+      std::vector<uint8_t> input;
+      for (size_t i = 0; i < length; i++) {
+        input.push_back(static_cast<uint8_t>(i * stride));
+      }
+      grpc_slice uncompressed =
+          grpc_slice_from_copied_buffer(reinterpret_cast<char*>(input.data()),
+                                        input.size());
+      grpc_slice compressed = grpc_chttp2_huffman_compress(uncompressed);
+      std::vector<uint8_t> output;
+      auto add = [&output](uint8_t c) { output.push_back(c); };
+      EXPECT_TRUE(grpc_core::HuffDecoder<decltype(add)>(
+                      add, GRPC_SLICE_START_PTR(compressed),
+                      GRPC_SLICE_END_PTR(compressed))
+                      .Run());
+      EXPECT_EQ(input, output) << "length=" << length << " stride=" << stride;
+      grpc_slice_unref(uncompressed);
+      grpc_slice_unref(compressed);
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
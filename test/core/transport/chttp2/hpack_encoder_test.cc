@@ -24,6 +24,7 @@
 #include <memory>
 #include <string>
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -301,6 +302,90 @@ TEST(HpackEncoderTest, UserAgentMetadataNoIndexing) {
   grpc_slice_unref(encoded_header);
 }
 
+TEST(HpackEncoderTest, IndexedApplicationHeaders) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::HPackCompressor compressor;
+  compressor.SetIndexedHeaders("x-tenant, x-route");
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(1024, &memory_allocator);
+  grpc_transport_one_way_stats stats = {};
+  grpc_core::HPackCompressor::EncodeHeaderOptions hopt{
+      0xdeadbeef,  // stream_id
+      false,       // is_eof
+      false,       // use_true_binary_metadata
+      16384,       // max_frame_size
+      &stats       // stats
+  };
+  auto encode = [&]() {
+    grpc_metadata_batch b(arena.get());
+    b.Append("x-tenant", grpc_core::Slice::FromStaticString("a"),
+             CrashOnAppendError);
+    b.Append("x-other", grpc_core::Slice::FromStaticString("b"),
+             CrashOnAppendError);
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&output);
+    compressor.EncodeHeaders(hopt, b, &output);
+    grpc_core::Slice merged(grpc_slice_merge(output.slices, output.count));
+    grpc_slice_buffer_destroy(&output);
+    return merged;
+  };
+  // First use: x-tenant is added to the table, x-other is a plain literal.
+  EXPECT_EQ(encode(),
+            grpc_core::ParseHexstring(
+                "000017 0104 deadbeef 40 0878 2d74 656e 616e 74 0161"
+                "00 0778 2d6f 7468 6572 0162"));
+  // Second use: x-tenant is a reference to dynamic table entry 62.
+  EXPECT_EQ(encode(), grpc_core::ParseHexstring("00000c 0104 deadbeef be"
+                                                "00 0778 2d6f 7468 6572 0162"));
+  EXPECT_EQ(compressor.table_stats().dynamic_hits, 1u);
+  EXPECT_EQ(compressor.table_stats().dynamic_inserts, 1u);
+  EXPECT_EQ(compressor.table_stats().literals, 2u);
+}
+
+// A configured header with many distinct values must not grow the index of
+// values it remembers without bound.
+TEST(HpackEncoderTest, IndexedApplicationHeaderValuesAreBounded) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::HPackCompressor compressor;
+  // Names are matched in lower case, as metadata keys are sent.
+  compressor.SetIndexedHeaders("X-Request-Id, bad header");
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(1024, &memory_allocator);
+  grpc_transport_one_way_stats stats = {};
+  grpc_core::HPackCompressor::EncodeHeaderOptions hopt{
+      0xdeadbeef,  // stream_id
+      false,       // is_eof
+      false,       // use_true_binary_metadata
+      16384,       // max_frame_size
+      &stats       // stats
+  };
+  // Small values, so that the dynamic table can hold more of them than the
+  // index remembers.
+  compressor.SetMaxUsableSize(grpc_core::HPackCompressor::kMaxTableSize);
+  compressor.SetMaxTableSize(grpc_core::HPackCompressor::kMaxTableSize);
+  for (int i = 0; i < 1000; i++) {
+    grpc_metadata_batch b(arena.get());
+    b.Append("x-request-id",
+             grpc_core::Slice::FromCopiedString(absl::StrCat(i)),
+             CrashOnAppendError);
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&output);
+    compressor.EncodeHeaders(hopt, b, &output);
+    grpc_slice_buffer_destroy(&output);
+    ASSERT_LE(compressor.test_only_indexed_values("x-request-id"),
+              grpc_core::hpack_encoder_detail::SliceIndex::kMaxValues);
+  }
+  EXPECT_EQ(compressor.test_only_indexed_values("x-request-id"),
+            grpc_core::hpack_encoder_detail::SliceIndex::kMaxValues);
+  EXPECT_EQ(compressor.table_stats().dynamic_inserts, 1000u);
+}
+
 static void verify_continuation_headers(const char* key, const char* value,
                                         bool is_eof) {
   grpc_core::MemoryAllocator memory_allocator =
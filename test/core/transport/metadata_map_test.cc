@@ -141,6 +141,40 @@ TEST_F(MetadataMapTest, NonEncodableTrait) {
   EXPECT_EQ(map.DebugString(), "GrpcStreamNetworkState: not sent on wire");
 }
 
+TEST_F(MetadataMapTest, ManyUnknownMetadata) {
+  auto arena = MakeScopedArena(1024, &memory_allocator_);
+  TimeoutOnlyMetadataMap map(arena.get());
+  auto on_error = [](absl::string_view, const Slice&) { abort(); };
+  // Enough entries to go through the hashed index, with one repeated key.
+  for (int i = 0; i < 40; i++) {
+    map.Append(absl::StrCat("x-key-", i), Slice::FromCopiedString("v"),
+               on_error);
+    if (i % 10 == 0) {
+      map.Append("x-repeated", Slice::FromCopiedString(absl::StrCat(i)),
+                 on_error);
+    }
+  }
+  EXPECT_EQ(map.count(), 44u);
+  std::string backing;
+  EXPECT_EQ(map.GetStringValue("x-key-0", &backing), "v");
+  EXPECT_EQ(map.GetStringValue("x-key-39", &backing), "v");
+  EXPECT_EQ(map.GetStringValue("x-key-40", &backing), absl::nullopt);
+  EXPECT_EQ(map.GetStringValue("x-repeated", &backing), "0,10,20,30");
+  map.Remove("x-key-7");
+  map.Remove("x-not-present");
+  EXPECT_EQ(map.count(), 43u);
+  EXPECT_EQ(map.GetStringValue("x-key-7", &backing), absl::nullopt);
+  EXPECT_EQ(map.GetStringValue("x-key-8", &backing), "v");
+  EXPECT_EQ(map.GetStringValue("x-repeated", &backing), "0,10,20,30");
+  map.Remove("x-repeated");
+  EXPECT_EQ(map.GetStringValue("x-repeated", &backing), absl::nullopt);
+  map.Append("x-repeated", Slice::FromCopiedString("again"), on_error);
+  EXPECT_EQ(map.GetStringValue("x-repeated", &backing), "again");
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.GetStringValue("x-key-0", &backing), absl::nullopt);
+}
+
 TEST(DebugStringBuilderTest, AddOne) {
   metadata_detail::DebugStringBuilder b;
   b.Add("a", "b");
@@ -0,0 +1,219 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A client and a server talking over a "shm:" connection: the unix socket
+// handshake, the segment handover and chttp2 on top of the shm endpoint.
+
+#include <string.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/impl/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/iomgr/port.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <unistd.h>
+
+namespace grpc_core {
+namespace {
+
+// Larger than a block, so that messages span several of them.
+constexpr size_t kMessageSize = 200 * 1024;
+
+class ShmEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    address_ = absl::StrCat("shm:/tmp/grpc_shm_end2end_test.", getpid());
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_credentials* server_creds =
+        grpc_insecure_server_credentials_create();
+    ASSERT_TRUE(
+        grpc_server_add_http2_port(server_, address_.c_str(), server_creds));
+    grpc_server_credentials_release(server_creds);
+    grpc_server_start(server_);
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    channel_ = grpc_channel_create(address_.c_str(), creds, nullptr);
+    grpc_channel_credentials_release(creds);
+  }
+
+  void TearDown() override {
+    grpc_channel_destroy(channel_);
+    CqVerifier cqv(cq_);
+    grpc_server_shutdown_and_notify(server_, cq_, CqVerifier::tag(1000));
+    cqv.Expect(CqVerifier::tag(1000), true);
+    cqv.Verify();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  std::string address_;
+  grpc_completion_queue* cq_;
+  grpc_server* server_;
+  grpc_channel* channel_;
+};
+
+TEST_F(ShmEnd2endTest, UnaryCall) {
+  CqVerifier cqv(cq_);
+  const std::string request(kMessageSize, 'a');
+  const std::string response(kMessageSize, 'b');
+  grpc_slice request_slice =
+      grpc_slice_from_copied_buffer(request.data(), request.size());
+  grpc_byte_buffer* request_payload =
+      grpc_raw_byte_buffer_create(&request_slice, 1);
+  grpc_slice response_slice =
+      grpc_slice_from_copied_buffer(response.data(), response.size());
+  grpc_byte_buffer* response_payload =
+      grpc_raw_byte_buffer_create(&response_slice, 1);
+  grpc_byte_buffer* request_payload_recv = nullptr;
+  grpc_byte_buffer* response_payload_recv = nullptr;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details call_details;
+  grpc_status_code status;
+  grpc_slice details;
+  int was_cancelled = 2;
+  grpc_metadata_array_init(&initial_metadata_recv);
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_metadata_array_init(&request_metadata_recv);
+  grpc_call_details_init(&call_details);
+
+  grpc_call* c = grpc_channel_create_call(
+      channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  ASSERT_NE(c, nullptr);
+  grpc_op ops[6];
+  memset(ops, 0, sizeof(ops));
+  grpc_op* op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = request_payload;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata = &initial_metadata_recv;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &response_payload_recv;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &status;
+  op->data.recv_status_on_client.status_details = &details;
+  op++;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(c, ops, op - ops,
+                                                CqVerifier::tag(1), nullptr));
+
+  grpc_call* s;
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_server_request_call(server_, &s, &call_details,
+                                     &request_metadata_recv, cq_, cq_,
+                                     CqVerifier::tag(101)));
+  cqv.Expect(CqVerifier::tag(101), true);
+  cqv.Verify();
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &request_payload_recv;
+  op++;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(s, ops, op - ops,
+                                                CqVerifier::tag(102), nullptr));
+  cqv.Expect(CqVerifier::tag(102), true);
+  cqv.Verify();
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &was_cancelled;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = response_payload;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.status = GRPC_STATUS_OK;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+  op->data.send_status_from_server.status_details = &status_details;
+  op++;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(s, ops, op - ops,
+                                                CqVerifier::tag(103), nullptr));
+  cqv.Expect(CqVerifier::tag(103), true);
+  cqv.Expect(CqVerifier::tag(1), true);
+  cqv.Verify();
+
+  EXPECT_EQ(status, GRPC_STATUS_OK);
+  EXPECT_EQ(grpc_slice_str_cmp(details, "xyz"), 0);
+  EXPECT_EQ(grpc_slice_str_cmp(call_details.method, "/foo"), 0);
+  EXPECT_EQ(was_cancelled, 0);
+  EXPECT_TRUE(byte_buffer_eq_string(request_payload_recv, request.c_str()));
+  EXPECT_TRUE(byte_buffer_eq_string(response_payload_recv, response.c_str()));
+
+  grpc_slice_unref(details);
+  grpc_slice_unref(request_slice);
+  grpc_slice_unref(response_slice);
+  grpc_metadata_array_destroy(&initial_metadata_recv);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+  grpc_byte_buffer_destroy(request_payload);
+  grpc_byte_buffer_destroy(response_payload);
+  grpc_byte_buffer_destroy(request_payload_recv);
+  grpc_byte_buffer_destroy(response_payload_recv);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
@@ -0,0 +1,107 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/port.h"
+#include "test/core/iomgr/endpoint_tests.h"
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+static void clean_up(void) {}
+
+static grpc_endpoint_test_fixture create_fixture_shm_endpoint_pair(
+    size_t /*slice_size*/) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_test_fixture f;
+  grpc_endpoint_pair p = grpc_core::CreateShmEndpointPair("test");
+  f.client_ep = p.client;
+  f.server_ep = p.server;
+  grpc_endpoint_add_to_pollset(f.client_ep, g_pollset);
+  grpc_endpoint_add_to_pollset(f.server_ep, g_pollset);
+  return f;
+}
+
+static grpc_endpoint_test_config configs[] = {
+    {"shm/shm_pair", create_fixture_shm_endpoint_pair, clean_up},
+};
+
+static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+TEST(ShmEndpointTest, MainTest) {
+  grpc_closure destroyed;
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+    grpc_endpoint_tests(configs[0], g_pollset, g_mu);
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+  }
+  grpc_shutdown();
+  gpr_free(g_pollset);
+}
+
+// A peer could resize a segment it did not seal under the other side's
+// mapping, so such segments are refused.
+TEST(ShmEndpointTest, RejectsUnsealedSegment) {
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    auto fds = grpc_core::CreateShmConnection();
+    ASSERT_TRUE(fds.ok());
+    close(fds->memfd);
+    fds->memfd = syscall(SYS_memfd_create, "unsealed", 0);
+    ASSERT_GE(fds->memfd, 0);
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    close(sv[1]);
+    auto endpoint = grpc_core::CreateShmEndpoint(
+        grpc_core::ShmSide::kServer, *fds,
+        grpc_fd_create(sv[0], "unsealed", false), "peer", "local");
+    EXPECT_FALSE(endpoint.ok());
+  }
+  grpc_shutdown();
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
@@ -23,7 +23,9 @@
 
 #include <deque>
 #include <map>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -900,6 +902,42 @@ TEST_F(RlsEnd2endTest, FailedRlsRequestWithDefaultTarget) {
   EXPECT_EQ(backends_[0]->service_.request_count(), 1);
 }
 
+TEST_F(RlsEnd2endTest, EntryInBackoffUsesDefaultTarget) {
+  StartBackends(1);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_default_target(TargetStringForPort(backends_[0]->port_))
+          .Build());
+  // Don't give the RLS server a response, so the RLS request will fail
+  // and the cache entry goes into backoff.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 1);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 1);
+  // While the entry is in backoff, picks find it in the picker's snapshot
+  // and go to the default target without another RLS request.
+  for (int i = 0; i < 3; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", kTestValue}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), 1);
+  EXPECT_EQ(rls_server_->service_.response_count(), 0);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 4);
+}
+
 TEST_F(RlsEnd2endTest, RlsRequestTimeout) {
   StartBackends(2);
   SetNextResolution(
@@ -1064,6 +1102,63 @@ TEST_F(RlsEnd2endTest, StaleCacheEntry) {
   EXPECT_EQ(rls_server_->service_.response_count(), 2);
 }
 
+TEST_F(RlsEnd2endTest, PicksUseSnapshotTakenAfterCacheUpdate) {
+  const char* kTestValue2 = "test_value2";
+  StartBackends(2);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_max_age(grpc_core::Duration::Seconds(10))
+          .set_stale_age(grpc_core::Duration::Seconds(2))
+          .Build());
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue2}}),
+      BuildRlsResponse({TargetStringForPort(backends_[1]->port_)}));
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue2}}));
+  EXPECT_EQ(backends_[0]->service_.request_count(), 1);
+  EXPECT_EQ(backends_[1]->service_.request_count(), 1);
+  // The refresh for kTestValue points it at the target kTestValue2 already
+  // uses, so no new child policy reports a picker: the RLS response itself
+  // must produce a picker with the updated entry.
+  rls_server_->service_.RemoveResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}));
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}},
+                      RouteLookupRequest::REASON_STALE),
+      BuildRlsResponse({TargetStringForPort(backends_[1]->port_)}));
+  // Wait longer than stale age.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(3));
+  // This RPC uses the stale data and dispatches the refresh.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  EXPECT_EQ(backends_[0]->service_.request_count(), 2);
+  // Wait for the refresh to complete.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(1));
+  EXPECT_EQ(rls_server_->service_.response_count(), 3);
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  EXPECT_EQ(backends_[0]->service_.request_count(), 2);
+  EXPECT_EQ(backends_[1]->service_.request_count(), 2);
+}
+
 TEST_F(RlsEnd2endTest, StaleCacheEntryWithHeaderData) {
   const char* kHeaderData = "header_data";
   StartBackends(1);
@@ -1232,6 +1327,65 @@ TEST_F(RlsEnd2endTest, CacheSizeLimit) {
   EXPECT_EQ(backends_[1]->service_.request_count(), 2);
 }
 
+TEST_F(RlsEnd2endTest, CacheSizeLimitSparesRecentlyUsedEntries) {
+  // Keys big enough that the cache holds three entries but not four,
+  // whatever the per-entry overhead.
+  std::vector<std::string> values;
+  for (char c = 'a'; c <= 'e'; ++c) values.emplace_back(4000, c);
+  StartBackends(1);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_cache_size_bytes(42000)
+          .Build());
+  for (const std::string& value : values) {
+    rls_server_->service_.SetResponse(
+        BuildRlsRequest({{kTestKey, value}}),
+        BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  }
+  // Fill the cache with entries for values 0, 1 and 2.
+  for (int i = 0; i < 3; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", values[i]}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), 3);
+  // Wait for min_eviction_time to elapse.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(6));
+  // Adding an entry for value 3 evicts one of the others, after every
+  // entry's second chance for its first use has been spent.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[3]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 4);
+  // Value 1 is now at the front of the LRU list.  Use it, so the next
+  // eviction passes over it and takes value 2 instead.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[1]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 4);
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[4]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 5);
+  // Value 1 is still cached; value 2 is not.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[1]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 5);
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", values[2]}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 6);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 8);
+}
+
 TEST_F(RlsEnd2endTest, MultipleTargets) {
   StartBackends(1);
   SetNextResolution(
@@ -22,6 +22,7 @@
 
 #include "src/core/lib/event_engine/common_closures.h"
 #include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
+#include "src/core/lib/event_engine/work_queue/lock_free_work_queue.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "test/core/util/test_config.h"
 
@@ -30,6 +31,7 @@ namespace {
 using ::grpc_event_engine::experimental::AnyInvocableClosure;
 using ::grpc_event_engine::experimental::BasicWorkQueue;
 using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::LockFreeWorkQueue;
 
 grpc_core::Mutex globalMu;
 BasicWorkQueue globalWorkQueue;
@@ -124,6 +126,86 @@ void BM_MultithreadedStdDequeLIFO(benchmark::State& state) {
 }
 BENCHMARK(BM_MultithreadedStdDequeLIFO)->Apply(MultithreadedTestArguments);
 
+// --- Work Stealing Tests ---------------------------------------------------
+//
+// Each benchmark thread owns one queue. It adds closures to its own queue and
+// pops the most recent ones, then steals the oldest closures from its
+// neighbor's queue. This is how the WorkStealingThreadPool uses its
+// thread-local queues. Note that LockFreeWorkQueue only supports Add and
+// PopMostRecent from a single owner thread.
+
+constexpr int kMaxStealingThreads = 64;
+BasicWorkQueue globalOverflowQueue;
+
+void WorkStealingTestArguments(benchmark::internal::Benchmark* b) {
+  b->Range(8, 512)
+      ->UseRealTime()
+      ->MeasureProcessCPUTime()
+      ->ThreadRange(1, kMaxStealingThreads);
+}
+
+template <typename Queue>
+Queue* NewStealingQueue();
+
+template <>
+BasicWorkQueue* NewStealingQueue<BasicWorkQueue>() {
+  return new BasicWorkQueue();
+}
+
+template <>
+LockFreeWorkQueue* NewStealingQueue<LockFreeWorkQueue>() {
+  return new LockFreeWorkQueue(&globalOverflowQueue);
+}
+
+template <typename Queue>
+Queue* StealingQueue(int thread_index) {
+  static Queue** queues = [] {
+    auto** queues = new Queue*[kMaxStealingThreads];
+    for (int i = 0; i < kMaxStealingThreads; i++) {
+      queues[i] = NewStealingQueue<Queue>();
+    }
+    return queues;
+  }();
+  return queues[thread_index];
+}
+
+template <typename Queue>
+void BM_MultithreadedWorkStealing(benchmark::State& state) {
+  AnyInvocableClosure closure([] {});
+  int element_count = state.range(0);
+  Queue* local = StealingQueue<Queue>(state.thread_index());
+  Queue* victim =
+      StealingQueue<Queue>((state.thread_index() + 1) % state.threads());
+  double pop_attempts = 0;
+  double popped = 0;
+  double stolen = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < element_count; i++) local->Add(&closure);
+    // Drain the local queue. The owner may lose the last element to a thief.
+    do {
+      ++pop_attempts;
+      if (local->PopMostRecent() != nullptr) ++popped;
+    } while (!local->Empty());
+    for (int i = 0; i < element_count; i++) {
+      ++pop_attempts;
+      if (victim->PopOldest() != nullptr) ++stolen;
+    }
+  }
+  state.counters["added"] = element_count * state.iterations();
+  state.counters["pop_rate"] =
+      benchmark::Counter(popped + stolen, benchmark::Counter::kIsRate);
+  state.counters["steal_rate"] =
+      benchmark::Counter(stolen, benchmark::Counter::kIsRate);
+  state.counters["pop_attempts"] = pop_attempts;
+  state.counters["hit_rate"] = benchmark::Counter(
+      (popped + stolen) / pop_attempts, benchmark::Counter::kAvgThreads);
+  GPR_ASSERT(globalOverflowQueue.Empty());
+}
+BENCHMARK_TEMPLATE(BM_MultithreadedWorkStealing, BasicWorkQueue)
+    ->Apply(WorkStealingTestArguments);
+BENCHMARK_TEMPLATE(BM_MultithreadedWorkStealing, LockFreeWorkQueue)
+    ->Apply(WorkStealingTestArguments);
+
 // --- Basic Functionality Tests ---------------------------------------------
 
 void BM_WorkQueueIntptrPopMostRecent(benchmark::State& state) {
@@ -147,6 +229,27 @@ BENCHMARK(BM_WorkQueueIntptrPopMostRecent)
     ->UseRealTime()
     ->MeasureProcessCPUTime();
 
+void BM_LockFreeWorkQueueIntptrPopMostRecent(benchmark::State& state) {
+  LockFreeWorkQueue queue(&globalOverflowQueue);
+  grpc_event_engine::experimental::AnyInvocableClosure closure([] {});
+  int element_count = state.range(0);
+  for (auto _ : state) {
+    int cnt = 0;
+    for (int i = 0; i < element_count; i++) queue.Add(&closure);
+    do {
+      if (queue.PopMostRecent() != nullptr) ++cnt;
+    } while (cnt < element_count);
+  }
+  state.counters["Added"] = element_count * state.iterations();
+  state.counters["Popped"] = state.counters["Added"];
+  state.counters["Pop Rate"] =
+      benchmark::Counter(state.counters["Popped"], benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_LockFreeWorkQueueIntptrPopMostRecent)
+    ->Range(1, 512)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+
 void BM_WorkQueueClosureExecution(benchmark::State& state) {
   BasicWorkQueue queue;
   int element_count = state.range(0);
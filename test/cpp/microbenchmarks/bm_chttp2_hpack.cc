@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <sstream>
+#include <utility>
 
 #include <benchmark/benchmark.h>
 
@@ -29,6 +30,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/lib/gprpp/crash.h"
@@ -302,6 +304,8 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<31, false>)
     ->Args({0, 16384});
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<100, false>)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<1000, false>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonBinaryElem)
     ->Args({0, 1});
@@ -361,6 +365,10 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
       GPR_ASSERT(error.ok());
     }
   };
+  size_t benchmark_bytes = 0;
+  for (const grpc_slice& slice : benchmark_slices) {
+    benchmark_bytes += GRPC_SLICE_LENGTH(slice);
+  }
   parse_vec(init_slices);
   while (state.KeepRunning()) {
     b->Clear();
@@ -380,6 +388,7 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
                        1, grpc_core::HPackParser::LogInfo::kHeaders, false});
     }
   }
+  state.SetBytesProcessed(state.iterations() * benchmark_bytes);
   // Clean up
   b.Destroy();
   for (auto slice : init_slices) grpc_slice_unref(slice);
@@ -610,6 +619,61 @@ using RepresentativeServerTrailingMetadata = FromEncoderFixture<
 using MoreRepresentativeClientInitialMetadata = FromEncoderFixture<
     hpack_encoder_fixtures::MoreRepresentativeClientInitialMetadata>;
 
+// A header block of representative client headers, all sent as huffman coded
+// literals without indexing: each iteration has to huffman decode every name
+// and value.
+class HuffmanCodedHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    static const std::pair<const char*, const char*> kHeaders[] = {
+        {":path", "/grpc.testing.EchoTestService/Echo"},
+        {":authority", "foo.googleapis.com:443"},
+        {"user-agent", "grpc-c++/1.59.0-dev grpc-c/35.0.0 (linux; chttp2)"},
+        {"content-type", "application/grpc"},
+        {"te", "trailers"},
+        {"grpc-accept-encoding", "identity,deflate,gzip"},
+        {"grpc-timeout", "29998u"},
+        {"traceparent",
+         "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+        {"tracestate", "congo=t61rcWkgMzE,rojo=00f067aa0ba902b7"},
+        {"cookie", "SID=31d4d96e407aad42; lang=en-US"},
+        {"authorization",
+         "Bearer ya29.a0AfH6SMBx-3kqLX9Vn0zqU4u7Wkq5YbN2Fz8oQp1sT6rJ"},
+        {"x-request-id", "f058ebd6-02f7-4d3f-942e-904344e8cde5"},
+    };
+    std::vector<uint8_t> bytes;
+    for (const auto& header : kHeaders) {
+      bytes.push_back(0x00);
+      AppendHuffmanString(header.first, &bytes);
+      AppendHuffmanString(header.second, &bytes);
+    }
+    return {MakeSlice(bytes)};
+  }
+
+ private:
+  static void AppendHuffmanString(const char* s, std::vector<uint8_t>* out) {
+    grpc_slice raw = grpc_slice_from_static_string(s);
+    grpc_slice huff = grpc_chttp2_huffman_compress(raw);
+    size_t length = GRPC_SLICE_LENGTH(huff);
+    // Huffman flag and a 7 bit prefixed length.
+    if (length < 0x7f) {
+      out->push_back(0x80 | static_cast<uint8_t>(length));
+    } else {
+      out->push_back(0xff);
+      length -= 0x7f;
+      while (length >= 0x80) {
+        out->push_back(0x80 | static_cast<uint8_t>(length & 0x7f));
+        length >>= 7;
+      }
+      out->push_back(static_cast<uint8_t>(length));
+    }
+    out->insert(out->end(), GRPC_SLICE_START_PTR(huff),
+                GRPC_SLICE_END_PTR(huff));
+    grpc_slice_unref(huff);
+  }
+};
+
 // Send the same deadline repeatedly
 class SameDeadline {
  public:
@@ -657,6 +721,7 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanCodedHeaders);
 
 }  // namespace hpack_parser_fixtures
 
@@ -0,0 +1,138 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark message compression at different zlib levels, serial and parallel
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/impl/compression_types.h>
+
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// Roughly what a serialized message with many repeated string and varint
+// fields looks like: compressible, but not trivially so.
+grpc_core::SliceBuffer MakePayload(size_t size) {
+  std::string data;
+  for (uint32_t i = 0; data.size() < size; i++) {
+    data += absl::StrCat("\x0a\x08user", i % 1000, "\x10",
+                         std::string(1, static_cast<char>(i * 2654435761u)),
+                         "\x1a\x05"
+                         "en-US");
+  }
+  data.resize(size);
+  grpc_core::SliceBuffer payload;
+  // Messages arrive from the application in blocks of about this size.
+  constexpr size_t kSliceSize = 8192;
+  for (size_t offset = 0; offset < size; offset += kSliceSize) {
+    payload.Append(
+        grpc_core::Slice::FromCopiedString(data.substr(offset, kSliceSize)));
+  }
+  return payload;
+}
+
+// Args: payload size, zlib level, parallel chunk size (0 for serial).
+void BM_Compress(benchmark::State& state,
+                 grpc_compression_algorithm algorithm) {
+  grpc_core::ExecCtx exec_ctx;
+  auto event_engine = grpc_event_engine::experimental::GetDefaultEventEngine();
+  grpc_core::MessageCompressionOptions options;
+  options.zlib_level = state.range(1);
+  options.parallel_chunk_size = state.range(2);
+  options.event_engine = event_engine.get();
+  grpc_core::SliceBuffer input = MakePayload(state.range(0));
+  size_t compressed_length = 0;
+  for (auto _ : state) {
+    grpc_core::SliceBuffer output;
+    grpc_msg_compress(algorithm, input.c_slice_buffer(),
+                      output.c_slice_buffer(), options);
+    compressed_length = output.Length();
+  }
+  state.SetBytesProcessed(state.iterations() * input.Length());
+  state.counters["ratio"] =
+      static_cast<double>(input.Length()) / compressed_length;
+}
+
+void BM_Decompress(benchmark::State& state,
+                   grpc_compression_algorithm algorithm) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::MessageCompressionOptions options;
+  options.zlib_level = state.range(1);
+  grpc_core::SliceBuffer input = MakePayload(state.range(0));
+  grpc_core::SliceBuffer compressed;
+  grpc_msg_compress(algorithm, input.c_slice_buffer(),
+                    compressed.c_slice_buffer(), options);
+  for (auto _ : state) {
+    grpc_core::SliceBuffer output;
+    grpc_msg_decompress(algorithm, compressed.c_slice_buffer(),
+                        output.c_slice_buffer());
+  }
+  state.SetBytesProcessed(state.iterations() * input.Length());
+}
+
+void CompressArgs(benchmark::internal::Benchmark* b) {
+  for (int size : {64 * 1024, 4 * 1024 * 1024}) {
+    for (int level : {1, 6, 9}) {
+      for (int chunk_size : {0, 128 * 1024}) {
+        if (chunk_size != 0 && size < 2 * chunk_size) continue;
+        b->Args({size, level, chunk_size});
+      }
+    }
+  }
+}
+
+void DecompressArgs(benchmark::internal::Benchmark* b) {
+  for (int size : {64 * 1024, 4 * 1024 * 1024}) {
+    b->Args({size, 6});
+  }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Compress, deflate, GRPC_COMPRESS_DEFLATE)
+    ->Apply(CompressArgs)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Compress, gzip, GRPC_COMPRESS_GZIP)
+    ->Apply(CompressArgs)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Decompress, deflate, GRPC_COMPRESS_DEFLATE)
+    ->Apply(DecompressArgs);
+BENCHMARK_CAPTURE(BM_Decompress, gzip, GRPC_COMPRESS_GZIP)
+    ->Apply(DecompressArgs);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include <atomic>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -43,6 +44,9 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+// Number of completions queued by each pollset_work call, like a poller that
+// finds several fds ready at once.
+static int g_completions_per_work = 1;
 
 namespace grpc {
 namespace testing {
@@ -82,10 +86,12 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
   gpr_mu_unlock(&ps->mu);
 
   void* tag = reinterpret_cast<void*>(10);  // Some random number
-  GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
-  grpc_cq_end_op(
-      g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
-      static_cast<grpc_cq_completion*>(gpr_malloc(sizeof(grpc_cq_completion))));
+  for (int i = 0; i < g_completions_per_work; i++) {
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
   grpc_core::ExecCtx::Get()->Flush();
   gpr_mu_lock(&ps->mu);
   return absl::OkStatus();
@@ -158,14 +164,13 @@ static void teardown() {
 // by grpc, and its Finish call must take place before grpc_shutdown so that it
 // can use grpc_stats).
 //
-static void BM_Cq_Throughput(benchmark::State& state) {
+static void StartThread(benchmark::State& state) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  auto thd_idx = state.thread_index();
-
   gpr_mu_lock(&g_mu);
   g_threads_active++;
-  if (thd_idx == 0) {
+  if (state.thread_index() == 0) {
     setup();
+    g_completions_per_work = state.range(0);
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -174,14 +179,10 @@ static void BM_Cq_Throughput(benchmark::State& state) {
     }
   }
   gpr_mu_unlock(&g_mu);
+}
 
-  for (auto _ : state) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
-  }
-
-  state.SetItemsProcessed(state.iterations());
-
+static void FinishThread(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   gpr_mu_lock(&g_mu);
   g_threads_active--;
   if (g_threads_active == 0) {
@@ -193,13 +194,57 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
   gpr_mu_unlock(&g_mu);
 
-  if (thd_idx == 0) {
+  if (state.thread_index() == 0) {
     teardown();
     g_active = false;
   }
 }
 
-BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
+// state.range(0) is the number of completions queued per poll.
+static void BM_Cq_Throughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  StartThread(state);
+
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  FinishThread(state);
+}
+
+BENCHMARK(BM_Cq_Throughput)
+    ->Arg(1)
+    ->Arg(16)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+// state.range(0) is the number of completions queued per poll, and
+// state.range(1) the maximum number of events taken per call.
+static void BM_Cq_BatchThroughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  std::vector<grpc_event> events(state.range(1));
+  StartThread(state);
+
+  int64_t num_events = 0;
+  for (auto _ : state) {
+    size_t n = grpc_completion_queue_next_batch(g_cq, events.data(),
+                                                events.size(), deadline,
+                                                nullptr);
+    GPR_ASSERT(events[0].type == GRPC_OP_COMPLETE);
+    num_events += n;
+  }
+
+  state.SetItemsProcessed(num_events);
+  FinishThread(state);
+}
+
+BENCHMARK(BM_Cq_BatchThroughput)
+    ->Args({16, 8})
+    ->Args({16, 32})
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
 
 namespace {
 const grpc_event_engine_vtable g_none_vtable =
@@ -53,6 +53,14 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcess)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcessCHTTP2)->Arg(0);
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, SharedMemory)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, SharedMemory)
+    ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinSharedMemory)->Arg(0);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinSharedMemory)->Arg(0);
+#endif  // GRPC_HAVE_SHM_TRANSPORT
 
 }  // namespace testing
 }  // namespace grpc
@@ -18,13 +18,60 @@
 
 // Benchmark gRPC end2end in various configurations
 
+#include "src/core/lib/experiments/experiments.h"
 #include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_test_service.h"
 #include "test/cpp/microbenchmarks/fullstack_unary_ping_pong.h"
 #include "test/cpp/util/test_config.h"
 
 namespace grpc {
 namespace testing {
 
+//******************************************************************************
+// BENCHMARKING KERNELS
+//
+
+// Unary calls made concurrently by all benchmark threads over one channel, to
+// see how calls on a single transport scale with the number of threads.
+// Setup and teardown are done by thread 0 around the timed loop, which the
+// benchmark framework keeps the other threads out of.
+template <class Fixture>
+static void BM_UnaryPingPongSharedChannel(benchmark::State& state) {
+  static CallbackStreamingTestService* service;
+  static Fixture* fixture;
+  static EchoTestService::Stub* stub;
+  if (state.thread_index() == 0) {
+    service = new CallbackStreamingTestService();
+    fixture = new Fixture(service);
+    stub = EchoTestService::NewStub(fixture->channel()).release();
+  }
+  EchoRequest request;
+  EchoResponse response;
+  for (auto _ : state) {
+    ClientContext cli_ctx;
+    GPR_ASSERT(stub->Echo(&cli_ctx, request, &response).ok());
+  }
+  if (state.thread_index() == 0) {
+    delete stub;
+    delete fixture;
+    delete service;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+// The chaotic good transport only makes promise based calls.
+template <class Fixture, class ClientContextMutator, class ServerContextMutator>
+static void BM_UnaryPingPongPromiseBased(benchmark::State& state) {
+  if (!grpc_core::IsPromiseBasedClientCallEnabled() ||
+      !grpc_core::IsPromiseBasedServerCallEnabled()) {
+    state.SkipWithError("needs the promise based call experiments");
+    return;
+  }
+  BM_UnaryPingPong<Fixture, ClientContextMutator, ServerContextMutator>(state);
+}
+#endif  // GRPC_POSIX_SOCKET_TCP
+
 //******************************************************************************
 // CONFIGURATIONS
 //
@@ -48,10 +95,28 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, UDS, NoOpMutator, NoOpMutator)
     ->Args({0, 0});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinUDS, NoOpMutator, NoOpMutator)
     ->Args({0, 0});
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, SharedMemory, NoOpMutator, NoOpMutator)
+    ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinSharedMemory, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(SweepSizesArgs);
+#endif  // GRPC_HAVE_SHM_TRANSPORT
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
+#ifdef GRPC_POSIX_SOCKET_TCP
+BENCHMARK_TEMPLATE(BM_UnaryPingPongPromiseBased, ChaoticGood, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(SweepSizesArgs);
+#endif  // GRPC_POSIX_SOCKET_TCP
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinInProcess, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongSharedChannel, InProcess)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_UnaryPingPongSharedChannel, InProcessCHTTP2)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, SockPair, NoOpMutator, NoOpMutator)
     ->Args({0, 0});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinSockPair, NoOpMutator, NoOpMutator)
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string.h>
+
 #include <cstdint>
 #include <random>
 
@@ -26,7 +28,13 @@
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/huffman_geometries/index.h"
 
-std::vector<uint8_t> MakeInput(int min, int max) {
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& v) {
+  grpc_core::Slice s = grpc_core::Slice::FromCopiedBuffer(v);
+  grpc_core::Slice c(grpc_chttp2_huffman_compress(s.c_slice()));
+  return std::vector<uint8_t>(c.begin(), c.end());
+}
+
+std::vector<uint8_t> MakeUncompressedInput(int min, int max) {
   std::vector<uint8_t> v;
   std::uniform_int_distribution<> distribution(min, max);
   static std::mt19937 rd(0);
@@ -34,9 +42,11 @@ std::vector<uint8_t> MakeInput(int min, int max) {
   for (int i = 0; i < 1024 * 1024; i++) {
     v.push_back(distribution(rd));
   }
-  grpc_core::Slice s = grpc_core::Slice::FromCopiedBuffer(v);
-  grpc_core::Slice c(grpc_chttp2_huffman_compress(s.c_slice()));
-  return std::vector<uint8_t>(c.begin(), c.end());
+  return v;
+}
+
+std::vector<uint8_t> MakeInput(int min, int max) {
+  return Compress(MakeUncompressedInput(min, max));
 }
 
 std::vector<uint8_t> MakeBase64() {
@@ -46,6 +56,42 @@ std::vector<uint8_t> MakeBase64() {
   return std::vector<uint8_t>(s.begin(), s.end());
 }
 
+// Header values as they typically appear on the wire for gRPC traffic, with
+// a mix of paths, authorities, user agents, timeouts, trace context and
+// cookie style values.
+std::vector<uint8_t> MakeUncompressedHeaders() {
+  static const char* const kValues[] = {
+      "/grpc.testing.EchoTestService/Echo",
+      "/google.pubsub.v1.Publisher/Publish",
+      "/helloworld.Greeter/SayHello",
+      "foo.googleapis.com:443",
+      "localhost:50051",
+      "grpc-c++/1.59.0-dev grpc-c/35.0.0 (linux; chttp2)",
+      "grpc-java-netty/1.58.0",
+      "application/grpc",
+      "application/grpc+proto",
+      "trailers",
+      "identity,deflate,gzip",
+      "100m",
+      "29998u",
+      "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01",
+      "congo=t61rcWkgMzE,rojo=00f067aa0ba902b7",
+      "SID=31d4d96e407aad42; lang=en-US; Path=/; Domain=example.com",
+      "Mon, 21 Oct 2013 20:13:21 GMT",
+      "https://www.example.com/index.html?q=grpc&lang=en",
+      "Bearer ya29.a0AfH6SMBx-3kqLX9Vn0zqU4u7Wkq5YbN2Fz8oQp1sT6rJ",
+      "no-cache",
+  };
+  std::vector<uint8_t> v;
+  v.reserve(1024 * 1024 + 256);
+  while (v.size() < 1024 * 1024) {
+    for (const char* value : kValues) {
+      v.insert(v.end(), value, value + strlen(value));
+    }
+  }
+  return v;
+}
+
 const std::vector<uint8_t>& AllChars() {
   static const auto* const data = new std::vector<uint8_t>(MakeInput(0, 255));
   return *data;
@@ -62,6 +108,27 @@ const std::vector<uint8_t>& Base64Chars() {
   static const auto* const data = new std::vector<uint8_t>(MakeBase64());
   return *data;
 };
+const std::vector<uint8_t>& HeaderChars() {
+  static const auto* const data =
+      new std::vector<uint8_t>(Compress(MakeUncompressedHeaders()));
+  return *data;
+};
+
+const std::vector<uint8_t>& UncompressedAllChars() {
+  static const auto* const data =
+      new std::vector<uint8_t>(MakeUncompressedInput(0, 255));
+  return *data;
+};
+const std::vector<uint8_t>& UncompressedAsciiChars() {
+  static const auto* const data =
+      new std::vector<uint8_t>(MakeUncompressedInput(32, 126));
+  return *data;
+};
+const std::vector<uint8_t>& UncompressedHeaderChars() {
+  static const auto* const data =
+      new std::vector<uint8_t>(MakeUncompressedHeaders());
+  return *data;
+};
 
 using CharSet = const std::vector<uint8_t>& (*)();
 
@@ -75,6 +142,7 @@ static void BM_Decode(benchmark::State& state, CharSet chars_gen) {
     Decoder<decltype(add)>(add, chars.data(), chars.data() + chars.size())
         .Run();
   }
+  state.SetBytesProcessed(state.iterations() * chars.size());
 }
 
 #define DECL_BENCHMARK(cls, name)                     \
@@ -82,10 +150,35 @@ static void BM_Decode(benchmark::State& state, CharSet chars_gen) {
   BENCHMARK_CAPTURE(name, all_chars, AllChars);       \
   BENCHMARK_CAPTURE(name, base64_chars, Base64Chars); \
   BENCHMARK_CAPTURE(name, ascii_chars, AsciiChars);   \
-  BENCHMARK_CAPTURE(name, alpha_chars, AlphaChars)
+  BENCHMARK_CAPTURE(name, alpha_chars, AlphaChars);   \
+  BENCHMARK_CAPTURE(name, header_chars, HeaderChars)
 
 DECL_HUFFMAN_VARIANTS();
 
+static void BM_Encode(benchmark::State& state, CharSet chars_gen) {
+  const grpc_core::Slice input =
+      grpc_core::Slice::FromCopiedBuffer(chars_gen());
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_huffman_compress(input.c_slice()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK_CAPTURE(BM_Encode, all_chars, UncompressedAllChars);
+BENCHMARK_CAPTURE(BM_Encode, ascii_chars, UncompressedAsciiChars);
+BENCHMARK_CAPTURE(BM_Encode, header_chars, UncompressedHeaderChars);
+
+static void BM_Base64AndEncode(benchmark::State& state, CharSet chars_gen) {
+  const grpc_core::Slice input =
+      grpc_core::Slice::FromCopiedBuffer(chars_gen());
+  uint32_t wire_size;
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(
+        input.c_slice(), &wire_size));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK_CAPTURE(BM_Base64AndEncode, all_chars, UncompressedAllChars);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,130 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark parsing a large (1 MB) service config
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_reader.h"
+#include "src/core/lib/json/json_writer.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// A service config with one method config per method, as generated for
+// services with many methods.
+const std::string& LargeServiceConfig() {
+  static const std::string* config = [] {
+    std::string method_configs;
+    for (int i = 0; method_configs.size() < 1024 * 1024; i++) {
+      if (i > 0) method_configs += ",";
+      absl::StrAppend(
+          &method_configs, "{\"name\":[{\"service\":\"package.Service", i / 16,
+          "\",\"method\":\"Method", i % 16,
+          "\"}],\"timeout\":\"1.5s\",\"waitForReady\":true,"
+          "\"maxRequestMessageBytes\":1048576,\"retryPolicy\":{"
+          "\"maxAttempts\":3,\"initialBackoff\":\"0.1s\",\"maxBackoff\":\"1s\","
+          "\"backoffMultiplier\":2,\"retryableStatusCodes\":[\"UNAVAILABLE\","
+          "\"RESOURCE_EXHAUSTED\"]}}");
+    }
+    return new std::string(
+        absl::StrCat("{\"methodConfig\":[", method_configs, "]}"));
+  }();
+  return *config;
+}
+
+// Consumes a document without building anything.
+class NoopHandler : public grpc_core::JsonReaderHandler {
+ public:
+  void StartObject() override {}
+  void EndObject() override {}
+  void StartArray() override {}
+  void EndArray() override {}
+  bool Key(absl::string_view) override { return true; }
+  void String(absl::string_view) override {}
+  void Number(absl::string_view) override {}
+  void Bool(bool) override {}
+  void Null() override {}
+};
+
+}  // namespace
+
+static void BM_JsonParseToTree(benchmark::State& state) {
+  const std::string& config = LargeServiceConfig();
+  for (auto _ : state) {
+    auto json = grpc_core::JsonParse(config);
+    GPR_ASSERT(json.ok());
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonParseToTree);
+
+static void BM_JsonParseWithHandler(benchmark::State& state) {
+  const std::string& config = LargeServiceConfig();
+  for (auto _ : state) {
+    NoopHandler handler;
+    GPR_ASSERT(grpc_core::JsonParse(config, &handler).ok());
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonParseWithHandler);
+
+static void BM_JsonDump(benchmark::State& state) {
+  const grpc_core::Json json = *grpc_core::JsonParse(LargeServiceConfig());
+  size_t size = 0;
+  for (auto _ : state) {
+    size = grpc_core::JsonDump(json).size();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_JsonDump);
+
+// Parse and load into the service config parsers' structs.
+static void BM_ServiceConfigCreate(benchmark::State& state) {
+  const std::string& config = LargeServiceConfig();
+  for (auto _ : state) {
+    auto service_config =
+        grpc_core::ServiceConfigImpl::Create(grpc_core::ChannelArgs(), config);
+    GPR_ASSERT(service_config.ok());
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_ServiceConfigCreate);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
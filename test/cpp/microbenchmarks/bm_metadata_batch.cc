@@ -0,0 +1,112 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark lookups of metadata that is not known to core (custom headers)
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+std::vector<std::string> MakeKeys(int n) {
+  std::vector<std::string> keys;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(absl::StrCat("x-custom-header-", i));
+  }
+  return keys;
+}
+
+void FillBatch(const std::vector<std::string>& keys,
+               grpc_metadata_batch* batch) {
+  for (const auto& key : keys) {
+    batch->Append(key, grpc_core::Slice::FromCopiedString("value"),
+                  [](absl::string_view, const grpc_core::Slice&) {});
+  }
+}
+
+}  // namespace
+
+static void BM_UnknownMetadata_LookupPresent(benchmark::State& state) {
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(4096, &memory_allocator);
+  const auto keys = MakeKeys(state.range(0));
+  grpc_metadata_batch batch(arena.get());
+  FillBatch(keys, &batch);
+  std::string backing;
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        batch.GetStringValue(keys[i++ % keys.size()], &backing));
+  }
+}
+BENCHMARK(BM_UnknownMetadata_LookupPresent)->Arg(5)->Arg(20)->Arg(80);
+
+static void BM_UnknownMetadata_LookupAbsent(benchmark::State& state) {
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(4096, &memory_allocator);
+  grpc_metadata_batch batch(arena.get());
+  FillBatch(MakeKeys(state.range(0)), &batch);
+  std::string backing;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        batch.GetStringValue("x-not-a-custom-header", &backing));
+  }
+}
+BENCHMARK(BM_UnknownMetadata_LookupAbsent)->Arg(5)->Arg(20)->Arg(80);
+
+static void BM_UnknownMetadata_Fill(benchmark::State& state) {
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  const auto keys = MakeKeys(state.range(0));
+  for (auto _ : state) {
+    auto arena = grpc_core::MakeScopedArena(4096, &memory_allocator);
+    grpc_metadata_batch batch(arena.get());
+    FillBatch(keys, &batch);
+  }
+}
+BENCHMARK(BM_UnknownMetadata_Fill)->Arg(5)->Arg(20)->Arg(80);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
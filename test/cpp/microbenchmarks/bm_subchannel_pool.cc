@@ -0,0 +1,152 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark the global subchannel pool under many channels resolving the
+// same large endpoint list at once.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int kEndpoints = 5000;
+
+// Subchannels are never asked to connect here.
+class NoOpConnector : public SubchannelConnector {
+ public:
+  void Connect(const Args& /*args*/, Result* /*result*/,
+               grpc_closure* /*notify*/) override {}
+  void Shutdown(grpc_error_handle /*error*/) override {}
+};
+
+std::vector<grpc_resolved_address> MakeEndpoints() {
+  std::vector<grpc_resolved_address> endpoints;
+  endpoints.reserve(kEndpoints);
+  for (int i = 0; i < kEndpoints; ++i) {
+    auto address = StringToSockaddr(
+        absl::StrFormat("10.%d.%d.%d:443", i >> 16, (i >> 8) & 0xff, i & 0xff));
+    GPR_ASSERT(address.ok());
+    endpoints.push_back(*address);
+  }
+  return endpoints;
+}
+
+ChannelArgs SubchannelArgs() {
+  return CoreConfiguration::Get()
+      .channel_args_preconditioning()
+      .PreconditionChannelArgs(nullptr)
+      .SetObject(GlobalSubchannelPool::instance());
+}
+
+// Each thread plays a channel receiving a resolver result: it gets a
+// subchannel for every endpoint in the list, creating and registering those
+// the pool does not have yet, and then drops them all.
+void ResolveEndpoints(const std::vector<grpc_resolved_address>& endpoints,
+                      const ChannelArgs& args) {
+  ExecCtx exec_ctx;
+  std::vector<RefCountedPtr<Subchannel>> subchannels;
+  subchannels.reserve(endpoints.size());
+  for (const grpc_resolved_address& address : endpoints) {
+    subchannels.push_back(
+        Subchannel::Create(MakeOrphanable<NoOpConnector>(), address, args));
+  }
+}
+
+// Another channel already holds every endpoint, so each lookup finds a
+// registered subchannel.
+void BM_ResolveRegisteredEndpoints(benchmark::State& state) {
+  static std::vector<grpc_resolved_address>* endpoints;
+  static std::vector<RefCountedPtr<Subchannel>>* resident;
+  static ChannelArgs* args;
+  if (state.thread_index() == 0) {
+    endpoints = new std::vector<grpc_resolved_address>(MakeEndpoints());
+    args = new ChannelArgs(SubchannelArgs());
+    ExecCtx exec_ctx;
+    resident = new std::vector<RefCountedPtr<Subchannel>>();
+    for (const grpc_resolved_address& address : *endpoints) {
+      resident->push_back(
+          Subchannel::Create(MakeOrphanable<NoOpConnector>(), address, *args));
+    }
+  }
+  for (auto _ : state) {
+    ResolveEndpoints(*endpoints, *args);
+  }
+  state.SetItemsProcessed(state.iterations() * kEndpoints);
+  if (state.thread_index() == 0) {
+    {
+      ExecCtx exec_ctx;
+      delete resident;
+    }
+    delete args;
+    delete endpoints;
+  }
+}
+BENCHMARK(BM_ResolveRegisteredEndpoints)->ThreadRange(1, 32)->UseRealTime();
+
+// No other channel holds the endpoints, so subchannels are registered and
+// unregistered as the channels' results come and go.
+void BM_ResolveUnheldEndpoints(benchmark::State& state) {
+  static std::vector<grpc_resolved_address>* endpoints;
+  static ChannelArgs* args;
+  if (state.thread_index() == 0) {
+    endpoints = new std::vector<grpc_resolved_address>(MakeEndpoints());
+    args = new ChannelArgs(SubchannelArgs());
+  }
+  for (auto _ : state) {
+    ResolveEndpoints(*endpoints, *args);
+  }
+  state.SetItemsProcessed(state.iterations() * kEndpoints);
+  if (state.thread_index() == 0) {
+    delete args;
+    delete endpoints;
+  }
+}
+BENCHMARK(BM_ResolveUnheldEndpoints)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
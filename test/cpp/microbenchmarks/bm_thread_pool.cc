@@ -24,7 +24,9 @@
 #include <grpcpp/impl/grpc_library.h>
 
 #include "src/core/lib/event_engine/common_closures.h"
+#include "src/core/lib/event_engine/thread_pool/original_thread_pool.h"
 #include "src/core/lib/event_engine/thread_pool/thread_pool.h"
+#include "src/core/lib/event_engine/thread_pool/work_stealing_thread_pool.h"
 #include "src/core/lib/gprpp/notification.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
@@ -34,7 +36,9 @@ namespace {
 
 using ::grpc_event_engine::experimental::AnyInvocableClosure;
 using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::OriginalThreadPool;
 using ::grpc_event_engine::experimental::ThreadPool;
+using ::grpc_event_engine::experimental::WorkStealingThreadPool;
 
 struct FanoutParameters {
   int depth;
@@ -178,6 +182,39 @@ void BM_ThreadPool_Lambda_FanOut(benchmark::State& state) {
 }
 BENCHMARK(BM_ThreadPool_Lambda_FanOut)->Apply(FanoutTestArguments);
 
+// Compares thread pool implementations across pool sizes. Callbacks that fan
+// out are scheduled from pool threads, which exercises the thread-local queues
+// of the WorkStealingThreadPool.
+template <typename ThreadPoolImpl>
+void BM_ThreadPoolImpl_Lambda_FanOut(benchmark::State& state) {
+  FanoutParameters params;
+  params.depth = 2;
+  params.fanout = 70;
+  params.limit = 1 + params.fanout + params.fanout * params.fanout;
+  std::shared_ptr<ThreadPool> pool =
+      std::make_shared<ThreadPoolImpl>(state.range(0));
+  for (auto _ : state) {
+    std::atomic_int count{0};
+    grpc_core::Notification signal;
+    FanOutCallback(pool, params, signal, count, /*processing_layer=*/0);
+    do {
+      signal.WaitForNotification();
+    } while (count.load() != params.limit);
+  }
+  state.SetItemsProcessed(params.limit * state.iterations());
+  pool->Quiesce();
+}
+BENCHMARK_TEMPLATE(BM_ThreadPoolImpl_Lambda_FanOut, OriginalThreadPool)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+BENCHMARK_TEMPLATE(BM_ThreadPoolImpl_Lambda_FanOut, WorkStealingThreadPool)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+
 void ClosureFanOutCallback(EventEngine::Closure* child_closure,
                            std::shared_ptr<ThreadPool> pool,
                            grpc_core::Notification** signal_holder,
@@ -28,23 +28,34 @@
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 
+#include "src/core/ext/transport/chaotic_good/chaotic_good.h"
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/event_engine/channel_args_endpoint_config.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/promise_endpoint.h"
 #include "src/cpp/client/create_channel_internal.h"
 #include "test/core/util/passthru_endpoint.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 
+#ifdef GRPC_POSIX_SOCKET_TCP
+#include <fcntl.h>
+#include <sys/socket.h>
+#endif  // GRPC_POSIX_SOCKET_TCP
+
 namespace grpc {
 namespace testing {
 
@@ -149,6 +160,31 @@ class UDS : public FullstackFixture {
   }
 };
 
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+// Like UDS, but with the connection moved onto shared memory once
+// established.
+class SharedMemory : public FullstackFixture {
+ public:
+  explicit SharedMemory(Service* service,
+                        const FixtureConfiguration& fixture_configuration =
+                            FixtureConfiguration())
+      : FullstackFixture(service, fixture_configuration, MakeAddress(&port_)) {}
+
+  ~SharedMemory() override { grpc_recycle_unused_port(port_); }
+
+ private:
+  int port_;
+
+  static std::string MakeAddress(int* port) {
+    *port = grpc_pick_unused_port_or_die();  // just for a unique id - not a
+                                             // real port
+    std::stringstream addr;
+    addr << "shm:/tmp/bm_fullstack_shm." << *port;
+    return addr.str();
+  }
+};
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
 class InProcess : public FullstackFixture {
  public:
   explicit InProcess(Service* service,
@@ -293,6 +329,122 @@ class InProcessCHTTP2 : public InProcessCHTTP2WithExplicitStats {
                                          fixture_configuration) {}
 };
 
+#ifdef GRPC_POSIX_SOCKET_TCP
+// A chaotic good connection over socketpairs: one control connection and
+// kDataEndpoints data connections.  Its calls are promise based, so the
+// promise based call experiments must be enabled.
+class ChaoticGood : public BaseFixture {
+ public:
+  static constexpr int kDataEndpoints = 1;
+
+  explicit ChaoticGood(Service* service,
+                       const FixtureConfiguration& fixture_configuration =
+                           FixtureConfiguration())
+      : event_engine_(std::make_shared<
+                      grpc_event_engine::experimental::PosixEventEngine>()) {
+    ServerBuilder b;
+    cq_ = b.AddCompletionQueue(true);
+    b.RegisterService(service);
+    fixture_configuration.ApplyCommonServerBuilderConfig(&b);
+    server_ = b.BuildAndStart();
+    grpc_core::ExecCtx exec_ctx;
+    EndpointPair control = MakeEndpointPair();
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> client_data;
+    std::vector<std::unique_ptr<grpc_core::PromiseEndpoint>> server_data;
+    for (int i = 0; i < kDataEndpoints; ++i) {
+      EndpointPair data = MakeEndpointPair();
+      client_data.push_back(std::move(data.client));
+      server_data.push_back(std::move(data.server));
+    }
+    // add server transport to server_
+    {
+      grpc_core::Server* core_server =
+          grpc_core::Server::FromC(server_->c_server());
+      grpc_transport* server_transport =
+          grpc_create_chaotic_good_server_transport(
+              std::move(control.server), std::move(server_data),
+              event_engine_);
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "SetupTransport",
+          core_server->SetupTransport(server_transport, nullptr,
+                                      core_server->channel_args(), nullptr)));
+    }
+    // create channel
+    {
+      grpc_core::ChannelArgs c_args;
+      {
+        ChannelArguments args;
+        args.SetString(GRPC_ARG_DEFAULT_AUTHORITY, "test.authority");
+        fixture_configuration.ApplyCommonChannelArguments(&args);
+        // precondition
+        grpc_channel_args tmp_args;
+        args.SetChannelArgs(&tmp_args);
+        c_args = grpc_core::CoreConfiguration::Get()
+                     .channel_args_preconditioning()
+                     .PreconditionChannelArgs(&tmp_args);
+      }
+      grpc_transport* client_transport =
+          grpc_create_chaotic_good_client_transport(std::move(control.client),
+                                                    std::move(client_data),
+                                                    event_engine_);
+      grpc_channel* channel =
+          grpc_core::Channel::Create(
+              "target", c_args, GRPC_CLIENT_DIRECT_CHANNEL, client_transport)
+              ->release()
+              ->c_ptr();
+      channel_ = grpc::CreateChannelInternal(
+          "", channel,
+          std::vector<std::unique_ptr<
+              experimental::ClientInterceptorFactoryInterface>>());
+    }
+  }
+
+  ~ChaoticGood() override {
+    server_->Shutdown(grpc_timeout_milliseconds_to_deadline(0));
+    cq_->Shutdown();
+    void* tag;
+    bool ok;
+    while (cq_->Next(&tag, &ok)) {
+    }
+  }
+
+  ServerCompletionQueue* cq() { return cq_.get(); }
+  std::shared_ptr<Channel> channel() { return channel_; }
+
+ private:
+  struct EndpointPair {
+    std::unique_ptr<grpc_core::PromiseEndpoint> client;
+    std::unique_ptr<grpc_core::PromiseEndpoint> server;
+  };
+
+  EndpointPair MakeEndpointPair() {
+    int fds[2];
+    GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    return {MakeEndpoint(fds[0]), MakeEndpoint(fds[1])};
+  }
+
+  std::unique_ptr<grpc_core::PromiseEndpoint> MakeEndpoint(int fd) {
+    GPR_ASSERT(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+    auto args = grpc_core::ChannelArgs().Set(
+        GRPC_ARG_RESOURCE_QUOTA, grpc_core::ResourceQuota::Default());
+    return std::make_unique<grpc_core::PromiseEndpoint>(
+        event_engine_->CreatePosixEndpointFromFd(
+            fd,
+            grpc_event_engine::experimental::ChannelArgsEndpointConfig(args),
+            grpc_core::ResourceQuota::Default()
+                ->memory_quota()
+                ->CreateMemoryAllocator("chaotic_good_fixture")),
+        grpc_core::SliceBuffer());
+  }
+
+  const std::shared_ptr<grpc_event_engine::experimental::PosixEventEngine>
+      event_engine_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::shared_ptr<Channel> channel_;
+};
+#endif  // GRPC_POSIX_SOCKET_TCP
+
 ////////////////////////////////////////////////////////////////////////////////
 // Minimal stack fixtures
 
@@ -317,6 +469,9 @@ class MinStackize : public Base {
 
 typedef MinStackize<TCP> MinTCP;
 typedef MinStackize<UDS> MinUDS;
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+typedef MinStackize<SharedMemory> MinSharedMemory;
+#endif  // GRPC_HAVE_SHM_TRANSPORT
 typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;